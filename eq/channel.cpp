@@ -30,6 +30,8 @@
 #include "compositor.h"
 #include "config.h"
 #include "detail/fileFrameWriter.h"
+#include "detail/preCompositor.h"
+#include "detail/sharedImageRing.h"
 #include "error.h"
 #include "frame.h"
 #include "frameData.h"
@@ -40,6 +42,7 @@
 #include "log.h"
 #include "node.h"
 #include "nodeFactory.h"
+#include "observer.h"
 #include "pipe.h"
 #include "pixelData.h"
 #include "server.h"
@@ -71,6 +74,7 @@
 #include <GLStats/GLStats.h>
 #endif
 
+#include <algorithm>
 #include <bitset>
 #include <set>
 
@@ -501,6 +505,11 @@ const View* Channel::getNativeView() const
 
 void Channel::changeLatency(const uint32_t latency)
 {
+    _impl->latency = latency;
+    for (const detail::Channel::FrameStatistics& stats : *_impl->statistics)
+        if (stats.gpuTimings > 0) // resized by pipe thread after collection
+            return;
+
 #ifndef NDEBUG
     for (detail::Channel::StatisticsRBCIter i = _impl->statistics->begin();
          i != _impl->statistics->end(); ++i)
@@ -1118,6 +1127,18 @@ void Channel::_frameTiles(RenderContext& context, const bool isLocal,
         }
     }
 
+    {
+        // queue pop, context setup and readback setup cost of all tiles
+        const int64_t endTime = getConfig()->getTime();
+        const int64_t time = LB_MAX(endTime - startTime, 1);
+        const int64_t work = clearTime + drawTime + readbackTime;
+        ChannelStatistics event(Statistic::CHANNEL_FRAME_TILES, this);
+        event.statistic.startTime = startTime;
+        event.statistic.endTime = endTime;
+        event.statistic.idleTime = LB_MAX(time - work, 0);
+        event.statistic.ratio = float(event.statistic.idleTime) / float(time);
+    }
+
     if (tasks & fabric::TASK_CLEAR)
     {
         ChannelStatistics event(Statistic::CHANNEL_CLEAR, this);
@@ -1159,15 +1180,70 @@ void Channel::_unrefFrame(const uint32_t frameNumber)
 {
     const size_t index = frameNumber % _impl->statistics->size();
     detail::Channel::FrameStatistics& stats = _impl->statistics.data[index];
-    if (--stats.used != 0) // Frame still in use
+    const int32_t used = --stats.used;
+    if (used != 0) // Frame still in use
+    {
+        // Only GPU timings are pending, which only delay the statistics
+        if (used == stats.gpuTimings && _impl->finishedFrame < frameNumber)
+            _impl->finishedFrame = frameNumber;
         return;
+    }
 
     send(getServer(), fabric::CMD_CHANNEL_FRAME_FINISH_REPLY)
         << stats.region << frameNumber << stats.data;
 
     stats.data.clear();
     stats.region = Viewport::FULL;
-    _impl->finishedFrame = frameNumber;
+    if (_impl->finishedFrame < frameNumber)
+        _impl->finishedFrame = frameNumber;
+}
+
+uint32_t Channel::_startGPUTiming(const Statistic& statistic)
+{
+    LB_TS_THREAD(_pipeThread);
+    const GLEWContext* glewContext = glewGetContext();
+    if (!detail::GPUTimer::isSupported(glewContext))
+        return detail::GPUTimer::NONE;
+
+    return _impl->gpuTimer.start(glewContext, statistic.frameNumber,
+                                 getConfig()->getTime());
+}
+
+void Channel::_stopGPUTiming(const uint32_t slot, const Statistic& statistic)
+{
+    LB_TS_THREAD(_pipeThread);
+    const uint32_t frameNumber = statistic.frameNumber;
+    const size_t index = frameNumber % _impl->statistics->size();
+
+    _refFrame(frameNumber);
+    ++_impl->statistics.data[index].gpuTimings;
+    _impl->gpuTimer.stop(glewGetContext(), slot, statistic);
+}
+
+void Channel::_cancelGPUTiming(const uint32_t slot)
+{
+    LB_TS_THREAD(_pipeThread);
+    _impl->gpuTimer.cancel(slot);
+}
+
+void Channel::_collectGPUTimings(const uint32_t waitFrame)
+{
+    LB_TS_THREAD(_pipeThread);
+    if (!_impl->gpuTimer.hasPending())
+        return;
+
+    getWindow()->makeCurrent();
+    Statistics statistics =
+        _impl->gpuTimer.collect(glewGetContext(), waitFrame);
+    for (Statistic& statistic : statistics)
+    {
+        const uint32_t frameNumber = statistic.frameNumber;
+        const size_t index = frameNumber % _impl->statistics->size();
+
+        --_impl->statistics.data[index].gpuTimings;
+        addStatistic(statistic);
+        _unrefFrame(frameNumber);
+    }
 }
 
 Frames Channel::_getFrames(const co::ObjectVersions& frameIDs,
@@ -1208,6 +1284,15 @@ void Channel::_frameReadback(const uint128_t& frameID,
     LBASSERT(stat->event.statistic.frameNumber > 0);
     const bool async = _asyncFinishReadback(nImages, frames);
     _setReady(async, stat.get(), frames);
+
+    for (const Frame* frame : frames)
+    {
+        if (!frame->getInputNodes(getEye()).empty())
+        {
+            getPipe()->markRemoteReadback();
+            break;
+        }
+    }
 }
 
 bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
@@ -1230,8 +1315,15 @@ bool Channel::_asyncFinishReadback(const std::vector<size_t>& imagePos,
         const Images& images = frameData->getImages();
         const size_t nImages = images.size();
         const Eye eye = getEye();
-        const std::vector<uint128_t>& nodes = frame->getInputNodes(eye);
-        const co::NodeIDs& netNodes = frame->getInputNetNodes(eye);
+
+        // outputs of a pre-composition group are sent in _cmdFrameSetReadyNode
+        static const std::vector<uint128_t> noNodes;
+        static const co::NodeIDs noNetNodes;
+        const bool preComposite = frameData->getPreCompositeSize() > 1;
+        const std::vector<uint128_t>& nodes =
+            preComposite ? noNodes : frame->getInputNodes(eye);
+        const co::NodeIDs& netNodes =
+            preComposite ? noNetNodes : frame->getInputNetNodes(eye);
 
         for (uint64_t j = imagePos[i]; j < nImages; ++j)
         {
@@ -1290,24 +1382,103 @@ void Channel::_asyncTransmit(FrameDataPtr frame, const uint32_t frameNumber,
                              const co::NodeIDs& netNodes, const uint32_t taskID)
 {
     LBASSERT(nodes.size() == netNodes.size());
-    co::NodeIDs::const_iterator j = netNodes.begin();
-    for (std::vector<uint128_t>::const_iterator i = nodes.begin();
-         i != nodes.end(); ++i, ++j)
+    if (nodes.empty())
+        return;
+
+    // one command for all receivers, so that receivers sharing a multicast
+    // group get the image in one transmission
+    _refFrame(frameNumber);
+
+    LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Start transmit frame data " << frame
+                                    << " to " << nodes.size() << " receivers"
+                                    << std::endl;
+    send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_TRANSMIT_IMAGE)
+        << co::ObjectVersion(frame) << nodes << netNodes << image << frameNumber
+        << taskID;
+}
+
+namespace detail
+{
+/** A set of receivers of an output frame sharing one connection. */
+struct Transmission
+{
+    co::NodePtr node;              //!< the receiver node for unicast
+    co::ConnectionPtr connection;  //!< unicast or multicast connection
+    std::vector<uint128_t> nodes;  //!< the receiving eq::Node identifiers
+
+    bool isMulticast() const { return nodes.size() > 1; }
+};
+typedef std::vector<Transmission> Transmissions;
+
+/**
+ * Group the receivers of an output frame by connection.
+ *
+ * Receivers on the same host use the shared image ring over their unicast
+ * connection. Remote receivers reachable through the same multicast group are
+ * served by one multicast transmission.
+ */
+static Transmissions _getTransmissions(co::LocalNodePtr localNode,
+                                       eq::Node* node,
+                                       const std::vector<uint128_t>& nodes,
+                                       const co::NodeIDs& netNodes)
+{
+    LBASSERT(nodes.size() == netNodes.size());
+    Transmissions transmissions;
+    Transmissions unicasts;
+
+    for (size_t i = 0; i < nodes.size(); ++i)
     {
-        _refFrame(frameNumber);
+        co::NodePtr toNode = localNode->connect(netNodes[i]);
+        if (!toNode || !toNode->isReachable())
+        {
+            LBWARN << "Can't connect node " << netNodes[i]
+                   << " to send output frame" << std::endl;
+            continue;
+        }
 
-        LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Start transmit frame data " << frame
-                                        << " receiver " << *i << " on " << *j
-                                        << std::endl;
-        send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_TRANSMIT_IMAGE)
-            << co::ObjectVersion(frame) << *i << *j << image << frameNumber
-            << taskID;
+        co::ConnectionPtr multicast;
+        if (!node->getSharedImageRing(netNodes[i]))
+            multicast = toNode->useMulticast();
+
+        Transmission unicast;
+        unicast.node = toNode;
+        unicast.connection = toNode->getConnection();
+        unicast.nodes.push_back(nodes[i]);
+
+        if (!multicast)
+        {
+            unicasts.push_back(unicast);
+            continue;
+        }
+
+        Transmissions::iterator j = transmissions.begin();
+        for (; j != transmissions.end(); ++j)
+            if (j->connection == multicast)
+                break;
+
+        if (j == transmissions.end())
+        {
+            // remember the unicast node in case nobody else joins the group
+            transmissions.push_back(unicast);
+            transmissions.back().connection = multicast;
+        }
+        else
+            j->nodes.push_back(nodes[i]);
     }
+
+    // a multicast group with only one receiver is served by unicast
+    for (Transmission& transmission : transmissions)
+        if (!transmission.isMulticast())
+            transmission.connection = transmission.node->getConnection();
+
+    transmissions.insert(transmissions.end(), unicasts.begin(), unicasts.end());
+    return transmissions;
+}
 }
 
 void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
-                             const uint128_t& nodeID,
-                             const co::NodeID& netNodeID,
+                             const std::vector<uint128_t>& nodes,
+                             const co::NodeIDs& netNodes,
                              const uint64_t imageIndex,
                              const uint32_t frameNumber, const uint32_t taskID)
 {
@@ -1324,6 +1495,7 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
     ChannelStatistics transmitEvent(Statistic::CHANNEL_FRAME_TRANSMIT, this,
                                     frameNumber);
     transmitEvent.statistic.task = taskID;
+    transmitEvent.statistic.ratio = 1.0f;
 
     const Images& images = frameData->getImages();
     Image* image = images[imageIndex];
@@ -1336,16 +1508,44 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
         return;
     }
 
-    co::LocalNodePtr localNode = getLocalNode();
-    co::NodePtr toNode = localNode->connect(netNodeID);
-    if (!toNode || !toNode->isReachable())
+    const detail::Transmissions& transmissions =
+        detail::_getTransmissions(getLocalNode(), getNode(), nodes, netNodes);
+
+    // bytes put on the wire vs. bytes needed when sending to each receiver
+    uint64_t sentBytes = 0;
+    uint64_t unicastBytes = 0;
+    for (const detail::Transmission& transmission : transmissions)
     {
-        LBWARN << "Can't connect node " << netNodeID << " to send output frame"
-               << std::endl;
-        return;
+        const uint64_t size = _transmitImage(transmission, frameDataVersion,
+                                             image, frameNumber, taskID);
+        sentBytes += size;
+        unicastBytes += size * transmission.nodes.size();
+    }
+
+    if (unicastBytes > 0)
+        transmitEvent.statistic.ratio = float(sentBytes) / float(unicastBytes);
+}
+
+uint64_t Channel::_transmitImage(const detail::Transmission& transmission,
+                                 const co::ObjectVersion& frameDataVersion,
+                                 Image* image, const uint32_t frameNumber,
+                                 const uint32_t taskID)
+{
+    co::ConnectionPtr connection = transmission.connection;
+    const uint128_t& nodeID = transmission.nodes.front();
+
+    // bypass serialization and compression for receivers on the same host
+    if (!transmission.isMulticast())
+    {
+        detail::SharedImageRing* ring =
+            getNode()->getSharedImageRing(transmission.node->getNodeID());
+        if (ring && _transmitSharedImage(*ring, connection, frameDataVersion,
+                                         nodeID, image, frameNumber))
+        {
+            return 0;
+        }
     }
 
-    co::ConnectionPtr connection = toNode->getConnection();
     co::ConstConnectionDescriptionPtr description =
         connection->getDescription();
 
@@ -1408,22 +1608,31 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
     }
 
     if (pixelDatas.empty())
-        return;
+        return 0;
 
     // send image pixel data command
     co::LocalNode::SendToken token;
-    if (getIAttribute(IATTR_HINT_SENDTOKEN) == ON)
+    if (!transmission.isMulticast() &&
+        getIAttribute(IATTR_HINT_SENDTOKEN) == ON)
     {
         ChannelStatistics waitEvent(Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN,
                                     this, frameNumber);
         waitEvent.statistic.task = taskID;
-        token = getLocalNode()->acquireSendToken(toNode);
+        token = getLocalNode()->acquireSendToken(transmission.node);
     }
     LBASSERT(image->getPixelViewport().isValid());
 
-    co::ObjectOCommand command(co::Connections(1, connection),
-                               fabric::CMD_NODE_FRAMEDATA_TRANSMIT,
-                               co::COMMANDTYPE_OBJECT, nodeID, CO_INSTANCE_ALL);
+    // multicast commands are dispatched by the config of each group member
+    const bool multicast = transmission.isMulticast();
+    const uint32_t cmd =
+        multicast ? uint32_t(fabric::CMD_CONFIG_FRAMEDATA_TRANSMIT)
+                  : uint32_t(fabric::CMD_NODE_FRAMEDATA_TRANSMIT);
+    co::ObjectOCommand command(co::Connections(1, connection), cmd,
+                               co::COMMANDTYPE_OBJECT,
+                               multicast ? getConfig()->getID() : nodeID,
+                               CO_INSTANCE_ALL);
+    if (transmission.isMulticast())
+        command << transmission.nodes;
     command << frameDataVersion << image->getPixelViewport() << image->getZoom()
             << image->getContext() << commandBuffers << frameNumber
             << image->getAlphaUsage();
@@ -1483,6 +1692,71 @@ void Channel::_transmitImage(const co::ObjectVersion& frameDataVersion,
     LBASSERTINFO(sentBytes == imageDataSize, sentBytes << " != "
                                                        << imageDataSize);
 #endif
+    return imageDataSize;
+}
+
+bool Channel::_transmitSharedImage(detail::SharedImageRing& ring,
+                                   co::ConnectionPtr connection,
+                                   const co::ObjectVersion& frameDataVersion,
+                                   const uint128_t& nodeID, const Image* image,
+                                   const uint32_t frameNumber)
+{
+    const Frame::Buffer buffers[] = {Frame::Buffer::color,
+                                     Frame::Buffer::depth};
+    Frame::Buffer commandBuffers = Frame::Buffer::none;
+    uint64_t imageDataSize = 0;
+    for (const Frame::Buffer buffer : buffers)
+    {
+        if (!image->hasPixelData(buffer))
+            continue;
+
+        const PixelData& data = image->getPixelData(buffer);
+        imageDataSize += sizeof(FrameData::ImageHeader) + sizeof(uint64_t) +
+                         data.pvp.getArea() * data.pixelSize;
+        commandBuffers |= buffer;
+    }
+
+    if (commandBuffers == Frame::Buffer::none)
+        return true;
+
+    uint64_t offset = 0;
+    uint8_t* ptr = ring.alloc(imageDataSize, offset);
+    if (!ptr) // ring full, receivers are lagging behind
+        return false;
+
+    // same layout as the network data, see FrameData::addImage()
+    for (const Frame::Buffer buffer : buffers)
+    {
+        if (!image->hasPixelData(buffer))
+            continue;
+
+        const PixelData& data = image->getPixelData(buffer);
+        const uint64_t dataSize = data.pvp.getArea() * data.pixelSize;
+        const FrameData::ImageHeader header = {data.internalFormat,
+                                               data.externalFormat,
+                                               data.pixelSize,
+                                               data.pvp,
+                                               EQ_COMPRESSOR_NONE,
+                                               data.compressorFlags,
+                                               1,
+                                               image->getQuality(buffer)};
+
+        memcpy(ptr, &header, sizeof(header));
+        ptr += sizeof(header);
+        memcpy(ptr, &dataSize, sizeof(dataSize));
+        ptr += sizeof(dataSize);
+        memcpy(ptr, data.pixels, dataSize);
+        ptr += dataSize;
+    }
+
+    LBASSERT(image->getPixelViewport().isValid());
+    co::ObjectOCommand(co::Connections(1, connection),
+                       fabric::CMD_NODE_FRAMEDATA_TRANSMIT_SHARED,
+                       co::COMMANDTYPE_OBJECT, nodeID, CO_INSTANCE_ALL)
+        << frameDataVersion << image->getPixelViewport() << image->getZoom()
+        << image->getContext() << commandBuffers << frameNumber
+        << image->getAlphaUsage() << offset;
+    return true;
 }
 
 void Channel::_setReady(const bool async, detail::RBStat* stat,
@@ -1529,7 +1803,8 @@ void Channel::_setReady(FrameDataPtr frame, detail::RBStat* stat,
     _refFrame(frameNumber);
 
     send(getLocalNode(), fabric::CMD_CHANNEL_FRAME_SET_READY_NODE)
-        << co::ObjectVersion(frame) << nodes << netNodes << frameNumber;
+        << co::ObjectVersion(frame) << nodes << netNodes << frameNumber
+        << stat->event.statistic.task;
 
     const DrawableConfig& dc = getDrawableConfig();
     const size_t colorBytes = (3 * dc.colorBits + dc.alphaBits) / 8;
@@ -1639,6 +1914,14 @@ bool Channel::_cmdConfigExit(co::ICommand& cmd)
 {
     LBLOG(LOG_INIT) << "Exit channel " << co::ObjectICommand(cmd) << std::endl;
 
+    const GLEWContext* glewContext = glewGetContext();
+    if (glewContext)
+    {
+        _collectGPUTimings(LB_UNDEFINED_UINT32);
+        getWindow()->makeCurrent();
+        _impl->gpuTimer.exit(glewContext);
+    }
+
     if (_impl->state != STATE_STOPPED)
         _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
 
@@ -1666,6 +1949,15 @@ bool Channel::_cmdFrameStart(co::ICommand& cmd)
     bindFrameBuffer();
     frameStart(context.frameID, frameNumber);
 
+    // Collect the GPU timings of the frame previously using this ring slot
+    if (_impl->statistics->size() != _impl->latency + 1)
+    {
+        _collectGPUTimings(LB_UNDEFINED_UINT32);
+        changeLatency(_impl->latency);
+    }
+    else if (frameNumber > _impl->statistics->size())
+        _collectGPUTimings(frameNumber - uint32_t(_impl->statistics->size()));
+
     const size_t index = frameNumber % _impl->statistics->size();
     detail::Channel::FrameStatistics& statistic = _impl->statistics.data[index];
     LBASSERTINFO(statistic.used == 0, "Frame " << frameNumber << " used "
@@ -1691,6 +1983,7 @@ bool Channel::_cmdFrameFinish(co::ICommand& cmd)
     frameFinish(context.frameID, frameNumber);
     resetContext();
 
+    _collectGPUTimings(0);
     _unrefFrame(frameNumber);
     return true;
 }
@@ -1841,17 +2134,18 @@ bool Channel::_cmdFrameTransmitImage(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
     const co::ObjectVersion& frameData = command.read<co::ObjectVersion>();
-    const uint128_t& nodeID = command.read<uint128_t>();
-    const co::NodeID& netNodeID = command.read<co::NodeID>();
+    const std::vector<uint128_t>& nodes =
+        command.read<std::vector<uint128_t>>();
+    const co::NodeIDs& netNodes = command.read<co::NodeIDs>();
     const uint64_t imageIndex = command.read<uint64_t>();
     const uint32_t frameNumber = command.read<uint32_t>();
     const uint32_t taskID = command.read<uint32_t>();
 
     LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit " << command << " frame data "
-                                    << frameData << " receiver " << nodeID
-                                    << " on " << netNodeID << std::endl;
+                                    << frameData << " to " << nodes.size()
+                                    << " receivers" << std::endl;
 
-    _transmitImage(frameData, nodeID, netNodeID, imageIndex, frameNumber,
+    _transmitImage(frameData, nodes, netNodes, imageIndex, frameNumber,
                    taskID);
     _unrefFrame(frameNumber);
     return true;
@@ -1867,30 +2161,107 @@ bool Channel::_cmdFrameSetReadyNode(co::ICommand& cmd)
         command.read<std::vector<uint128_t>>();
     const co::NodeIDs& netNodes = command.read<co::NodeIDs>();
     const uint32_t frameNumber = command.read<uint32_t>();
+    const uint32_t taskID = command.read<uint32_t>();
 
-    co::LocalNodePtr localNode = getLocalNode();
     const FrameDataPtr frameData = getNode()->getFrameData(frameDataVersion);
+    if (frameData->getPreCompositeSize() > 1)
+    {
+        const detail::PreCompositeOutput output = {this, frameData,
+                                                   frameDataVersion, nodes,
+                                                   netNodes, frameNumber,
+                                                   taskID};
+        const detail::PreCompositeOutputs& outputs =
+            getNode()->getPreCompositor().add(output);
+        if (!outputs.empty())
+            outputs.front().channel->_transmitPreComposite(outputs);
+        return true;
+    }
+
+    _sendReady(frameDataVersion, frameData, nodes, netNodes);
+    _unrefFrame(frameNumber);
+    return true;
+}
 
-    co::NodeIDs::const_iterator j = netNodes.begin();
-    for (std::vector<uint128_t>::const_iterator i = nodes.begin();
-         i != nodes.end(); ++i, ++j)
+void Channel::_sendReady(const co::ObjectVersion& frameDataVersion,
+                         FrameDataPtr frameData,
+                         const std::vector<uint128_t>& nodes,
+                         const co::NodeIDs& netNodes)
+{
+    // use the same connections as the image data to keep the ordering
+    const detail::Transmissions& transmissions =
+        detail::_getTransmissions(getLocalNode(), getNode(), nodes, netNodes);
+
+    for (const detail::Transmission& transmission : transmissions)
     {
-        co::NodePtr toNode = localNode->connect(*j);
-        if (!toNode)
-        {
-            LBERROR << "Can't connect to " << *j << " to signal ready of frame "
-                    << frameNumber << std::endl;
-            continue;
-        }
-        co::ObjectOCommand os(co::Connections(1, toNode->getConnection()),
-                              fabric::CMD_NODE_FRAMEDATA_READY,
-                              co::COMMANDTYPE_OBJECT, *i, CO_INSTANCE_ALL);
+        const bool multicast = transmission.isMulticast();
+        const uint32_t cmd =
+            multicast ? uint32_t(fabric::CMD_CONFIG_FRAMEDATA_READY)
+                      : uint32_t(fabric::CMD_NODE_FRAMEDATA_READY);
+        co::ObjectOCommand os(co::Connections(1, transmission.connection), cmd,
+                              co::COMMANDTYPE_OBJECT,
+                              multicast ? getConfig()->getID()
+                                        : transmission.nodes.front(),
+                              CO_INSTANCE_ALL);
+        if (multicast)
+            os << transmission.nodes;
         os << frameDataVersion;
         frameData->serialize(os);
     }
+}
 
-    _unrefFrame(frameNumber);
-    return true;
+void Channel::_transmitPreComposite(const detail::PreCompositeOutputs& outputs)
+{
+    const detail::PreCompositeOutput& leader = outputs.front();
+    Image* image = getNode()->getPreCompositor().merge(outputs);
+
+    if (image)
+    {
+        LBLOG(LOG_TASKS | LOG_ASSEMBLY) << "Transmit " << outputs.size()
+                                        << " pre-composited outputs"
+                                        << std::endl;
+        ChannelStatistics transmitEvent(Statistic::CHANNEL_FRAME_TRANSMIT,
+                                        this, leader.frameNumber);
+        transmitEvent.statistic.task = leader.taskID;
+        transmitEvent.statistic.ratio = 1.0f;
+
+        // bytes put on the wire vs. bytes needed without pre-composition
+        const detail::Transmissions& transmissions =
+            detail::_getTransmissions(getLocalNode(), getNode(), leader.nodes,
+                                      leader.netNodes);
+        uint64_t sentBytes = 0;
+        uint64_t unicastBytes = 0;
+        for (const detail::Transmission& transmission : transmissions)
+        {
+            const uint64_t size =
+                _transmitImage(transmission, leader.frameDataVersion, image,
+                               leader.frameNumber, leader.taskID);
+            sentBytes += size;
+            unicastBytes += size * transmission.nodes.size() * outputs.size();
+        }
+
+        if (unicastBytes > 0)
+            transmitEvent.statistic.ratio =
+                float(sentBytes) / float(unicastBytes);
+    }
+    else // not mergeable on the CPU, send the images of each output
+    {
+        for (const detail::PreCompositeOutput& output : outputs)
+        {
+            const size_t nImages = output.frameData->getImages().size();
+            for (size_t i = 0; i < nImages; ++i)
+                output.channel->_transmitImage(output.frameDataVersion,
+                                               output.nodes, output.netNodes,
+                                               i, output.frameNumber,
+                                               output.taskID);
+        }
+    }
+
+    for (const detail::PreCompositeOutput& output : outputs)
+    {
+        output.channel->_sendReady(output.frameDataVersion, output.frameData,
+                                   output.nodes, output.netNodes);
+        output.channel->_unrefFrame(output.frameNumber);
+    }
 }
 
 bool Channel::_cmdFrameViewStart(co::ICommand& cmd)
@@ -1908,6 +2279,46 @@ bool Channel::_cmdFrameViewStart(co::ICommand& cmd)
     return true;
 }
 
+void Channel::_reproject()
+{
+    const View* view = getView();
+    const Observer* observer = view ? view->getObserver() : 0;
+    Matrix4f renderedHead;
+    Matrix4f head;
+    int64_t renderedTime = 0;
+    int64_t time = 0;
+    if (!observer ||
+        !observer->getHeadSample(getCurrentFrame(), renderedHead,
+                                 renderedTime) ||
+        !observer->getLatestHeadSample(head, time))
+    {
+        return;
+    }
+
+    // glDrawPixels is not available in a core profile
+    const bool coreProfile = getWindow()->getIAttribute(
+                                 WindowSettings::IATTR_HINT_CORE_PROFILE) == ON;
+    if (!coreProfile && _impl->reprojector.setup(*this, renderedHead, head))
+    {
+        ChannelStatistics event(Statistic::CHANNEL_REPROJECT, this);
+        EQ_GL_CALL(applyBuffer());
+        EQ_GL_CALL(applyViewport());
+        EQ_GL_CALL(setupAssemblyState());
+        _impl->reprojector.apply(getPixelViewport());
+        EQ_GL_CALL(resetAssemblyState());
+    }
+    else
+        time = renderedTime; // displays the rendered head position
+
+    // age of the displayed head position when the view is finished
+    ChannelStatistics event(Statistic::CHANNEL_MOTION_TO_DISPLAY, this);
+    const int64_t now = getConfig()->getTime();
+    event.statistic.startTime = time;
+    event.statistic.endTime = now;
+    event.statistic.ratio =
+        float(now - time) / float(std::max(now - renderedTime, int64_t(1)));
+}
+
 bool Channel::_cmdFrameViewFinish(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
@@ -1917,6 +2328,8 @@ bool Channel::_cmdFrameViewFinish(co::ICommand& cmd)
                      << " " << context << std::endl;
 
     _overrideContext(context);
+    if (getIAttribute(IATTR_HINT_REPROJECTION) == ON)
+        _reproject();
     {
         ChannelStatistics event(Statistic::CHANNEL_VIEW_FINISH, this);
         frameViewFinish(context.frameID);
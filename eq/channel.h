@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *                          Daniel Nachbaur <danielnachbaur@gmail.com>
  *
@@ -29,7 +29,10 @@ namespace eq
 namespace detail
 {
 class Channel;
+class SharedImageRing;
+struct PreCompositeOutput;
 struct RBStat;
+struct Transmission;
 }
 
 /**
@@ -621,6 +624,7 @@ protected:
 private:
     detail::Channel* const _impl;
     friend class fabric::Window<Pipe, Window, Channel, WindowSettings>;
+    friend class ChannelStatistics;
 
     //-------------------- Methods --------------------
     /** Setup the current rendering context. */
@@ -640,11 +644,52 @@ private:
     /** Check for and send frame finish reply. */
     void _unrefFrame(const uint32_t frameNumber);
 
-    /** Transmit one image of a frame to one node. */
+    /** @return the slot of a new GPU timing, or LB_UNDEFINED_UINT32. */
+    uint32_t _startGPUTiming(const Statistic& statistic);
+
+    /** Finish a GPU timing, the statistic is added once it is available. */
+    void _stopGPUTiming(const uint32_t slot, const Statistic& statistic);
+
+    /** Release a GPU timing of a statistic with explicit times. */
+    void _cancelGPUTiming(const uint32_t slot);
+
+    /** Add available GPU timings, waiting for all up to the given frame. */
+    void _collectGPUTimings(const uint32_t waitFrame);
+
+    /** Warp the assembled view to the newest head position before swap. */
+    void _reproject();
+
+    /** Transmit one image of a frame to all receiving nodes. */
     void _transmitImage(const co::ObjectVersion& frameDataVersion,
-                        const uint128_t& nodeID, const co::NodeID& netNodeID,
-                        const uint64_t imageIndex, const uint32_t frameNumber,
-                        const uint32_t taskID);
+                        const std::vector<uint128_t>& nodes,
+                        const co::NodeIDs& netNodes, const uint64_t imageIndex,
+                        const uint32_t frameNumber, const uint32_t taskID);
+
+    /**
+     * Transmit one image over a unicast or multicast connection.
+     * @return the number of bytes sent over the network.
+     */
+    uint64_t _transmitImage(const detail::Transmission& transmission,
+                            const co::ObjectVersion& frameDataVersion,
+                            Image* image, const uint32_t frameNumber,
+                            const uint32_t taskID);
+
+    /** Send the ready frame data to all receiving nodes. */
+    void _sendReady(const co::ObjectVersion& frameDataVersion,
+                    FrameDataPtr frameData,
+                    const std::vector<uint128_t>& nodes,
+                    const co::NodeIDs& netNodes);
+
+    /** Transmit the outputs of a complete pre-composition group. */
+    void _transmitPreComposite(
+        const std::vector<detail::PreCompositeOutput>& outputs);
+
+    /** Transmit one image to a node on the same host. */
+    bool _transmitSharedImage(detail::SharedImageRing& ring,
+                              co::ConnectionPtr connection,
+                              const co::ObjectVersion& frameDataVersion,
+                              const uint128_t& nodeID, const Image* image,
+                              const uint32_t frameNumber);
 
     void _frameReadback(const uint128_t& frameID,
                         const co::ObjectVersions& frames);
@@ -32,11 +32,31 @@
 
 namespace eq
 {
+namespace
+{
+/** @return true for operations timed on the GPU with the NICEST hint. */
+bool _isGPUOperation(const Statistic::Type type)
+{
+    switch (type)
+    {
+    case Statistic::CHANNEL_CLEAR:
+    case Statistic::CHANNEL_DRAW:
+    case Statistic::CHANNEL_DRAW_FINISH:
+    case Statistic::CHANNEL_ASSEMBLE:
+    case Statistic::CHANNEL_VIEW_FINISH:
+        return true;
+    default:
+        return false;
+    }
+}
+}
+
 ChannelStatistics::ChannelStatistics(const Statistic::Type type,
                                      Channel* channel, const uint32_t frame,
                                      const int32_t hint)
     : StatisticSampler<Channel>(type, channel, frame)
     , _hint(hint)
+    , _gpuTiming(LB_UNDEFINED_UINT32)
 {
     if (_hint == AUTO)
         _hint = channel->getIAttribute(Channel::IATTR_HINT_STATISTICS);
@@ -53,7 +73,12 @@ ChannelStatistics::ChannelStatistics(const Statistic::Type type,
         snprintf(statistic.resourceName, 32, "%s", name.c_str());
     statistic.resourceName[31] = 0;
 
-    if (_hint == NICEST && type != Statistic::CHANNEL_ASYNC_READBACK &&
+    // Time GPU operations asynchronously, fall back to a finish otherwise
+    if (_hint == NICEST && _isGPUOperation(type))
+        _gpuTiming = channel->_startGPUTiming(statistic);
+
+    if (_hint == NICEST && _gpuTiming == LB_UNDEFINED_UINT32 &&
+        type != Statistic::CHANNEL_ASYNC_READBACK &&
         type != Statistic::CHANNEL_FRAME_TRANSMIT &&
         type != Statistic::CHANNEL_FRAME_COMPRESS &&
         type != Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN)
@@ -69,8 +94,20 @@ ChannelStatistics::~ChannelStatistics()
     if (_hint == OFF)
         return;
 
+    if (_gpuTiming != LB_UNDEFINED_UINT32)
+    {
+        if (statistic.endTime == 0) // times are not set explicitly
+        {
+            _owner->_stopGPUTiming(_gpuTiming, statistic);
+            statistic.endTime = statistic.startTime; // sent later
+            return;
+        }
+        _owner->_cancelGPUTiming(_gpuTiming);
+    }
+
     const Statistic::Type type = statistic.type;
-    if (_hint == NICEST && type != Statistic::CHANNEL_ASYNC_READBACK &&
+    if (_hint == NICEST && _gpuTiming == LB_UNDEFINED_UINT32 &&
+        type != Statistic::CHANNEL_ASYNC_READBACK &&
         type != Statistic::CHANNEL_FRAME_TRANSMIT &&
         type != Statistic::CHANNEL_FRAME_COMPRESS &&
         type != Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN)
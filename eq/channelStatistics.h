@@ -31,6 +31,10 @@ class ChannelStatistics : public StatisticSampler<Channel>
 public:
     /**
      * Construct a statistics sampler and sample the start time.
+     *
+     * With the NICEST hint, GPU operations are timed using asynchronous
+     * timestamp queries if supported by the window. Their statistic is added
+     * once the query results are available, typically a frame later.
      * @version 1.0
      */
     EQ_API ChannelStatistics(const Statistic::Type type, Channel* channel,
@@ -44,6 +48,7 @@ public:
 
 private:
     int32_t _hint;
+    uint32_t _gpuTiming;
 };
 }
 
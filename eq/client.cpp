@@ -27,6 +27,7 @@
 #include "server.h"
 
 #include <eq/fabric/commands.h>
+#include <eq/fabric/configParams.h>
 #include <eq/fabric/configVisitor.h>
 #include <eq/fabric/elementVisitor.h>
 #include <eq/fabric/leafVisitor.h>
@@ -34,6 +35,7 @@
 #include <eq/fabric/view.h>
 
 #include <eq/server/localServer.h>
+#include <eq/server/residentPool.h>
 
 #include <co/connection.h>
 #include <co/connectionDescription.h>
@@ -48,10 +50,19 @@
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #ifdef _MSC_VER
 #include <direct.h>
 #define chdir _chdir
 #endif
+#ifndef _WIN32
+#include <csignal>
+#include <pthread.h>
+#endif
 
 #ifdef EQ_QT_USED
 #include <QApplication> // must be included before any header defining Bool
@@ -77,8 +88,15 @@ public:
     Client()
         : queue(co::Global::getCommandQueueLimit())
         , modelUnit(EQ_UNDEFINED_UNIT)
+        , benchmarkOutput("benchmark.csv")
+        , benchmarkFrames(0)
+        , benchmarkFreeze(false)
+        , offlineLatency(8)
         , qtApp(0)
         , running(false)
+        , resident(false)
+        , stopResident(false)
+        , hasServer(false)
     {
     }
 
@@ -88,8 +106,35 @@ public:
     ServerSet localServers;
     std::string gpuFilter;
     float modelUnit;
+    std::string benchmarkPath;
+    std::string benchmarkOutput;
+    uint32_t benchmarkFrames;
+    bool benchmarkFreeze;
+    std::string offlinePrefix;
+    uint32_t offlineLatency;
     QApplication* qtApp;
     bool running;
+    bool resident; //!< --eq-daemon: survive configuration exits
+    std::atomic<bool> stopResident; //!< SIGTERM or SIGINT received
+    std::atomic<bool> hasServer;    //!< a server uses the resident client
+    std::unique_ptr<server::ResidentPool> announcement; //!< while idle
+    std::mutex announcementLock;
+
+    /** Announce or withdraw the idle resident client on zeroconf. */
+    void announce(co::LocalNode& node, const std::string& clientName)
+    {
+        std::lock_guard<std::mutex> lock(announcementLock);
+        if (!announcement)
+            announcement.reset(new server::ResidentPool(clientName));
+        announcement->announce(node);
+    }
+
+    void withdraw()
+    {
+        std::lock_guard<std::mutex> lock(announcementLock);
+        if (announcement)
+            announcement->withdraw();
+    }
 
     void initQt(int argc LB_UNUSED, char** argv LB_UNUSED)
     {
@@ -193,6 +238,12 @@ arg::options_description _getProgramOptions()
     arg::options_description options("eq::Client options",
                                      lunchbox::term::getSize().first);
     options.add_options()("eq-client", "Internal, used for render clients")(
+        "eq-daemon",
+        "Run as a resident render client which is reused across configuration "
+        "runs instead of being launched for each run. It is found through the "
+        "node connections of the configuration, or through its zeroconf "
+        "announcement on the node's host. SIGTERM or SIGINT stop it once no "
+        "configuration is running.")(
         "eq-layout", arg::value<std::string>(),
         "Name of the layout to "
         "activate on all canvases during Config::init(). The option can be "
@@ -203,7 +254,24 @@ arg::options_description _getProgramOptions()
         "Scale the rendered models "
         "in all views. The model unit defines the size of the model wrt the "
         "virtual room unit which is always in meter. The default unit is 1 "
-        "(1 meter or EQ_M).");
+        "(1 meter or EQ_M).")("eq-benchmark", arg::value<std::string>(),
+                              "Run a benchmark using the given camera path, "
+                              "in the eqPly path format, on all observers.")(
+        "eq-benchmark-frames", arg::value<uint32_t>(),
+        "Number of frames to benchmark, defaults to the camera path length.")(
+        "eq-benchmark-output", arg::value<std::string>(),
+        "File for the per-frame times and statistics of the benchmark, in "
+        "JSON for a .json extension and CSV otherwise.")(
+        "eq-benchmark-freeze",
+        "Freeze all load balancers to their initial state for reproducible "
+        "benchmark results.")(
+        "eq-offline", arg::value<std::string>(),
+        "Render the --eq-benchmark camera path offline on the DPlex layout: "
+        "frames are dispatched to the first free pipe and the images of all "
+        "views are written by a background thread, using the given file name "
+        "prefix.")(
+        "eq-offline-latency", arg::value<uint32_t>(),
+        "Number of frames in flight during offline rendering, default 8.");
 
     return options;
 }
@@ -246,7 +314,8 @@ bool Client::initLocal(const int argc, char** argv)
         return false;
     }
 
-    const bool isClient = vm.count("eq-client");
+    _impl->resident = vm.count("eq-daemon");
+    const bool isClient = vm.count("eq-client") || _impl->resident;
     std::string clientOpts;
 
     if (vm.count("eq-layout"))
@@ -255,6 +324,28 @@ bool Client::initLocal(const int argc, char** argv)
         _impl->gpuFilter = vm["eq-gpufilter"].as<std::string>();
     if (vm.count("eq-modelunit"))
         _impl->modelUnit = vm["eq-modelunit"].as<float>();
+    if (vm.count("eq-benchmark"))
+        _impl->benchmarkPath = vm["eq-benchmark"].as<std::string>();
+    if (vm.count("eq-benchmark-frames"))
+        _impl->benchmarkFrames = vm["eq-benchmark-frames"].as<uint32_t>();
+    if (vm.count("eq-benchmark-output"))
+        _impl->benchmarkOutput = vm["eq-benchmark-output"].as<std::string>();
+    _impl->benchmarkFreeze = vm.count("eq-benchmark-freeze");
+    if (vm.count("eq-offline"))
+    {
+        _impl->offlinePrefix = vm["eq-offline"].as<std::string>();
+        Global::setFlags(Global::getFlags() |
+                         fabric::ConfigParams::FLAG_OFFLINE);
+        // the frame-parallel layout of the server's auto-configuration
+        if (_impl->activeLayouts.empty())
+            _impl->activeLayouts.push_back("DPlex");
+    }
+    if (vm.count("eq-offline-latency"))
+        _impl->offlineLatency = vm["eq-offline-latency"].as<uint32_t>();
+
+    // before initLocal, so that all threads inherit the blocked signals
+    if (_impl->resident)
+        _blockStopSignals();
 
     LBVERB << "Launching " << getNodeID() << std::endl;
     if (!Super::initLocal(argc, argv))
@@ -271,6 +362,14 @@ bool Client::initLocal(const int argc, char** argv)
             return false;
         }
 
+        if (_impl->resident)
+        {
+            _watchStopSignals();
+            _impl->announce(*this, getName());
+            LBINFO << "Resident render client ready for configurations"
+                   << std::endl;
+        }
+
         _impl->running = true;
         clientLoop();
         exitClient();
@@ -364,6 +463,48 @@ bool Client::isRunning() const
     return _impl->running;
 }
 
+bool Client::isResident() const
+{
+    return _impl->resident;
+}
+
+void Client::_blockStopSignals()
+{
+#ifndef _WIN32
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &signals, 0);
+#endif
+}
+
+void Client::_watchStopSignals()
+{
+#ifdef _WIN32
+    LBINFO << "Resident render clients can't be stopped by signals on Windows"
+           << std::endl;
+#else
+    co::LocalNodePtr self = this;
+    std::thread([self, this] {
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGINT);
+        int received = 0;
+        if (sigwait(&signals, &received) != 0)
+            return;
+
+        LBINFO << "Received signal " << received << ", stopping resident "
+               << "render client" << std::endl;
+        _impl->stopResident = true;
+        // local command dispatching, handled by _cmdExit()
+        co::OCommand(self.get(), self.get(), fabric::CMD_CLIENT_EXIT,
+                     co::COMMANDTYPE_NODE);
+    }).detach();
+#endif
+}
+
 co::CommandQueue* Client::getMainThreadQueue()
 {
     return &_impl->queue;
@@ -399,6 +540,36 @@ float Client::getModelUnit() const
     return _impl->modelUnit;
 }
 
+const std::string& Client::getBenchmarkPath() const
+{
+    return _impl->benchmarkPath;
+}
+
+uint32_t Client::getBenchmarkFrames() const
+{
+    return _impl->benchmarkFrames;
+}
+
+const std::string& Client::getBenchmarkOutput() const
+{
+    return _impl->benchmarkOutput;
+}
+
+bool Client::getBenchmarkFreeze() const
+{
+    return _impl->benchmarkFreeze;
+}
+
+const std::string& Client::getOfflinePrefix() const
+{
+    return _impl->offlinePrefix;
+}
+
+uint32_t Client::getOfflineLatency() const
+{
+    return _impl->offlineLatency;
+}
+
 void Client::interruptMainThread()
 {
     send(fabric::CMD_CLIENT_INTERRUPT);
@@ -410,6 +581,9 @@ co::NodePtr Client::createNode(const uint32_t type)
     {
     case fabric::NODETYPE_SERVER:
     {
+        _impl->hasServer = true;
+        if (_impl->resident) // in use until the configuration exits
+            _impl->withdraw();
         Server* server = new Server;
         server->setClient(this);
         return server;
@@ -422,9 +596,40 @@ co::NodePtr Client::createNode(const uint32_t type)
 
 bool Client::_cmdExit(co::ICommand& command)
 {
+    co::LocalNodePtr localNode = command.getLocalNode();
+    co::NodePtr remoteNode = command.getRemoteNode();
+    if (_impl->resident)
+    {
+        // Keep the process alive for the next configuration, unless it was
+        // asked to stop. A running configuration is finished first.
+        if (remoteNode.get() != localNode.get()) // configuration exit
+        {
+            localNode->disconnect(remoteNode);
+            _impl->hasServer = false;
+        }
+
+        if (!_impl->stopResident)
+        {
+            if (remoteNode.get() != localNode.get())
+                LBINFO << "Configuration exited, resident render client "
+                       << "waiting for the next run" << std::endl;
+            if (!_impl->hasServer)
+                _impl->announce(*this, getName());
+            return true;
+        }
+        if (_impl->hasServer)
+        {
+            LBINFO << "Resident render client stops after the running "
+                   << "configuration" << std::endl;
+            return true;
+        }
+        _impl->running = false;
+        return true;
+    }
+
     _impl->running = false;
     // Close connection here, this is the last command we'll get on it
-    command.getLocalNode()->disconnect(command.getRemoteNode());
+    localNode->disconnect(remoteNode);
     return true;
 }
 
@@ -451,6 +656,7 @@ void Client::notifyDisconnect(co::NodePtr node)
 {
     if (node->getType() == fabric::NODETYPE_SERVER)
     {
+        _impl->hasServer = false;
         // local command dispatching
         co::OCommand(this, this, fabric::CMD_CLIENT_EXIT, co::COMMANDTYPE_NODE);
 
@@ -96,6 +96,16 @@ public:
     /** @return true if the clientLoop() should keep running. @version 1.11 */
     EQ_API bool isRunning() const;
 
+    /**
+     * @return true if this process is a resident render client daemon.
+     *
+     * Resident render clients are started with --eq-daemon and stay alive
+     * across configuration runs. Applications may keep process-wide caches,
+     * e.g., loaded models, warm between runs when this returns true.
+     * @version 2.1
+     */
+    EQ_API bool isResident() const;
+
     /** @internal @return the command queue to the main node thread. */
     EQ_API co::CommandQueue* getMainThreadQueue() override;
 
@@ -124,6 +134,24 @@ public:
 
     /** @internal @return the model unit for all views. */
     float getModelUnit() const;
+
+    /** @internal @return the camera path given by --eq-benchmark. */
+    const std::string& getBenchmarkPath() const;
+
+    /** @internal @return the frames given by --eq-benchmark-frames, or 0. */
+    uint32_t getBenchmarkFrames() const;
+
+    /** @internal @return the file given by --eq-benchmark-output. */
+    const std::string& getBenchmarkOutput() const;
+
+    /** @internal @return true if --eq-benchmark-freeze was given. */
+    bool getBenchmarkFreeze() const;
+
+    /** @internal @return the image file prefix given by --eq-offline. */
+    const std::string& getOfflinePrefix() const;
+
+    /** @internal @return the frames in flight given by --eq-offline-latency */
+    uint32_t getOfflineLatency() const;
     //@}
 
 protected:
@@ -157,6 +185,10 @@ private:
 
     bool _setupClient(const std::string& clientArgs);
 
+    /** Stop a resident render client on SIGTERM or SIGINT. */
+    void _blockStopSignals();
+    void _watchStopSignals();
+
     /** The command functions. */
     bool _cmdExit(co::ICommand& command);
     bool _cmdInterrupt(co::ICommand& command);
@@ -22,6 +22,13 @@
 
 #include <co/iCommand.h>
 #include <lunchbox/clock.h>
+#include <lunchbox/debug.h>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
 
 namespace eq
 {
@@ -34,6 +41,12 @@ CommandQueue::CommandQueue(const size_t maxSize)
     : co::CommandQueue(maxSize)
     , _messagePump(0)
     , _waitTime(0)
+#ifdef __linux__
+    , _notifier(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+#else
+    , _notifier(-1)
+#endif
+    , _notifierWait(false)
 {
 }
 
@@ -42,55 +55,96 @@ CommandQueue::~CommandQueue()
     LBASSERT(!_messagePump);
     delete _messagePump;
     _messagePump = 0;
+#ifdef __linux__
+    if (_notifier >= 0)
+        ::close(_notifier);
+#endif
 }
 
 void CommandQueue::push(const co::ICommand& command)
 {
     co::CommandQueue::push(command);
-    if (_messagePump)
-        _messagePump->postWakeup();
+    _signal();
 }
 
 void CommandQueue::pushFront(const co::ICommand& command)
 {
     co::CommandQueue::pushFront(command);
-    if (_messagePump)
+    _signal();
+}
+
+void CommandQueue::_signal()
+{
+#ifdef __linux__
+    if (_notifier >= 0)
+    {
+        const uint64_t value = 1;
+        if (::write(_notifier, &value, sizeof(value)) != sizeof(value))
+            LBVERB << "Can't signal command queue notifier" << std::endl;
+    }
+#endif
+    if (_messagePump && !_notifierWait)
         _messagePump->postWakeup();
 }
 
+void CommandQueue::_clearNotifier()
+{
+#ifdef __linux__
+    // Reset before checking for commands, so that a push() after the check
+    // wakes up the wait
+    uint64_t value;
+    if (_notifier >= 0 && ::read(_notifier, &value, sizeof(value)) < 0)
+        LBASSERTINFO(errno == EAGAIN, lunchbox::sysError());
+#endif
+}
+
+bool CommandQueue::_wait(const int64_t start, const uint32_t timeout)
+{
+    const int64_t waitBegin = _clock.getTime64();
+    const int64_t elapsed = waitBegin - start;
+    if (elapsed > timeout)
+        return false;
+
+    const uint32_t remaining = timeout == LB_TIMEOUT_INDEFINITE
+                                   ? timeout
+                                   : uint32_t(timeout - elapsed);
+
+    // Wait once on the window system events and the notifier together, or
+    // fall back to the wakeup-based wait of the message pump
+    if (_notifier >= 0 && _messagePump->wait(_notifier, remaining))
+        _notifierWait = true;
+    else
+        _messagePump->dispatchOne(remaining); // blocks - push sends wakeup
+
+    _waitTime += (_clock.getTime64() - waitBegin);
+    return true;
+}
+
 co::ICommand CommandQueue::pop(const uint32_t timeout)
 {
     const int64_t start = _clock.getTime64();
-    int64_t waitBegin = -1;
     while (true)
     {
         if (_messagePump)
+        {
             _messagePump->dispatchAll(); // non-blocking
+            _clearNotifier();
+        }
 
         // Poll for a command
         if (!isEmpty())
-        {
-            if (waitBegin > -1)
-                _waitTime += (_clock.getTime64() - waitBegin);
             return co::CommandQueue::pop(0);
-        }
 
-        if (_messagePump)
-        {
-            if (waitBegin == -1)
-                waitBegin = _clock.getTime64();
-            _messagePump->dispatchOne(timeout); // blocks - push sends wakeup
-        }
-        else
+        if (!_messagePump)
         {
-            waitBegin = _clock.getTime64();
+            const int64_t waitBegin = _clock.getTime64();
             // blocking
             const co::ICommand& command = co::CommandQueue::pop(timeout);
             _waitTime += (_clock.getTime64() - waitBegin);
             return command;
         }
 
-        if (_clock.getTime64() - start > timeout)
+        if (!_wait(start, timeout))
             return co::ICommand();
     }
 }
@@ -98,36 +152,28 @@ co::ICommand CommandQueue::pop(const uint32_t timeout)
 co::ICommands CommandQueue::popAll(const uint32_t timeout)
 {
     const int64_t start = _clock.getTime64();
-    int64_t waitBegin = -1;
     while (true)
     {
         if (_messagePump)
+        {
             _messagePump->dispatchAll(); // non-blocking
+            _clearNotifier();
+        }
 
         // Poll for commands
         if (!isEmpty())
-        {
-            if (waitBegin > -1)
-                _waitTime += (_clock.getTime64() - waitBegin);
             return co::CommandQueue::popAll(0);
-        }
 
-        if (_messagePump)
-        {
-            if (waitBegin == -1)
-                waitBegin = _clock.getTime64();
-            _messagePump->dispatchOne(timeout); // blocks - push sends wakeup
-        }
-        else
+        if (!_messagePump)
         {
-            waitBegin = _clock.getTime64();
+            const int64_t waitBegin = _clock.getTime64();
             // blocking
             const co::ICommands& commands = co::CommandQueue::popAll(timeout);
             _waitTime += (_clock.getTime64() - waitBegin);
             return commands;
         }
 
-        if (_clock.getTime64() - start > timeout)
+        if (!_wait(start, timeout))
             return co::ICommands();
     }
 }
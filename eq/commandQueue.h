@@ -23,6 +23,8 @@
 #include <eq/types.h>
 #include <eq/windowSystem.h> // enum
 
+#include <atomic>
+
 namespace eq
 {
 /**
@@ -69,6 +71,18 @@ private:
 
     /** The time spent waiting in pop(). */
     int64_t _waitTime;
+
+    /** Event file descriptor signalled by push(), -1 if not available. */
+    int _notifier;
+
+    /** The message pump waits on _notifier, no postWakeup() needed. */
+    std::atomic<bool> _notifierWait;
+
+    void _signal();
+    void _clearNotifier();
+
+    /** Block until an event or command arrives, false on timeout. */
+    bool _wait(const int64_t start, const uint32_t timeout);
 };
 }
 
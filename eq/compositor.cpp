@@ -61,15 +61,18 @@ static const char* depthDBKey = shaderDBKey + 2;
 
 // Image used for CPU-based assembly
 static lunchbox::PerThread<Image> _resultImage;
+// Image used for resampling zoomed input images during CPU-based assembly
+static lunchbox::PerThread<Image> _zoomedImage;
 
 struct CPUAssemblyFormat
 {
-    CPUAssemblyFormat(const bool blend_)
+    CPUAssemblyFormat(const bool blend_, const bool resample_ = false)
         : colorInt(0)
         , colorExt(0)
         , depthInt(0)
         , depthExt(0)
         , blend(blend_)
+        , resample(resample_)
     {
     }
 
@@ -78,8 +81,15 @@ struct CPUAssemblyFormat
     uint32_t depthInt;
     uint32_t depthExt;
     const bool blend;
+    const bool resample; //!< pixel, subpixel or zoom recomposition
 };
 
+bool _needsResampling(const RenderContext& context, const Zoom& zoom)
+{
+    return context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
+           zoom != Zoom::NONE;
+}
+
 bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
 {
     const bool hasColor = image->hasPixelData(Frame::Buffer::color);
@@ -88,7 +98,9 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     if ( // Not an alpha-blending compositing
         (!format.blend || !hasColor || !image->hasAlpha()) &&
         // and not a depth-sorting compositing
-        (!hasColor || !hasDepth))
+        (!hasColor || !hasDepth) &&
+        // and not a pixel, subpixel or zoom recomposition
+        (!format.resample || !hasColor))
     {
         return false;
     }
@@ -108,8 +120,8 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     {
     case EQ_COMPRESSOR_DATATYPE_RGB10_A2:
     case EQ_COMPRESSOR_DATATYPE_BGR10_A2:
-        if (!hasDepth)
-            // blending of RGB10A2 not implemented
+        if (!hasDepth || format.resample)
+            // blending, averaging and filtering of RGB10A2 not implemented
             return false;
         break;
 
@@ -138,6 +150,17 @@ bool _useCPUAssembly(const Image* image, CPUAssemblyFormat& format)
     return format.depthExt == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT;
 }
 
+bool _useCPUAssembly(const ImageOp& op, CPUAssemblyFormat& format)
+{
+    // pixel de-interleaving of zoomed images not implemented
+    if (op.image->getContext().pixel != Pixel::ALL && op.zoom != Zoom::NONE)
+        return false;
+    // images zoomed during readback are left to the GL path
+    if (op.image->getZoom() != Zoom::NONE)
+        return false;
+    return _useCPUAssembly(op.image, format);
+}
+
 bool _useCPUAssembly(const Frames& frames, Channel* channel,
                      const bool blend = false)
 {
@@ -145,22 +168,33 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
     if (frames.size() < 2)
         return false;
 
-    // Test that the input frames have color and depth buffers or that
-    // alpha-blended assembly is used with multiple RGBA buffers. We assume then
-    // that we will have at least one image per frame so most likely it's worth
-    // to wait for the images and to do a CPU-based assembly. Also test early
-    // for unsupported decomposition modes
+    // Pixel, subpixel and zoomed frames are recomposited in one pass on the
+    // CPU, avoiding the stencil setup and one upload per image
+    bool resample = false;
+    for (const Frame* frame : frames)
+    {
+        Zoom zoom = frame->getZoom();
+        zoom.apply(frame->getFrameData()->getZoom());
+        if (_needsResampling(frame->getFrameData()->getContext(), zoom))
+            resample = true;
+        for (const Image* image : frame->getImages())
+            if (image->getZoom() != Zoom::NONE)
+                return false;
+    }
+
+    // Test that the input frames have color and depth buffers, that
+    // alpha-blended assembly is used with multiple RGBA buffers or that the
+    // frames need to be resampled. We assume then that we will have at least
+    // one image per frame so most likely it's worth to wait for the images and
+    // to do a CPU-based assembly.
     const Frame::Buffer desiredBuffers =
         blend ? Frame::Buffer::color
               : Frame::Buffer::color | Frame::Buffer::depth;
     for (const Frame* frame : frames)
     {
-        const RenderContext& context = frame->getFrameData()->getContext();
-
-        if (frame->getBuffers() != desiredBuffers ||
-            context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            frame->getFrameData()->getZoom() != Zoom::NONE ||
-            frame->getZoom() != Zoom::NONE) // Not supported by CPU compositor
+        const Frame::Buffer buffers = frame->getBuffers();
+        if (buffers != desiredBuffers &&
+            (!resample || buffers != Frame::Buffer::color))
         {
             return false;
         }
@@ -171,7 +205,7 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
     // all other preconditions for our CPU-based assembly code are true.
     size_t nImages = 0;
     const uint32_t timeout = channel->getConfig()->getTimeout();
-    CPUAssemblyFormat format(blend);
+    CPUAssemblyFormat format(blend, resample);
 
     for (const Frame* frame : frames)
     {
@@ -184,7 +218,7 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
         const Images& images = frame->getImages();
         for (const Image* image : images)
         {
-            if (!_useCPUAssembly(image, format))
+            if (!_useCPUAssembly(ImageOp(frame, image), format))
                 return false;
             ++nImages;
         }
@@ -194,12 +228,17 @@ bool _useCPUAssembly(const Frames& frames, Channel* channel,
 
 bool _useCPUAssembly(const ImageOps& ops, const bool blend)
 {
-    CPUAssemblyFormat format(blend);
+    bool resample = false;
+    for (const ImageOp& op : ops)
+        if (_needsResampling(op.image->getContext(), op.zoom))
+            resample = true;
+
+    CPUAssemblyFormat format(blend, resample);
     size_t nImages = 0;
 
     for (const ImageOp& op : ops)
     {
-        if (!_useCPUAssembly(op.image, format))
+        if (!_useCPUAssembly(op, format))
             return false;
         ++nImages;
     }
@@ -240,6 +279,24 @@ void _collectOutputData(const PixelData& pixelData, uint32_t& internalFormat,
     externalFormat = pixelData.externalFormat;
 }
 
+/**
+ * @return the destination area covered by the image after recomposition,
+ *         using the same quad coordinates as the GL path (_getCoords).
+ */
+PixelViewport _getDestPVP(const ImageOp& op)
+{
+    const PixelViewport& pvp = op.image->getPixelViewport();
+    const Pixel& pixel = op.image->getContext().pixel;
+    const int32_t w = int32_t(pixel.w);
+    const int32_t h = int32_t(pixel.h);
+    const int32_t x = pvp.x * w;
+    const int32_t y = pvp.y * h;
+
+    return PixelViewport(op.offset.x() + x, op.offset.y() + y,
+                         int32_t(pvp.getXEnd() * w * op.zoom.x() + .5f) - x,
+                         int32_t(pvp.getYEnd() * h * op.zoom.y() + .5f) - y);
+}
+
 bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
                         uint32_t& colorInt, uint32_t& colorPixelSize,
                         uint32_t& colorExt, uint32_t& depthInt,
@@ -248,8 +305,7 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
     for (const ImageOp& op : ops)
     {
         const RenderContext& context = op.image->getContext();
-        if (context.pixel != Pixel::ALL || context.subPixel != SubPixel::ALL ||
-            op.zoom != Zoom::NONE ||
+        if ((context.pixel != Pixel::ALL && op.zoom != Zoom::NONE) ||
             op.image->getStorageType() != Frame::TYPE_MEMORY)
         {
             return false;
@@ -258,7 +314,7 @@ bool _collectOutputData(const ImageOps& ops, PixelViewport& destPVP,
         if (!op.image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        destPVP.merge(op.image->getPixelViewport() + op.offset);
+        destPVP.merge(_getDestPVP(op));
 
         _collectOutputData(op.image->getPixelData(Frame::Buffer::color),
                            colorInt, colorPixelSize, colorExt);
@@ -287,9 +343,16 @@ void _mergeDBImage(void* destColor, void* destDepth,
     uint32_t* destD = reinterpret_cast<uint32_t*>(destDepth);
 
     const PixelViewport& pvp = image->getPixelViewport();
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
 
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    // pixel images are de-interleaved into every pixel.w'th column and
+    // pixel.h'th row, see _getCoords()
+    const int32_t destX =
+        offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t destY =
+        offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
 
     const uint32_t* color = reinterpret_cast<const uint32_t*>(
         image->getPixelPointer(Frame::Buffer::color));
@@ -299,7 +362,7 @@ void _mergeDBImage(void* destColor, void* destDepth,
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
-        const uint32_t skip = (destY + y) * destPVP.w + destX;
+        const uint32_t skip = (destY + y * stepY) * destPVP.w + destX;
         uint32_t* destColorIt = destC + skip;
         uint32_t* destDepthIt = destD + skip;
         const uint32_t* colorIt = color + y * pvp.w;
@@ -313,8 +376,8 @@ void _mergeDBImage(void* destColor, void* destDepth,
                 *destDepthIt = *depthIt;
             }
 
-            ++destColorIt;
-            ++destDepthIt;
+            destColorIt += stepX;
+            destDepthIt += stepX;
             ++colorIt;
             ++depthIt;
         }
@@ -332,8 +395,13 @@ void _merge2DImage(void* destColor, void* destDepth,
     uint8_t* destD = reinterpret_cast<uint8_t*>(destDepth);
 
     const PixelViewport& pvp = image->getPixelViewport();
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
+    const int32_t destX =
+        offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t destY =
+        offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
 
     LBASSERT(image->hasPixelData(Frame::Buffer::color));
 
@@ -344,11 +412,27 @@ void _merge2DImage(void* destColor, void* destDepth,
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
-        const size_t skip = ((destY + y) * destPVP.w + destX) * pixelSize;
-        memcpy(destC + skip, color + y * pvp.w * pixelSize, rowLength);
-        // clear depth, for depth-assembly into existing FB
-        if (destD)
-            lunchbox::setZero(destD + skip, rowLength);
+        const size_t skip =
+            ((destY + y * stepY) * destPVP.w + destX) * pixelSize;
+        const uint8_t* src = color + y * pvp.w * pixelSize;
+        if (stepX == 1)
+        {
+            memcpy(destC + skip, src, rowLength);
+            // clear depth, for depth-assembly into existing FB
+            if (destD)
+                lunchbox::setZero(destD + skip, rowLength);
+            continue;
+        }
+
+        // de-interleave pixel compound column
+        const size_t destStep = stepX * pixelSize;
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            const size_t destPos = skip + x * destStep;
+            memcpy(destC + destPos, src + x * pixelSize, pixelSize);
+            if (destD)
+                lunchbox::setZero(destD + destPos, pixelSize);
+        }
     }
 }
 
@@ -360,8 +444,13 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
     int32_t* destColor = reinterpret_cast<int32_t*>(dest);
 
     const PixelViewport& pvp = image->getPixelViewport();
-    const int32_t destX = offset.x() + pvp.x - destPVP.x;
-    const int32_t destY = offset.y() + pvp.y - destPVP.y;
+    const Pixel& pixel = image->getContext().pixel;
+    const int32_t stepX = int32_t(pixel.w);
+    const int32_t stepY = int32_t(pixel.h);
+    const int32_t destX =
+        offset.x() + pvp.x * stepX + int32_t(pixel.x) - destPVP.x;
+    const int32_t destY =
+        offset.y() + pvp.y * stepY + int32_t(pixel.y) - destPVP.y;
 
     LBASSERT(image->getPixelSize(Frame::Buffer::color) == 4);
     LBASSERT(image->hasPixelData(Frame::Buffer::color));
@@ -381,14 +470,15 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
 
     int32_t* destColorStart = destColor + destY * destPVP.w + destX;
     const uint32_t step = sizeof(int32_t);
+    const uint32_t destStep = step * stepX;
 
 #pragma omp parallel for
     for (int32_t y = 0; y < pvp.h; ++y)
     {
         const unsigned char* src =
             reinterpret_cast<const uint8_t*>(color + pvp.w * y);
-        unsigned char* dst =
-            reinterpret_cast<uint8_t*>(destColorStart + destPVP.w * y);
+        unsigned char* dst = reinterpret_cast<uint8_t*>(
+            destColorStart + destPVP.w * y * stepY);
 
         for (int32_t x = 0; x < pvp.w; ++x)
         {
@@ -398,11 +488,179 @@ void _blendImage(void* dest, const eq::PixelViewport& destPVP,
             dst[3] = src[3] * dst[3] >> 8;
 
             src += step;
-            dst += step;
+            dst += destStep;
+        }
+    }
+}
+
+void _zoomNearest(const uint8_t* src, const PixelViewport& srcPVP,
+                  uint8_t* dst, const PixelViewport& dstPVP,
+                  const size_t pixelSize)
+{
+#pragma omp parallel for
+    for (int32_t y = 0; y < dstPVP.h; ++y)
+    {
+        const int64_t srcY = (int64_t(2 * y + 1) * srcPVP.h) / (2 * dstPVP.h);
+        const uint8_t* srcRow = src + srcY * srcPVP.w * pixelSize;
+        uint8_t* dstRow = dst + size_t(y) * dstPVP.w * pixelSize;
+
+        for (int32_t x = 0; x < dstPVP.w; ++x)
+        {
+            const int64_t srcX =
+                (int64_t(2 * x + 1) * srcPVP.w) / (2 * dstPVP.w);
+            memcpy(dstRow + x * pixelSize, srcRow + srcX * pixelSize,
+                   pixelSize);
         }
     }
 }
 
+/** Bilinear magnification of 8 bit RGBA or BGRA pixels. */
+void _zoomBilinear(const uint8_t* src, const PixelViewport& srcPVP,
+                   uint8_t* dst, const PixelViewport& dstPVP)
+{
+    const float scaleX = float(srcPVP.w) / float(dstPVP.w);
+    const float scaleY = float(srcPVP.h) / float(dstPVP.h);
+
+#pragma omp parallel for
+    for (int32_t y = 0; y < dstPVP.h; ++y)
+    {
+        const float srcY = std::max((y + .5f) * scaleY - .5f, 0.f);
+        const int32_t y0 = std::min(int32_t(srcY), srcPVP.h - 1);
+        const int32_t y1 = std::min(y0 + 1, srcPVP.h - 1);
+        const float wY = srcY - float(y0);
+        const uint8_t* row0 = src + size_t(y0) * srcPVP.w * 4;
+        const uint8_t* row1 = src + size_t(y1) * srcPVP.w * 4;
+        uint8_t* dstRow = dst + size_t(y) * dstPVP.w * 4;
+
+        for (int32_t x = 0; x < dstPVP.w; ++x)
+        {
+            const float srcX = std::max((x + .5f) * scaleX - .5f, 0.f);
+            const int32_t x0 = std::min(int32_t(srcX), srcPVP.w - 1);
+            const int32_t x1 = std::min(x0 + 1, srcPVP.w - 1);
+            const float wX = srcX - float(x0);
+
+            for (size_t c = 0; c < 4; ++c)
+            {
+                const float top = row0[x0 * 4 + c] +
+                                  (row0[x1 * 4 + c] - row0[x0 * 4 + c]) * wX;
+                const float bottom =
+                    row1[x0 * 4 + c] +
+                    (row1[x1 * 4 + c] - row1[x0 * 4 + c]) * wX;
+                dstRow[x * 4 + c] = uint8_t(top + (bottom - top) * wY + .5f);
+            }
+        }
+    }
+}
+
+/** Box-filtered minification of 8 bit RGBA or BGRA pixels. */
+void _zoomBox(const uint8_t* src, const PixelViewport& srcPVP, uint8_t* dst,
+              const PixelViewport& dstPVP)
+{
+#pragma omp parallel for
+    for (int32_t y = 0; y < dstPVP.h; ++y)
+    {
+        const int64_t startY = (int64_t(y) * srcPVP.h) / dstPVP.h;
+        const int64_t endY = std::max((int64_t(y + 1) * srcPVP.h) / dstPVP.h,
+                                      startY + 1);
+        uint8_t* dstRow = dst + size_t(y) * dstPVP.w * 4;
+
+        for (int32_t x = 0; x < dstPVP.w; ++x)
+        {
+            const int64_t startX = (int64_t(x) * srcPVP.w) / dstPVP.w;
+            const int64_t endX = std::max(
+                (int64_t(x + 1) * srcPVP.w) / dstPVP.w, startX + 1);
+
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (int64_t i = startY; i < endY; ++i)
+            {
+                const uint8_t* srcIt = src + (i * srcPVP.w + startX) * 4;
+                for (int64_t j = startX; j < endX; ++j, srcIt += 4)
+                    for (size_t c = 0; c < 4; ++c)
+                        sum[c] += srcIt[c];
+            }
+
+            const uint32_t n = uint32_t((endY - startY) * (endX - startX));
+            for (size_t c = 0; c < 4; ++c)
+                dstRow[x * 4 + c] = uint8_t((sum[c] + n / 2) / n);
+        }
+    }
+}
+
+/**
+ * @return the image of the given operation resampled to its destination size,
+ *         or the operation's image if it is not zoomed.
+ */
+const Image* _zoomImage(const ImageOp& op)
+{
+    if (op.zoom == Zoom::NONE)
+        return op.image;
+
+    const Image* image = op.image;
+    const PixelViewport& pvp = image->getPixelViewport();
+    const PixelViewport& destPVP = _getDestPVP(op);
+    const PixelViewport zoomedPVP(pvp.x, pvp.y, destPVP.w, destPVP.h);
+
+    if (!_zoomedImage)
+        _zoomedImage = new Image;
+    Image* zoomed = _zoomedImage.get();
+
+    // The resampling below writes every destination pixel, so the scratch
+    // buffers are only (re-)allocated and cleared when their layout changes
+    const Frame::Buffer buffers[] = {Frame::Buffer::color,
+                                     Frame::Buffer::depth};
+    bool reuse[] = {false, false};
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const Frame::Buffer buffer = buffers[i];
+        if (!image->hasPixelData(buffer) || !zoomed->hasPixelData(buffer))
+            continue;
+
+        const PixelData& current = zoomed->getPixelData(buffer);
+        reuse[i] = current.pvp == zoomedPVP &&
+                   current.internalFormat ==
+                       image->getInternalFormat(buffer) &&
+                   current.externalFormat ==
+                       image->getExternalFormat(buffer) &&
+                   current.pixelSize == image->getPixelSize(buffer);
+    }
+    zoomed->setPixelViewport(zoomedPVP);
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const Frame::Buffer buffer = buffers[i];
+        if (!image->hasPixelData(buffer))
+            continue;
+
+        PixelData pixels;
+        pixels.internalFormat = image->getInternalFormat(buffer);
+        pixels.externalFormat = image->getExternalFormat(buffer);
+        pixels.pixelSize = image->getPixelSize(buffer);
+        pixels.pvp = zoomedPVP;
+        if (reuse[i])
+            zoomed->validatePixelData(buffer);
+        else
+            zoomed->setPixelData(buffer, pixels);
+
+        const uint8_t* src = image->getPixelPointer(buffer);
+        uint8_t* dst = zoomed->getPixelPointer(buffer);
+
+        // Depth values and 10 bit colors are not interpolated
+        const bool filter = buffer == Frame::Buffer::color &&
+                            op.zoomFilter == FILTER_LINEAR &&
+                            (pixels.externalFormat ==
+                                 EQ_COMPRESSOR_DATATYPE_RGBA ||
+                             pixels.externalFormat ==
+                                 EQ_COMPRESSOR_DATATYPE_BGRA);
+        if (!filter)
+            _zoomNearest(src, pvp, dst, zoomedPVP, pixels.pixelSize);
+        else if (op.zoom.x() >= 1.f && op.zoom.y() >= 1.f)
+            _zoomBilinear(src, pvp, dst, zoomedPVP);
+        else
+            _zoomBox(src, pvp, dst, zoomedPVP);
+    }
+    return zoomed;
+}
+
 void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
                   void* depthBuffer, const PixelViewport& destPVP)
 {
@@ -411,17 +669,53 @@ void _mergeImages(const ImageOps& ops, const bool blend, void* colorBuffer,
         if (!op.image->hasPixelData(Frame::Buffer::color))
             continue;
 
-        if (op.image->hasPixelData(Frame::Buffer::depth))
-            _mergeDBImage(colorBuffer, depthBuffer, destPVP, op.image,
-                          op.offset);
-        else if (blend && op.image->hasAlpha())
-            _blendImage(colorBuffer, destPVP, op.image, op.offset);
+        const Image* image = _zoomImage(op);
+        if (image->hasPixelData(Frame::Buffer::depth))
+            _mergeDBImage(colorBuffer, depthBuffer, destPVP, image, op.offset);
+        else if (blend && image->hasAlpha())
+            _blendImage(colorBuffer, destPVP, image, op.offset);
         else
-            _merge2DImage(colorBuffer, depthBuffer, destPVP, op.image,
-                          op.offset);
+            _merge2DImage(colorBuffer, depthBuffer, destPVP, image, op.offset);
     }
 }
 
+/**
+ * Merge each subpixel step separately and average the results into the color
+ * buffer of the given image, replacing the accumulation buffer passes.
+ */
+void _mergeSubPixelImages(const ImageOps& ops, const bool blend,
+                          Image& result, const bool withDepth)
+{
+    const PixelViewport& destPVP = result.getPixelViewport();
+    const size_t size = result.getPixelDataSize(Frame::Buffer::color);
+    std::vector<uint32_t> sums(size, 0);
+    std::vector<uint32_t> depth(withDepth ? destPVP.getArea() : 0);
+    uint8_t* color = result.getPixelPointer(Frame::Buffer::color);
+    uint32_t nSteps = 0;
+
+    ImageOps opsLeft = ops;
+    while (!opsLeft.empty())
+    {
+        const ImageOps current = Compositor::extractOneSubPixel(opsLeft);
+        if (nSteps > 0)
+            result.clearPixelData(Frame::Buffer::color);
+        if (withDepth)
+            std::fill(depth.begin(), depth.end(), 0xFFFFFFFFu);
+
+        _mergeImages(current, blend, color, withDepth ? depth.data() : 0,
+                     destPVP);
+        ++nSteps;
+
+#pragma omp parallel for
+        for (ssize_t i = 0; i < ssize_t(size); ++i)
+            sums[i] += color[i];
+    }
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < ssize_t(size); ++i)
+        color[i] = uint8_t((sums[i] + nSteps / 2) / nSteps);
+}
+
 Vector4f _getCoords(const ImageOp& op, const PixelViewport& pvp)
 {
     const Pixel& pixel = op.image->getContext().pixel;
@@ -689,8 +983,13 @@ uint32_t Compositor::assembleFrames(const Frames& frames, Channel* channel,
     if (frames.empty())
         return 0;
 
-    if (_useCPUAssembly(frames, channel))
+    // With an accumulation buffer the subpixel steps are accumulated there,
+    // otherwise they are averaged during CPU assembly
+    if ((!accum || !isSubPixelDecomposition(frames)) &&
+        _useCPUAssembly(frames, channel))
+    {
         return assembleFramesCPU(frames, channel);
+    }
 
     // else
     return assembleFramesUnsorted(frames, channel, accum);
@@ -702,7 +1001,11 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
     if (ops.empty())
         return 0;
 
-    if (isSubPixelDecomposition(ops))
+    const bool subPixel = isSubPixelDecomposition(ops);
+    if ((!accum || !subPixel) && _useCPUAssembly(ops, true))
+        return assembleImagesCPU(ops, channel, true);
+
+    if (subPixel)
     {
         const bool coreProfile =
             channel->getWindow()->getIAttribute(
@@ -741,13 +1044,9 @@ uint32_t Compositor::blendImages(const ImageOps& ops, Channel* channel,
         return count;
     }
 
-    uint32_t count = 1;
-    if (_useCPUAssembly(ops, true))
-        count = assembleImagesCPU(ops, channel, true);
-    else
-        for (const ImageOp& op : ops)
-            assembleImage(op, channel);
-    return count;
+    for (const ImageOp& op : ops)
+        assembleImage(op, channel);
+    return 1;
 }
 
 uint32_t Compositor::blendFrames(const Frames& frames, Channel* channel,
@@ -1008,8 +1307,9 @@ uint32_t Compositor::assembleFramesCPU(const Frames& frames, Channel* channel,
     if (frames.empty())
         return 0;
 
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // Assembles images from DB, 2D, pixel, subpixel and zoomed compounds
+    // using the CPU and then assembles the result image. Does not support Eye
+    // compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result =
@@ -1023,8 +1323,9 @@ uint32_t Compositor::assembleImagesCPU(const ImageOps& images, Channel* channel,
     if (images.empty())
         return 0;
 
-    // Assembles images from DB and 2D compounds using the CPU and then
-    // assembles the result image. Does not support Pixel or Eye compounds.
+    // Assembles images from DB, 2D, pixel, subpixel and zoomed compounds
+    // using the CPU and then assembles the result image. Does not support Eye
+    // compounds.
     LBVERB << "Sorted CPU assembly" << std::endl;
 
     const Image* result = mergeImagesCPU(images, blend);
@@ -1084,6 +1385,12 @@ const Image* Compositor::mergeImagesCPU(const ImageOps& ops, const bool blend)
     colorPixels.pvp = destPVP;
     result->setPixelData(Frame::Buffer::color, colorPixels);
 
+    if (isSubPixelDecomposition(ops))
+    {
+        _mergeSubPixelImages(ops, blend, *result, depthInt != 0);
+        return result;
+    }
+
     void* destDepth = 0;
     if (depthInt != 0) // at least one depth assembly
     {
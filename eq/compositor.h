@@ -99,6 +99,10 @@ public:
      * composited into the current framebuffer, using preset OpenGL blending
      * state.
      *
+     * Images of pixel decompositions are de-interleaved, zoomed images are
+     * resampled using the frame's zoom filter and subpixel steps are averaged
+     * into the intermediate image.
+     *
      * @param frames the frames to assemble.
      * @param channel the destination channel.
      * @param blend blend color-only images if they have an alpha
@@ -66,6 +66,8 @@ class Data
 }
 #endif
 
+#include "detail/benchmark.h"
+#include "detail/offlineRenderer.h"
 #include "exitVisitor.h"
 #include "frameVisitor.h"
 #include "initVisitor.h"
@@ -125,6 +127,7 @@ public:
         , unlockedFrame(0)
         , finishedFrame(0)
         , running(false)
+        , drainUpdate(true)
     {
         lunchbox::Log::setClock(&clock);
     }
@@ -173,6 +176,15 @@ public:
     /** true while the config is initialized and no window has exited. */
     bool running;
 
+    /** true if the current update() has to finish all outstanding frames. */
+    bool drainUpdate;
+
+    /** The benchmark run requested by --eq-benchmark. */
+    std::unique_ptr<Benchmark> benchmark;
+
+    /** The offline rendering requested by --eq-offline. */
+    std::unique_ptr<OfflineRenderer> offline;
+
     /** Errors from last call to update() */
     Errors errors;
 };
@@ -228,6 +240,12 @@ void Config::attach(const uint128_t& id, const uint32_t instanceID)
                     ConfigFunc(this, &Config::_cmdSyncClock), 0);
     registerCommand(fabric::CMD_CONFIG_SWAP_OBJECT,
                     ConfigFunc(this, &Config::_cmdSwapObject), 0);
+
+    co::CommandQueue* commandQ = getCommandThreadQueue();
+    registerCommand(fabric::CMD_CONFIG_FRAMEDATA_TRANSMIT,
+                    ConfigFunc(this, &Config::_cmdFrameDataTransmit), commandQ);
+    registerCommand(fabric::CMD_CONFIG_FRAMEDATA_READY,
+                    ConfigFunc(this, &Config::_cmdFrameDataReady), commandQ);
 }
 
 void Config::notifyAttached()
@@ -323,6 +341,29 @@ bool Config::init(const uint128_t& initID)
     _impl->running = request.wait();
     localNode->enableSendOnRegister();
 
+    if (_impl->running && !client->getBenchmarkPath().empty())
+    {
+        _impl->benchmark.reset(
+            new detail::Benchmark(client->getBenchmarkPath(),
+                                  client->getBenchmarkFrames(),
+                                  client->getBenchmarkOutput()));
+        if (!_impl->benchmark->isValid())
+            _impl->benchmark.reset();
+        else if (client->getBenchmarkFreeze())
+            _impl->benchmark->freeze(*this);
+    }
+
+    if (_impl->running && !client->getOfflinePrefix().empty())
+    {
+        if (_impl->benchmark)
+            _impl->offline.reset(
+                new detail::OfflineRenderer(*this, client->getOfflinePrefix(),
+                                            client->getOfflineLatency()));
+        else
+            LBWARN << "Offline rendering needs a camera path, use "
+                   << "--eq-benchmark" << std::endl;
+    }
+
     handleEvents();
     if (_impl->running)
         return true;
@@ -339,6 +380,13 @@ bool Config::exit()
 {
     update();
     finishAllFrames();
+    _impl->offline.reset();
+
+    if (_impl->benchmark)
+    {
+        _impl->benchmark->write();
+        _impl->benchmark.reset();
+    }
 
     co::LocalNodePtr localNode = getLocalNode();
     localNode->disableSendOnRegister();
@@ -389,9 +437,13 @@ bool Config::update()
         return true;
     }
 
+    // Runtime reconfiguration, the other nodes keep rendering unless the
+    // application node has to be idle as well.
+    ConfigStatistics stat(Statistic::CONFIG_UPDATE, this);
     client->disableSendOnRegister();
-    while (_impl->finishedFrame < _impl->currentFrame)
-        client->processCommand();
+    if (_impl->drainUpdate)
+        while (_impl->finishedFrame < _impl->currentFrame)
+            client->processCommand();
 
     sync(version);
     client->ackRequest(getServer(), finishID);
@@ -414,6 +466,8 @@ uint32_t Config::startFrame(const uint128_t& frameID)
     ConfigStatistics stat(Statistic::CONFIG_START_FRAME, this);
     detail::FrameVisitor visitor(_impl->currentFrame + 1);
     accept(visitor);
+    if (_impl->benchmark)
+        _impl->benchmark->applyFrame(*this, _impl->currentFrame + 1);
     update();
 
     // New frame
@@ -493,6 +547,13 @@ uint32_t Config::finishFrame()
     _updateStatistics();
     _releaseObjects();
 
+    if (_impl->benchmark)
+    {
+        _impl->benchmark->finishFrame(frameToFinish, getTime());
+        if (_impl->benchmark->isDone())
+            stopRunning();
+    }
+
     LBLOG(LOG_TASKS) << "---- Finished Frame --- " << frameToFinish << " ("
                      << _impl->currentFrame << ')' << std::endl;
     return frameToFinish;
@@ -799,8 +860,11 @@ void Config::handleEvents()
 #endif
 }
 
-void Config::addStatistic(const Statistic& stat LB_UNUSED)
+void Config::addStatistic(const Statistic& stat)
 {
+    if (_impl->benchmark)
+        _impl->benchmark->addStatistic(stat);
+
 #ifdef EQUALIZER_USE_GLSTATS
     const uint32_t frame = stat.frameNumber;
     LBASSERT(stat.type != Statistic::NONE);
@@ -836,6 +900,8 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
         item.thread = THREAD_ASYNC2;
     // no break;
     case Statistic::CHANNEL_FRAME_WAIT_READY:
+    case Statistic::CHANNEL_MOTION_TO_DISPLAY:
+    case Statistic::CHANNEL_FRAME_TILES:
         type.group = "channel";
         item.layer = 1;
         break;
@@ -845,6 +911,7 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
     case Statistic::CHANNEL_ASSEMBLE:
     case Statistic::CHANNEL_READBACK:
     case Statistic::CHANNEL_VIEW_FINISH:
+    case Statistic::CHANNEL_REPROJECT:
         type.group = "channel";
         break;
     case Statistic::CHANNEL_ASYNC_READBACK:
@@ -859,16 +926,28 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
         break;
 
     case Statistic::WINDOW_FINISH:
+    case Statistic::WINDOW_FRAME_PACING:
     case Statistic::WINDOW_THROTTLE_FRAMERATE:
     case Statistic::WINDOW_SWAP_BARRIER:
     case Statistic::WINDOW_SWAP:
         type.group = "window";
         break;
+    case Statistic::PIPE_REMOTE_READBACK:
+        type.group = "pipe";
+        item.layer = 1;
+        break;
     case Statistic::NODE_FRAME_DECOMPRESS:
+        type.group = "node";
+        item.layer = stat.task; // one layer per decompression thread
+        break;
+    case Statistic::NODE_LAUNCH:
+    case Statistic::NODE_CONNECT:
+    case Statistic::NODE_INIT:
         type.group = "node";
         break;
 
     case Statistic::CONFIG_WAIT_FINISH_FRAME:
+    case Statistic::CONFIG_UPDATE:
         item.layer = 1;
     // no break;
     case Statistic::CONFIG_START_FRAME:
@@ -903,6 +982,7 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
     // no break;
 
     case Statistic::WINDOW_FPS:
+    case Statistic::CHANNEL_RESULT_CACHE: // no duration, benchmark output only
     case Statistic::NONE:
     case Statistic::ALL:
         return;
@@ -926,6 +1006,34 @@ void Config::addStatistic(const Statistic& stat LB_UNUSED)
         item.text = text.str();
         break;
     }
+    case Statistic::PIPE_REMOTE_READBACK:
+    {
+        // channel tasks until the remote readback, traversal -> scheduled
+        std::stringstream text;
+        text << stat.totalTime << "->" << stat.idleTime << " tasks";
+        item.text = text.str();
+        break;
+    }
+    case Statistic::WINDOW_FRAME_PACING:
+    case Statistic::CHANNEL_MOTION_TO_DISPLAY:
+    case Statistic::CHANNEL_FRAME_TILES:
+    {
+        // last actual vs. predicted draw time, warped vs. rendered head age,
+        // per-tile overhead vs. tile loop time
+        std::stringstream text;
+        text << unsigned(100.f * stat.ratio) << '%';
+        item.text = text.str();
+        break;
+    }
+    case Statistic::CHANNEL_FRAME_TRANSMIT:
+        // ratio of bytes sent to bytes needed without multicast
+        if (stat.ratio < 1.f)
+        {
+            std::stringstream text;
+            text << unsigned(100.f * stat.ratio) << '%';
+            item.text = text.str();
+        }
+        break;
     default:
         break;
     }
@@ -1000,6 +1108,17 @@ bool Config::isRunning() const
     return _impl->running;
 }
 
+bool Config::isBenchmarking() const
+{
+    return _impl->benchmark.get() != nullptr;
+}
+
+Matrix4f Config::getBenchmarkModelMatrix() const
+{
+    return _impl->benchmark ? _impl->benchmark->getModelMatrix()
+                            : Matrix4f();
+}
+
 void Config::stopRunning()
 {
     _impl->running = false;
@@ -1239,6 +1358,7 @@ bool Config::_cmdUpdateVersion(co::ICommand& cmd)
     const uint32_t versionID = command.read<uint32_t>();
     const uint32_t finishID = command.read<uint32_t>();
     const uint32_t requestID = command.read<uint32_t>();
+    _impl->drainUpdate = command.read<bool>();
 
     getClient()->serveRequest(versionID, version);
     getClient()->serveRequest(finishID, requestID);
@@ -1319,6 +1439,40 @@ bool Config::_cmdSwapObject(co::ICommand& cmd)
     getLocalNode()->serveRequest(requestID);
     return true;
 }
+
+Node* Config::_findMulticastReceiver(co::ObjectICommand& command)
+{
+    // Multicast frame data commands reach all processes of the multicast
+    // group, only the listed receivers process them
+    const std::vector<uint128_t>& receivers =
+        command.read<std::vector<uint128_t> >();
+    const Nodes& nodes = getNodes();
+    for (Node* node : nodes)
+        if (std::find(receivers.begin(), receivers.end(), node->getID()) !=
+            receivers.end())
+        {
+            return node;
+        }
+    return 0;
+}
+
+bool Config::_cmdFrameDataTransmit(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    Node* node = _findMulticastReceiver(command);
+    if (node)
+        node->_addFrameDataImage(command);
+    return true;
+}
+
+bool Config::_cmdFrameDataReady(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+    Node* node = _findMulticastReceiver(command);
+    if (node)
+        node->_setFrameDataReady(command);
+    return true;
+}
 }
 
 #include <eq/fabric/config.ipp>
@@ -106,6 +106,19 @@ public:
     /** Stop the config. @version 1.0 */
     EQ_API void stopRunning();
 
+    /**
+     * @return true if a benchmark was requested with --eq-benchmark.
+     *
+     * During a benchmark, the head matrix of all observers follows the given
+     * camera path, and the config stops running after the requested number of
+     * frames. Applications should disable their own animations.
+     * @version 2.1
+     */
+    EQ_API bool isBenchmarking() const;
+
+    /** @return the model matrix of the benchmark camera path. @version 2.1 */
+    EQ_API Matrix4f getBenchmarkModelMatrix() const;
+
     /**
      * Get the current time in milliseconds.
      *
@@ -457,6 +470,9 @@ private:
     /** Exit the current message pump */
     void _exitMessagePump();
 
+    /** @return the local receiver node of a multicast frame data command. */
+    Node* _findMulticastReceiver(co::ObjectICommand& command);
+
     /** The command functions. */
     bool _cmdSyncClock(co::ICommand& command);
     bool _cmdCreateNode(co::ICommand& command);
@@ -468,6 +484,8 @@ private:
     bool _cmdReleaseFrameLocal(co::ICommand& command);
     bool _cmdFrameFinish(co::ICommand& command);
     bool _cmdSwapObject(co::ICommand& command);
+    bool _cmdFrameDataTransmit(co::ICommand& command);
+    bool _cmdFrameDataReady(co::ICommand& command);
 };
 }
 
@@ -0,0 +1,252 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "benchmark.h"
+
+#include "../config.h"
+#include "../configVisitor.h"
+#include "../observer.h"
+#include "../view.h"
+
+#include <eq/fabric/equalizer.h>
+#include <lunchbox/log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+class FreezeVisitor : public ConfigVisitor
+{
+public:
+    VisitorResult visit(View* view) override
+    {
+        view->getEqualizer().setFrozen(true);
+        return TRAVERSE_CONTINUE;
+    }
+};
+
+bool _endsWith(const std::string& string, const std::string& suffix)
+{
+    return string.size() >= suffix.size() &&
+           string.compare(string.size() - suffix.size(), suffix.size(),
+                          suffix) == 0;
+}
+}
+
+Benchmark::Benchmark(const std::string& path, const uint32_t frames,
+                     const std::string& output)
+    : _frames(frames)
+    , _output(output)
+    , _finished(0)
+    , _lastTime(0)
+{
+    if (!_load(path))
+        return;
+
+    if (_frames == 0)
+        _frames = _steps.back().frame;
+    _frameTimes.reserve(_frames);
+    LBINFO << "Benchmarking " << _frames << " frames on camera path " << path
+           << std::endl;
+}
+
+bool Benchmark::_load(const std::string& path)
+{
+    std::ifstream file(path.c_str());
+    if (!file)
+    {
+        LBWARN << "Can't open benchmark camera path " << path << std::endl;
+        return false;
+    }
+
+    const float toRadians = float(M_PI) / 180.f;
+    Vector3f modelRotation;
+    file >> modelRotation.x() >> modelRotation.y() >> modelRotation.z();
+    modelRotation *= toRadians;
+    _modelMatrix = Matrix4f();
+    _modelMatrix.rotate_x(modelRotation.x());
+    _modelMatrix.rotate_y(modelRotation.y());
+    _modelMatrix.rotate_z(modelRotation.z());
+
+    uint32_t frame = 0;
+    float v[7];
+    while (file >> v[0] >> v[1] >> v[2] >> v[3] >> v[4] >> v[5] >> v[6])
+    {
+        frame += std::max(uint32_t(v[0]), 1u);
+        const Step step = {frame, Vector3f(v[1], v[2], v[3]),
+                           Vector3f(-v[5], v[4], v[6]) * toRadians};
+        _steps.push_back(step);
+    }
+
+    if (_steps.empty())
+        LBWARN << "No steps in benchmark camera path " << path << std::endl;
+    return !_steps.empty();
+}
+
+void Benchmark::freeze(eq::Config& config) const
+{
+    FreezeVisitor visitor;
+    config.accept(visitor);
+}
+
+void Benchmark::applyFrame(eq::Config& config, const uint32_t frame) const
+{
+    const Matrix4f& head = _getHeadMatrix(frame);
+    for (Observer* observer : config.getObservers())
+        observer->setHeadMatrix(head);
+}
+
+Matrix4f Benchmark::_getHeadMatrix(const uint32_t frame) const
+{
+    // Interpolate by frame number, not by time, for reproducible images
+    const uint32_t pathFrame = (frame - 1) % _steps.back().frame + 1;
+    size_t i = 0;
+    while (i + 1 < _steps.size() && _steps[i + 1].frame <= pathFrame)
+        ++i;
+
+    Vector3f position = _steps[i].position;
+    Vector3f rotation = _steps[i].rotation;
+    if (i + 1 < _steps.size() && pathFrame > _steps[i].frame)
+    {
+        const Step& next = _steps[i + 1];
+        const float t = float(pathFrame - _steps[i].frame) /
+                        float(next.frame - _steps[i].frame);
+        position = position * (1.f - t) + next.position * t;
+        rotation = rotation * (1.f - t) + next.rotation * t;
+    }
+
+    Matrix4f view;
+    view.rotate_x(rotation.x());
+    view.rotate_y(rotation.y());
+    view.rotate_z(rotation.z());
+    Matrix4f translation;
+    translation.setTranslation(position);
+    view = view * translation;
+
+    // The head matrix places the observer, the inverse of the view transform
+    return view.inverse();
+}
+
+void Benchmark::finishFrame(const uint32_t frame, const int64_t time)
+{
+    if (frame <= _finished)
+        return;
+
+    if (_finished > 0)
+        _frameTimes.push_back(std::make_pair(
+            frame, float(time - _lastTime) / float(frame - _finished)));
+    _finished = frame;
+    _lastTime = time;
+}
+
+void Benchmark::addStatistic(const Statistic& stat)
+{
+    // render client startup happens before the first frame
+    const bool startup = stat.type == Statistic::NODE_LAUNCH ||
+                         stat.type == Statistic::NODE_CONNECT ||
+                         stat.type == Statistic::NODE_INIT;
+    if ((stat.frameNumber == 0 && !startup) || stat.frameNumber > _frames ||
+        stat.type == Statistic::NONE || stat.type >= Statistic::ALL)
+    {
+        return;
+    }
+
+    const int64_t time = stat.endTime - stat.startTime;
+    Sample& sample = _samples[stat.type];
+    ++sample.count;
+    sample.total += time;
+    sample.min = std::min(sample.min, time);
+    sample.max = std::max(sample.max, time);
+    sample.ratio += stat.ratio;
+}
+
+bool Benchmark::write() const
+{
+    std::ofstream file(_output.c_str());
+    if (!file)
+    {
+        LBWARN << "Can't write benchmark results to " << _output << std::endl;
+        return false;
+    }
+
+    if (_endsWith(_output, ".json"))
+        _writeJSON(file);
+    else
+        _writeCSV(file);
+
+    LBINFO << "Wrote results of " << _frameTimes.size()
+           << " benchmark frames to " << _output << std::endl;
+    return file.good();
+}
+
+void Benchmark::_writeCSV(std::ostream& os) const
+{
+    os << "frame,time_ms" << std::endl;
+    for (const FrameTime& frameTime : _frameTimes)
+        os << frameTime.first << "," << frameTime.second << std::endl;
+
+    os << std::endl << "statistic,count,total_ms,mean_ms,min_ms,max_ms,mean_ratio"
+       << std::endl;
+    for (size_t i = 0; i < Statistic::ALL; ++i)
+    {
+        const Sample& sample = _samples[i];
+        if (sample.count == 0)
+            continue;
+
+        os << Statistic::getName(Statistic::Type(i)) << "," << sample.count
+           << "," << sample.total << ","
+           << float(sample.total) / float(sample.count) << "," << sample.min
+           << "," << sample.max << ","
+           << sample.ratio / double(sample.count) << std::endl;
+    }
+}
+
+void Benchmark::_writeJSON(std::ostream& os) const
+{
+    os << "{" << std::endl << "  \"frames\": [";
+    for (size_t i = 0; i < _frameTimes.size(); ++i)
+        os << (i == 0 ? "" : ",") << std::endl
+           << "    { \"frame\": " << _frameTimes[i].first
+           << ", \"time_ms\": " << _frameTimes[i].second << " }";
+
+    os << std::endl << "  ]," << std::endl << "  \"statistics\": {";
+    bool first = true;
+    for (size_t i = 0; i < Statistic::ALL; ++i)
+    {
+        const Sample& sample = _samples[i];
+        if (sample.count == 0)
+            continue;
+
+        os << (first ? "" : ",") << std::endl
+           << "    \"" << Statistic::getName(Statistic::Type(i))
+           << "\": { \"count\": " << sample.count
+           << ", \"total_ms\": " << sample.total
+           << ", \"mean_ms\": " << float(sample.total) / float(sample.count)
+           << ", \"min_ms\": " << sample.min << ", \"max_ms\": " << sample.max
+           << ", \"mean_ratio\": " << sample.ratio / double(sample.count)
+           << " }";
+        first = false;
+    }
+    os << std::endl << "  }" << std::endl << "}" << std::endl;
+}
+}
+}
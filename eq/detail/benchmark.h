@@ -0,0 +1,114 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_BENCHMARK_H
+#define EQ_DETAIL_BENCHMARK_H
+
+#include <eq/fabric/statistic.h> // member
+#include <eq/fabric/vmmlib.h>     // member
+#include <eq/types.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Deterministic benchmark run of an application, enabled by --eq-benchmark.
+ *
+ * Replays a camera path on all observers of the configuration for a fixed
+ * number of frames, independent of the achieved frame rate. The path uses the
+ * format of the eqPly camera animations: the model rotation in degrees,
+ * followed by 'frames x y z heading pitch roll' steps. At exit, the per-frame
+ * time and the aggregated statistics are written as CSV, or as JSON if the
+ * output file name ends with '.json'.
+ */
+class Benchmark
+{
+public:
+    Benchmark(const std::string& path, uint32_t frames,
+              const std::string& output);
+
+    /** @return true if the camera path was loaded. */
+    bool isValid() const { return !_steps.empty(); }
+    /** Freeze the load balancers of all views to their initial state. */
+    void freeze(eq::Config& config) const;
+
+    /** Set the head matrix of all observers for the given frame. */
+    void applyFrame(eq::Config& config, uint32_t frame) const;
+
+    /** @return the model matrix given by the camera path. */
+    const Matrix4f& getModelMatrix() const { return _modelMatrix; }
+    /** Record the completion of the given frame. */
+    void finishFrame(uint32_t frame, int64_t time);
+
+    /** Accumulate the given statistics event. */
+    void addStatistic(const Statistic& stat);
+
+    /** @return true once all frames of the benchmark are finished. */
+    bool isDone() const { return _finished >= _frames; }
+    /** Write the results to the output file. */
+    bool write() const;
+
+private:
+    struct Step
+    {
+        uint32_t frame;
+        Vector3f position;
+        Vector3f rotation;
+    };
+
+    struct Sample
+    {
+        Sample()
+            : count(0)
+            , total(0)
+            , min(std::numeric_limits<int64_t>::max())
+            , max(0)
+            , ratio(0.)
+        {
+        }
+
+        uint32_t count;
+        int64_t total;
+        int64_t min;
+        int64_t max;
+        double ratio; //!< sum of Statistic::ratio
+    };
+
+    std::vector<Step> _steps;
+    Matrix4f _modelMatrix;
+    uint32_t _frames;
+    const std::string _output;
+
+    uint32_t _finished;
+    int64_t _lastTime;
+    typedef std::pair<uint32_t, float> FrameTime; //!< frame, time in ms
+    std::vector<FrameTime> _frameTimes;
+    Sample _samples[Statistic::ALL];
+
+    bool _load(const std::string& path);
+    Matrix4f _getHeadMatrix(uint32_t frame) const;
+    void _writeCSV(std::ostream& os) const;
+    void _writeJSON(std::ostream& os) const;
+};
+}
+}
+
+#endif // EQ_DETAIL_BENCHMARK_H
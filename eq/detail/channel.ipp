@@ -21,6 +21,8 @@
 #include "../image.h"
 #include "../resultImageListener.h"
 #include "fileFrameWriter.h"
+#include "gpuTimer.h"
+#include "reprojector.h"
 
 #ifdef EQUALIZER_USE_DEFLECT
 #include "../deflect/proxy.h"
@@ -43,6 +45,7 @@ class Channel
 public:
     Channel()
         : state(STATE_STOPPED)
+        , latency(0)
 #ifdef EQUALIZER_USE_DEFLECT
         , _deflectProxy(0)
 #endif
@@ -161,6 +164,8 @@ public:
         eq::Viewport region; //!< from draw for equalizers
         /** reference count by pipe and transmit thread */
         lunchbox::a_int32_t used;
+        /** uncollected GPU timings, also counted in used */
+        lunchbox::a_int32_t gpuTimings;
     };
 
     typedef std::vector<FrameStatistics> StatisticsRB;
@@ -169,6 +174,16 @@ public:
     /** Global statistics events, index per frame and channel. */
     lunchbox::Lockable<StatisticsRB, lunchbox::SpinLock> statistics;
 
+    /** The latency of the statistics ring, applied once no GPU timings are
+     * pending. */
+    uint32_t latency;
+
+    /** Asynchronous GPU timing of NICEST statistics. */
+    GPUTimer gpuTimer;
+
+    /** Late reprojection of destination views, see IATTR_HINT_REPROJECTION */
+    Reprojector reprojector;
+
     /** The initial channel size, used for view resize events. */
     Vector2i initialSize;
 
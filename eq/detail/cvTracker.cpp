@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2013-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2013-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -20,9 +20,13 @@
 #include "../config.h"
 #include "../observer.h"
 
-#include <eq/fabric/event.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/sleep.h>
 #include <vmmlib/lowpassFilter.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 #define FACE_CONFIG                    \
     std::string(OPENCV_INSTALL_PATH) + \
         "/share/OpenCV/haarcascades/haarcascade_frontalface_alt.xml"
@@ -36,13 +40,63 @@ namespace eq
 {
 namespace detail
 {
+namespace
+{
+/** Resolution of the face detection relative to the captured frame. */
+const double DETECT_SCALE = .5;
+
+/** Search the full frame at least every n frames to catch other faces. */
+const uint32_t FULL_SEARCH_INTERVAL = 15;
+
+/** Gain of the constant velocity filter for position and velocity. */
+const float POSITION_GAIN = .5f;
+const float VELOCITY_GAIN = .1f;
+
+/** Restart the filter after losing the face for longer, in ms. */
+const int64_t MAX_GAP = 500;
+
+/** Maximum extrapolation of the head position, in ms. */
+const int64_t MAX_PREDICTION = 100;
+}
+
+/** Grabs frames independent of the detection rate. */
+class CVTracker::Grabber : public lunchbox::Thread
+{
+public:
+    explicit Grabber(CVTracker& tracker)
+        : tracker_(tracker)
+    {
+    }
+
+protected:
+    void run() final { tracker_._grab(); }
+private:
+    CVTracker& tracker_;
+};
+
 CVTracker::CVTracker(eq::Observer* observer, const uint32_t camera)
     : observer_(observer)
     , camera_(camera)
-    , capture_(cvCaptureFromCAM(camera_))
+    , isVideo_(false)
+    , grabber_(new Grabber(*this))
     , running_(false)
+    , frameTime_(0)
+    , frames_(0)
+    , roll_(0.f)
+    , stateTime_(0)
+    , hasState_(false)
 {
-    if (!capture_)
+    const char* video = getenv("EQ_TRACKER_VIDEO");
+    if (video)
+    {
+        isVideo_ = capture_.open(video);
+        if (!isVideo_)
+        {
+            LBWARN << "Can't open tracker video " << video << std::endl;
+            return;
+        }
+    }
+    else if (!capture_.open(camera_))
     {
         LBWARN << "Did not find OpenCV camera " << camera_ << std::endl;
         return;
@@ -57,8 +111,7 @@ CVTracker::CVTracker(eq::Observer* observer, const uint32_t camera)
             LBWARN << "Cannot set up face detector using " << FACE_CONFIG
                    << " or " << config << std::endl;
 
-            cvReleaseCapture(&capture_);
-            capture_ = 0;
+            capture_.release();
             return;
         }
     }
@@ -72,14 +125,19 @@ CVTracker::CVTracker(eq::Observer* observer, const uint32_t camera)
             LBWARN << "Can't set up eye detector using " << EYE_CONFIG << " or "
                    << config << std::endl;
 
-            cvReleaseCapture(&capture_);
-            capture_ = 0;
+            capture_.release();
             return;
         }
     }
 
-    cvSetCaptureProperty(capture_, CV_CAP_PROP_FRAME_WIDTH, CAPTURE_WIDTH);
-    cvSetCaptureProperty(capture_, CV_CAP_PROP_FRAME_HEIGHT, CAPTURE_HEIGHT);
+    if (isVideo_)
+    {
+        LBINFO << "Activated tracking video " << video << std::endl;
+        return;
+    }
+
+    capture_.set(CV_CAP_PROP_FRAME_WIDTH, CAPTURE_WIDTH);
+    capture_.set(CV_CAP_PROP_FRAME_HEIGHT, CAPTURE_HEIGHT);
     LBINFO << "Activated tracking camera " << camera_ << std::endl;
 }
 
@@ -87,55 +145,177 @@ CVTracker::~CVTracker()
 {
     running_ = false;
     join();
-    cvReleaseCapture(&capture_);
-    capture_ = 0;
+    capture_.release();
+}
+
+bool CVTracker::predict(const int64_t time, Matrix4f& head) const
+{
+    lunchbox::ScopedFastRead mutex(stateLock_);
+    if (!hasState_)
+        return false;
+
+    // the constant velocity assumption only holds for a short time
+    const int64_t delta =
+        std::min(std::max(time - stateTime_, int64_t(0)), MAX_PREDICTION);
+
+    Matrix3f rotation;
+    rotation.array[0] = cosf(roll_);
+    rotation.array[1] = sinf(roll_);
+    rotation.array[4] = -rotation.array[1];
+    rotation.array[5] = rotation.array[0];
+
+    head = Matrix4f();
+    head.setSubMatrix(rotation, 0, 0);
+    head.setTranslation(position_ + velocity_ * float(delta));
+    return true;
+}
+
+void CVTracker::_grab()
+{
+    eq::Config* config = observer_->getConfig();
+    const double fps = isVideo_ ? capture_.get(CV_CAP_PROP_FPS) : 0.;
+    const int64_t interval = fps > 0. ? int64_t(1000. / fps) : 0;
+    int64_t next = config->getTime();
+    bool rewound = false;
+
+    while (running_)
+    {
+        cv::Mat frame;
+        if (!capture_.read(frame) || frame.empty())
+        {
+            // replay recorded video in a loop
+            if (isVideo_ && !rewound && capture_.set(CV_CAP_PROP_POS_FRAMES, 0))
+            {
+                rewound = true;
+                continue;
+            }
+
+            LBWARN << "Failure to grab a video frame, bailing" << std::endl;
+            break;
+        }
+        rewound = false;
+
+        {
+            lunchbox::ScopedWrite mutex(frameLock_);
+            frame_ = frame; // not modified after publishing
+            frameTime_ = config->getTime();
+        }
+        ++frames_;
+
+        if (interval > 0) // recorded video, emulate camera rate
+        {
+            next += interval;
+            const int64_t wait = next - config->getTime();
+            if (wait > 0)
+                lunchbox::sleep(uint32_t(wait));
+        }
+    }
+
+    running_ = false;
+    ++frames_; // wake up tracker thread
+}
+
+void CVTracker::_update(const Vector3f& position, const float roll,
+                        const int64_t time)
+{
+    lunchbox::ScopedFastWrite mutex(stateLock_);
+    roll_ = roll;
+
+    const int64_t delta = time - stateTime_;
+    if (!hasState_ || delta > MAX_GAP)
+    {
+        position_ = position;
+        velocity_ = Vector3f();
+        stateTime_ = time;
+        hasState_ = true;
+        return;
+    }
+    if (delta <= 0)
+        return;
+
+    // alpha-beta filter, the steady state of a constant velocity Kalman filter
+    const Vector3f predicted = position_ + velocity_ * float(delta);
+    const Vector3f residual = position - predicted;
+    position_ = predicted + residual * POSITION_GAIN;
+    velocity_ += residual * (VELOCITY_GAIN / float(delta));
+    stateTime_ = time;
 }
 
 void CVTracker::run()
 {
     running_ = true;
-    eq::Config* config = observer_->getConfig();
-    const uint128_t originator = observer_->getID();
+    if (!grabber_->start())
+    {
+        LBWARN << "Can't start video capture thread" << std::endl;
+        running_ = false;
+        return;
+    }
 
-    vmml::LowpassFilter<5, Vector3f> position(.3f);
     vmml::LowpassFilter<5, float> roll(.3f);
     vmml::LowpassFilter<5, float> headEyeRatio(.3f);
-    Matrix4f head;
 
     headEyeRatio.add(.4f); // initial guesses
+    roll.add(0.f);
     float width = 0.f;
     bool isEyeWidth = false;
 
+    uint32_t frameNumber = 0;
+    uint32_t fullSearch = 0;
+    cv::Rect face; // last detected face, empty if lost
+
     while (running_)
     {
-        const cv::Mat frame = cvQueryFrame(capture_);
-        if (frame.empty())
+        frameNumber = frames_.waitGT(frameNumber);
+        cv::Mat frame;
+        int64_t time;
         {
-            LBWARN << "Failure to grab a video frame, bailing" << std::endl;
-            break;
+            lunchbox::ScopedWrite mutex(frameLock_);
+            frame = frame_;
+            time = frameTime_;
         }
+        if (!running_ || frame.empty())
+            continue;
 
+        // detect at reduced resolution
         cv::Mat bwFrame;
         cvtColor(frame, bwFrame, CV_BGR2GRAY);
+        resize(bwFrame, bwFrame, cv::Size(), DETECT_SCALE, DETECT_SCALE,
+               cv::INTER_AREA);
         equalizeHist(bwFrame, bwFrame);
+        const float frameWidth = float(bwFrame.cols);
+        const float frameHeight = float(bwFrame.rows);
+
+        // search around the last face, and periodically in the full frame
+        const cv::Rect fullFrame(0, 0, bwFrame.cols, bwFrame.rows);
+        cv::Rect window = fullFrame;
+        if (face.area() > 0 && ++fullSearch < FULL_SEARCH_INTERVAL)
+            window = cv::Rect(face.x - face.width / 2, face.y - face.height / 2,
+                              face.width * 2, face.height * 2) &
+                     fullFrame;
+        else
+            fullSearch = 0;
 
-        // detect face
         std::vector<cv::Rect> faces;
-        faceDetector_.detectMultiScale(bwFrame, faces, 1.1f, 2,
+        faceDetector_.detectMultiScale(bwFrame(window), faces, 1.1f, 2,
                                        CV_HAAR_SCALE_IMAGE |
                                            CV_HAAR_FIND_BIGGEST_OBJECT,
-                                       cv::Size(30, 30));
+                                       cv::Size(15, 15));
         if (faces.empty())
+        {
+            face = cv::Rect(); // search full frame next
             continue;
+        }
+
+        face = faces.front();
+        face.x += window.x;
+        face.y += window.y;
 
         // detect eyes
-        const cv::Rect& face = faces.front();
         const cv::Mat faceROI = bwFrame(face);
         std::vector<cv::Rect> eyes;
         eyeDetector_.detectMultiScale(faceROI, eyes, 1.1f, 2,
-                                      CV_HAAR_SCALE_IMAGE, cv::Size(15, 15));
+                                      CV_HAAR_SCALE_IMAGE, cv::Size(8, 8));
         Vector3f center(0.f, 0.f, 0.f);
-        Matrix3f rotation;
 
         if (eyes.size() == 2)
         {
@@ -144,16 +324,11 @@ void CVTracker::run()
             const Vector2f right(face.x + eyes[1].x + eyes[1].width * .5f,
                                  face.y + eyes[1].y + eyes[1].height * .5f);
             center = Vector3f(left + right) * .5f;
-            center.z() = (right - left).length() / float(CAPTURE_WIDTH);
+            center.z() = (right - left).length() / frameWidth;
 
             // low pass smooth filter of roll angle
             roll.add(
                 atanf(fabs(left.y() - right.y()) / fabs(left.x() - right.x())));
-            rotation.array[0] = cosf(*roll);
-            rotation.array[1] = sinf(*roll);
-            rotation.array[4] = -rotation.array[1];
-            rotation.array[5] = rotation.array[0];
-            head.setSubMatrix(rotation, 0, 0);
 
             if (!isEyeWidth && width > 0.f)
             {
@@ -166,7 +341,7 @@ void CVTracker::run()
         {
             center.x() = face.x + face.width * .5f;
             center.y() = face.y + face.height * .33f; // eyes are in upper third
-            center.z() = face.width / float(CAPTURE_WIDTH);
+            center.z() = face.width / frameWidth;
 
             if (isEyeWidth && width > 0.f)
             {
@@ -176,8 +351,8 @@ void CVTracker::run()
             width = center.z();
             center.z() *= *headEyeRatio;
         }
-        center.x() = 2.f * (-center.x() / float(CAPTURE_WIDTH) + .5f);
-        center.y() = 2.f * (-center.y() / float(CAPTURE_HEIGHT) + .5f);
+        center.x() = 2.f * (-center.x() / frameWidth + .5f);
+        center.y() = 2.f * (-center.y() / frameHeight + .5f);
 
         // 20 cm macro distance, 2 m tele, inverted scale
         center.z() *= 4.f;
@@ -186,17 +361,17 @@ void CVTracker::run()
         if (center.z() > 1.f)
             center.z() = 1.f;
         center.z() = .2f + (1.f - center.z()) * 2.f;
-        position.add(center); // low pass smooth filter
 
-        // emit
-        head.setTranslation(position.get());
+        // filter at capture time, the observer predicts for display time
+        _update(center, *roll, time);
 
-        LBVERB << "head " << *position << " roll " << *roll << " eyes "
-               << (eyes.size() == 2) << " h->e " << *headEyeRatio << std::endl;
-        config->sendEvent(EVENT_OBSERVER_MOTION) << originator << head;
+        LBVERB << "head " << center << " roll " << *roll << " eyes "
+               << (eyes.size() == 2) << " h->e " << *headEyeRatio << " window "
+               << (window == fullFrame ? "full" : "local") << std::endl;
     }
 
     running_ = false;
+    grabber_->join();
 }
 }
 }
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2013-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -19,15 +19,28 @@
 #define EQ_CVTRACKER_H
 
 #include <eq/types.h>
+#include <lunchbox/lock.h>     // member
+#include <lunchbox/monitor.h>  // member
+#include <lunchbox/spinLock.h> // member
 #include <opencv2/opencv.hpp>
 
+#include <atomic>
+#include <memory>
+
 namespace eq
 {
 namespace detail
 {
 /**
  * @internal
- * An OpenCV head tracker running in a separate thread for performance.
+ * An OpenCV head tracker running in separate threads for performance.
+ *
+ * A capture thread grabs the camera frames, and the tracker thread detects the
+ * face at reduced resolution in a window around the last detected face, with a
+ * periodic search of the full frame. A constant velocity filter estimates the
+ * head position and velocity, which predict() extrapolates to the display time
+ * of a frame. If EQ_TRACKER_VIDEO names a video file, it is replayed in a loop
+ * at its frame rate instead of using the camera.
  */
 class CVTracker : public lunchbox::Thread
 {
@@ -39,18 +52,47 @@ public:
     virtual ~CVTracker();
 
     /** @return true of the tracker is working. */
-    bool isGood() const { return capture_; }
+    bool isGood() const { return capture_.isOpened(); }
+
+    /**
+     * Predict the head matrix at the given config time.
+     *
+     * @return false if no head was detected yet.
+     */
+    bool predict(int64_t time, Matrix4f& head) const;
+
 protected:
-    virtual void run();
+    void run() override;
 
 private:
+    class Grabber;
+
     eq::Observer* observer_;
     const uint32_t camera_;
-    CvCapture* capture_;
+    cv::VideoCapture capture_;
+    bool isVideo_;
     cv::CascadeClassifier faceDetector_;
     cv::CascadeClassifier eyeDetector_;
+    std::unique_ptr<Grabber> grabber_;
+
+    std::atomic<bool> running_;
+
+    /** The newest captured frame and its time, written by the grabber. */
+    lunchbox::Lock frameLock_;
+    cv::Mat frame_;
+    int64_t frameTime_;
+    lunchbox::Monitor<uint32_t> frames_;
+
+    /** The filtered head state at stateTime_, read by predict(). */
+    mutable lunchbox::SpinLock stateLock_;
+    Vector3f position_;
+    Vector3f velocity_;
+    float roll_;
+    int64_t stateTime_;
+    bool hasState_;
 
-    bool running_;
+    void _grab();
+    void _update(const Vector3f& position, float roll, int64_t time);
 };
 }
 }
@@ -0,0 +1,145 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "gpuTimer.h"
+
+#include <eq/fabric/statistic.h>
+#include <lunchbox/debug.h>
+#include <lunchbox/log.h>
+
+#define glewGetContext() glewContext
+
+namespace eq
+{
+namespace detail
+{
+const uint32_t GPUTimer::NONE = LB_UNDEFINED_UINT32;
+
+GPUTimer::GPUTimer()
+    : _offset(0)
+    , _calibratedFrame(0)
+{
+}
+
+GPUTimer::~GPUTimer()
+{
+    if (!_timings.empty())
+        LBWARN << _timings.size() << " GPU timer queries not deleted"
+               << std::endl;
+}
+
+bool GPUTimer::isSupported(const GLEWContext* glewContext)
+{
+    return glewContext && (GLEW_VERSION_3_3 || GLEW_ARB_timer_query);
+}
+
+uint32_t GPUTimer::start(const GLEWContext* glewContext, const uint32_t frame,
+                         const int64_t time)
+{
+    if (frame != _calibratedFrame)
+    {
+        // GL_TIMESTAMP returns the current GPU time without a pipeline flush
+        GLint64 gpuTime = 0;
+        glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+        _offset = time * 1000000 - gpuTime;
+        _calibratedFrame = frame;
+    }
+
+    uint32_t slot;
+    if (_free.empty())
+    {
+        Timing timing;
+        glGenQueries(2, timing.queries);
+        slot = uint32_t(_timings.size());
+        _timings.push_back(timing);
+    }
+    else
+    {
+        slot = _free.back();
+        _free.pop_back();
+    }
+
+    Timing& timing = _timings[slot];
+    timing.offset = _offset;
+    glQueryCounter(timing.queries[0], GL_TIMESTAMP);
+    return slot;
+}
+
+void GPUTimer::stop(const GLEWContext* glewContext, const uint32_t slot,
+                    const Statistic& statistic)
+{
+    LBASSERT(slot < _timings.size());
+    Timing& timing = _timings[slot];
+    glQueryCounter(timing.queries[1], GL_TIMESTAMP);
+    timing.statistic = statistic;
+    _pending.push_back(slot);
+}
+
+void GPUTimer::cancel(const uint32_t slot)
+{
+    LBASSERT(slot < _timings.size());
+    _free.push_back(slot);
+}
+
+Statistics GPUTimer::collect(const GLEWContext* glewContext,
+                             const uint32_t waitFrame)
+{
+    Statistics statistics;
+    while (!_pending.empty())
+    {
+        const uint32_t slot = _pending.front();
+        Timing& timing = _timings[slot];
+        Statistic& statistic = timing.statistic;
+
+        // Queries complete in order, the end query implies the start query
+        if (statistic.frameNumber > waitFrame)
+        {
+            GLint available = GL_FALSE;
+            glGetQueryObjectiv(timing.queries[1], GL_QUERY_RESULT_AVAILABLE,
+                               &available);
+            if (!available)
+                break;
+        }
+
+        GLuint64 start = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(timing.queries[0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(timing.queries[1], GL_QUERY_RESULT, &end);
+
+        statistic.startTime = (int64_t(start) + timing.offset) / 1000000;
+        statistic.endTime = (int64_t(end) + timing.offset) / 1000000;
+        if (statistic.endTime <= statistic.startTime)
+            statistic.endTime = statistic.startTime + 1;
+
+        statistics.push_back(statistic);
+        _pending.pop_front();
+        _free.push_back(slot);
+    }
+    return statistics;
+}
+
+void GPUTimer::exit(const GLEWContext* glewContext)
+{
+    for (Timing& timing : _timings)
+        glDeleteQueries(2, timing.queries);
+
+    _timings.clear();
+    _free.clear();
+    _pending.clear();
+    _calibratedFrame = 0;
+}
+}
+}
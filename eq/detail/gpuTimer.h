@@ -0,0 +1,98 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_GPUTIMER_H
+#define EQ_DETAIL_GPUTIMER_H
+
+#include <eq/gl.h>    // GLuint
+#include <eq/types.h> // Statistics
+
+#include <deque>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Asynchronous GPU timing of channel statistics using timestamp queries.
+ *
+ * A timing issues a timestamp query at the start and the end of the sampled
+ * operation. The statistic is kept until both results are available, which is
+ * typically the case a frame later, so the GPU pipeline is never drained. The
+ * GPU clock is calibrated once per frame against the config clock. All methods
+ * have to be called from the pipe thread with the window context current.
+ */
+class GPUTimer
+{
+public:
+    static const uint32_t NONE; //!< An invalid timing slot
+
+    GPUTimer();
+    ~GPUTimer();
+
+    /** @return true if the given context supports timestamp queries. */
+    static bool isSupported(const GLEWContext* glewContext);
+
+    /**
+     * Start a new timing.
+     *
+     * @param frame the frame of the sampled operation.
+     * @param time the current config time, used for calibration.
+     * @return the slot of the timing.
+     */
+    uint32_t start(const GLEWContext* glewContext, uint32_t frame,
+                   int64_t time);
+
+    /** Finish a timing, the statistic is returned by collect() later. */
+    void stop(const GLEWContext* glewContext, uint32_t slot,
+              const Statistic& statistic);
+
+    /** Release a started timing without using its result. */
+    void cancel(uint32_t slot);
+
+    /** @return true if stopped timings are not yet collected. */
+    bool hasPending() const { return !_pending.empty(); }
+    /**
+     * Collect the statistics of all finished timings in submission order.
+     *
+     * Waits for the results of all timings up to and including the given
+     * frame, and returns available results of later frames without waiting.
+     */
+    Statistics collect(const GLEWContext* glewContext, uint32_t waitFrame);
+
+    /** Delete all queries, dropping pending timings. */
+    void exit(const GLEWContext* glewContext);
+
+private:
+    struct Timing
+    {
+        GLuint queries[2];
+        int64_t offset; //!< config time - GPU time in ns
+        Statistic statistic;
+    };
+
+    std::vector<Timing> _timings;
+    std::vector<uint32_t> _free;
+    std::deque<uint32_t> _pending;
+
+    int64_t _offset;
+    uint32_t _calibratedFrame;
+};
+}
+}
+
+#endif // EQ_DETAIL_GPUTIMER_H
@@ -0,0 +1,153 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "offlineRenderer.h"
+
+#include "../canvas.h"
+#include "../config.h"
+#include "../image.h"
+#include "../layout.h"
+#include "../view.h"
+
+#include <lunchbox/log.h>
+#include <lunchbox/mtQueue.h>
+#include <lunchbox/thread.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace eq
+{
+namespace detail
+{
+/** Writes the captured images outside of the application thread. */
+class OfflineRenderer::Writer : public lunchbox::Thread
+{
+public:
+    struct Item
+    {
+        std::string fileName;
+        std::shared_ptr<const Image> image; //!< nullptr to exit
+    };
+    typedef lunchbox::MTQueue<Item> Queue;
+
+    explicit Writer(const size_t maxSize)
+        : queue(maxSize)
+        , written(0)
+    {
+    }
+    virtual ~Writer() {}
+    Queue queue;
+    size_t written; //!< read after join() only
+
+protected:
+    bool init() override
+    {
+        setName("OfflineWriter");
+        return true;
+    }
+
+    void run() override
+    {
+        while (true)
+        {
+            const Item item = queue.pop();
+            if (!item.image)
+                return;
+
+            if (item.image->writeImage(item.fileName, Frame::Buffer::color))
+                ++written;
+            else
+                LBWARN << "Could not write file " << item.fileName
+                       << std::endl;
+        }
+    }
+};
+
+OfflineRenderer::OfflineRenderer(eq::Config& config, const std::string& prefix,
+                                 const uint32_t latency)
+    : _config(config)
+    , _prefix(prefix)
+    , _latency(std::max(latency, 1u))
+    , _startTime(config.getTime())
+    , _writer(new Writer(_latency))
+    , _throttled(false)
+{
+    if (latency > config.getLatency())
+        config.setLatency(latency);
+
+    for (Canvas* canvas : config.getCanvases())
+    {
+        Layout* layout = canvas->getActiveLayout();
+        if (layout)
+            _views.insert(_views.end(), layout->getViews().begin(),
+                          layout->getViews().end());
+    }
+
+    _writer->start();
+
+    // images arrive during Config::handleEvents() on the application thread
+    for (size_t i = 0; i < _views.size(); ++i)
+        _views[i]->enableScreenshot(Frame::Buffer::color,
+                                    [this, i](const uint32_t frame,
+                                              const Image& image) {
+                                        _add(i, frame, image);
+                                    });
+
+    LBINFO << "Offline rendering of " << _views.size() << " views with "
+           << config.getLatency() << " frames in flight to " << _prefix
+           << std::endl;
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    for (View* view : _views)
+        view->disableScreenshot();
+
+    _writer->queue.push(Writer::Item()); // exit after the queued images
+    _writer->join();
+
+    const float seconds = float(_config.getTime() - _startTime) / 1000.f;
+    const size_t frames =
+        _views.empty() ? 0 : _writer->written / _views.size();
+    LBINFO << "Offline rendering wrote " << frames << " frames in " << seconds
+           << " s, " << (seconds > 0.f ? float(frames) * 3600.f / seconds : 0.f)
+           << " frames per hour" << std::endl;
+}
+
+void OfflineRenderer::_add(const size_t index, const uint32_t frame,
+                           const Image& image)
+{
+    // file names carry the frame number, completion order does not matter
+    std::ostringstream fileName;
+    fileName << _prefix;
+    if (_views.size() > 1)
+        fileName << index << '_';
+    fileName << std::setfill('0') << std::setw(6) << frame << ".rgb";
+
+    if (_writer->queue.getSize() >= _latency && !_throttled)
+    {
+        LBWARN << _latency << " images wait for the offline writer, throttling "
+               << "rendering to the disk bandwidth" << std::endl;
+        _throttled = true;
+    }
+
+    // blocks while the queue holds 'latency' images
+    _writer->queue.push({fileName.str(), std::make_shared<const Image>(image)});
+}
+}
+}
@@ -0,0 +1,64 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_OFFLINERENDERER_H
+#define EQ_DETAIL_OFFLINERENDERER_H
+
+#include <eq/types.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Offline rendering of a benchmark camera path, enabled by --eq-offline.
+ *
+ * Raises the latency of the configuration to keep many frames in flight, which
+ * the DPlex layout dispatches to the first free pipe. The images of all active
+ * views are captured as screenshots on the application node and written by a
+ * writer thread as '<prefix>[<view>_]<frame>.rgb'. At most 'latency' images
+ * wait for the writer, further screenshots block the application thread.
+ */
+class OfflineRenderer
+{
+public:
+    OfflineRenderer(eq::Config& config, const std::string& prefix,
+                    uint32_t latency);
+
+    /** Write queued images, stop capturing and report the throughput. */
+    ~OfflineRenderer();
+
+private:
+    class Writer;
+
+    eq::Config& _config;
+    const std::string _prefix;
+    const uint32_t _latency;
+    const int64_t _startTime;
+    std::vector<View*> _views;
+    std::unique_ptr<Writer> _writer;
+    bool _throttled;
+
+    void _add(size_t index, uint32_t frame, const Image& image);
+};
+}
+}
+
+#endif // EQ_DETAIL_OFFLINERENDERER_H
@@ -0,0 +1,162 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "preCompositor.h"
+
+#include "../frameData.h"
+#include "../pixelData.h"
+
+#include <pression/plugins/compressor.h>
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+/** @return true if the image can be depth-merged into the first image. */
+bool _isMergeable(const Image& first, const Image& image)
+{
+    if (image.getStorageType() != Frame::TYPE_MEMORY ||
+        image.getContext().pixel != Pixel::ALL ||
+        !image.getPixelViewport().hasArea() ||
+        image.getZoom() != first.getZoom() ||
+        !image.hasPixelData(Frame::Buffer::color) ||
+        !image.hasPixelData(Frame::Buffer::depth))
+    {
+        return false;
+    }
+
+    const PixelData& color = image.getPixelData(Frame::Buffer::color);
+    const PixelData& firstColor = first.getPixelData(Frame::Buffer::color);
+    const PixelData& depth = image.getPixelData(Frame::Buffer::depth);
+    return color.pixelSize == 4 &&
+           color.internalFormat == firstColor.internalFormat &&
+           color.externalFormat == firstColor.externalFormat &&
+           !color.compressedData.isCompressed() && depth.pixelSize == 4 &&
+           depth.externalFormat == EQ_COMPRESSOR_DATATYPE_DEPTH_UNSIGNED_INT &&
+           !depth.compressedData.isCompressed();
+}
+
+/** Depth-test the image into the result covering destPVP. */
+void _mergeImage(const Image& image, const PixelViewport& destPVP,
+                 uint32_t* destColor, uint32_t* destDepth)
+{
+    const PixelViewport& pvp = image.getPixelViewport();
+    const uint32_t* color = reinterpret_cast<const uint32_t*>(
+        image.getPixelPointer(Frame::Buffer::color));
+    const uint32_t* depth = reinterpret_cast<const uint32_t*>(
+        image.getPixelPointer(Frame::Buffer::depth));
+    const int32_t destX = pvp.x - destPVP.x;
+    const int32_t destY = pvp.y - destPVP.y;
+
+#pragma omp parallel for
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        const int64_t skip = int64_t(destY + y) * destPVP.w + destX;
+        uint32_t* destColorIt = destColor + skip;
+        uint32_t* destDepthIt = destDepth + skip;
+        const uint32_t* colorIt = color + int64_t(y) * pvp.w;
+        const uint32_t* depthIt = depth + int64_t(y) * pvp.w;
+
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            if (destDepthIt[x] > depthIt[x])
+            {
+                destColorIt[x] = colorIt[x];
+                destDepthIt[x] = depthIt[x];
+            }
+        }
+    }
+}
+}
+
+PreCompositeOutputs PreCompositor::add(const PreCompositeOutput& output)
+{
+    const FrameData& frameData = *output.frameData;
+    const Key key(frameData.getPreCompositeGroup(), output.frameNumber);
+    PreCompositeOutputs& outputs = _groups[key];
+
+    if (frameData.getID() == key.first)
+        outputs.insert(outputs.begin(), output);
+    else
+        outputs.push_back(output);
+
+    PreCompositeOutputs group;
+    if (outputs.size() < frameData.getPreCompositeSize())
+        return group;
+
+    group.swap(outputs);
+    _groups.erase(key);
+    return group;
+}
+
+Image* PreCompositor::merge(const PreCompositeOutputs& outputs)
+{
+    std::vector<const Image*> images;
+    for (const PreCompositeOutput& output : outputs)
+        for (const Image* image : output.frameData->getImages())
+            images.push_back(image);
+
+    if (images.size() < 2)
+        return 0;
+
+    // The images may cover different regions of interest of the same frame
+    // data, merge them over the union of their pixel viewports
+    const Image& first = *images.front();
+    PixelViewport pvp;
+    for (const Image* image : images)
+    {
+        if (!_isMergeable(first, *image))
+            return 0;
+        pvp.merge(image->getPixelViewport());
+    }
+
+    const bool copyFirst = first.getPixelViewport() == pvp;
+    const Frame::Buffer buffers[] = {Frame::Buffer::color,
+                                     Frame::Buffer::depth};
+    _result.setPixelViewport(pvp);
+    _result.setZoom(first.getZoom());
+    _result.setContext(first.getContext());
+    _result.setAlphaUsage(first.getAlphaUsage());
+    for (const Frame::Buffer buffer : buffers)
+    {
+        const PixelData& data = first.getPixelData(buffer);
+        if (copyFirst)
+            _result.setPixelData(buffer, data);
+        else
+        {
+            // cleared to the far plane, uncovered pixels stay background
+            PixelData cleared;
+            cleared.internalFormat = data.internalFormat;
+            cleared.externalFormat = data.externalFormat;
+            cleared.pixelSize = data.pixelSize;
+            cleared.pvp = pvp;
+            _result.setPixelData(buffer, cleared);
+        }
+        _result.setQuality(buffer, first.getQuality(buffer));
+    }
+
+    uint32_t* color = reinterpret_cast<uint32_t*>(
+        _result.getPixelPointer(Frame::Buffer::color));
+    uint32_t* depth = reinterpret_cast<uint32_t*>(
+        _result.getPixelPointer(Frame::Buffer::depth));
+    for (size_t i = copyFirst ? 1 : 0; i < images.size(); ++i)
+        _mergeImage(*images[i], pvp, color, depth);
+    return &_result;
+}
+}
+}
@@ -0,0 +1,80 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_PRECOMPOSITOR_H
+#define EQ_DETAIL_PRECOMPOSITOR_H
+
+#include <eq/image.h> // member
+#include <eq/types.h>
+
+#include <map>
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/** A read back output frame of a pre-composition group. */
+struct PreCompositeOutput
+{
+    Channel* channel;
+    FrameDataPtr frameData;
+    co::ObjectVersion frameDataVersion;
+    std::vector<uint128_t> nodes;
+    co::NodeIDs netNodes;
+    uint32_t frameNumber;
+    uint32_t taskID;
+};
+typedef std::vector<PreCompositeOutput> PreCompositeOutputs;
+
+/**
+ * Node-local depth compositing of DB outputs before network transmission.
+ *
+ * The server groups the output frames rendered on one node for the same remote
+ * input frame. Their images are held back until all outputs of the group are
+ * read back, and are then sent as one image with the frame data of the group
+ * leader, reducing the network volume by the number of local sources. Used
+ * by the transmit thread only.
+ */
+class PreCompositor
+{
+public:
+    /**
+     * Add a read back output of a pre-composition group.
+     *
+     * @return all outputs of the group, leader first, once the group is
+     *         complete; an empty list otherwise.
+     */
+    PreCompositeOutputs add(const PreCompositeOutput& output);
+
+    /**
+     * Depth-composite the images of the given outputs over the union of
+     * their pixel viewports.
+     *
+     * @return the merged image, valid until the next call, or 0 if the images
+     *         can't be merged on the CPU.
+     */
+    Image* merge(const PreCompositeOutputs& outputs);
+
+private:
+    typedef std::pair<uint128_t, uint32_t> Key; //!< group, frame number
+    std::map<Key, PreCompositeOutputs> _groups;
+    Image _result;
+};
+}
+}
+
+#endif // EQ_DETAIL_PRECOMPOSITOR_H
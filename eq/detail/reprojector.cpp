@@ -0,0 +1,184 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "reprojector.h"
+
+#include "../channel.h"
+#include "../gl.h"
+#include "../observer.h"
+#include "../view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace eq
+{
+namespace detail
+{
+bool Reprojector::setup(const Channel& channel, const Matrix4f& renderedHead,
+                        const Matrix4f& head)
+{
+    const View* view = channel.getView();
+    const Observer* observer = view ? view->getObserver() : 0;
+    if (!observer || renderedHead == head || channel.useOrtho())
+        return false;
+
+    const RenderContext& context = channel.getContext();
+    const Frustumf& rendered = context.frustum;
+    const Matrix4f& renderedTransform = context.headTransform;
+
+    Frustumf frustum = rendered;
+    Matrix4f transform = renderedTransform;
+    if (context.headMounted)
+        // The frustum moves with the head, see Compound::_computePerspective
+        transform = renderedTransform * renderedHead * head.inverse();
+    else
+    {
+        // The wall is fixed: move the eye and recompute the off-axis frustum
+        const Vector3f& eye = observer->getEyePosition(context.eye);
+        const Vector3f motion =
+            (head * eye - renderedHead * eye) * view->getModelUnit();
+
+        // rotate into wall space, the head transform is the wall transform
+        // translated by the eye position
+        Vector3f delta;
+        for (size_t i = 0; i < 3; ++i)
+            delta[i] = transform.array[i] * motion[0] +
+                       transform.array[i + 4] * motion[1] +
+                       transform.array[i + 8] * motion[2];
+
+        const Vector3f& renderedEye = context.eyeWall;
+        const Vector3f eyeWall = renderedEye + delta;
+        if (renderedEye.z() <= 0.f || eyeWall.z() <= 0.f)
+            return false;
+
+        const float toWall = renderedEye.z() / rendered.nearPlane();
+        const float toNear = rendered.nearPlane() / eyeWall.z();
+        frustum.left() =
+            (rendered.left() * toWall + renderedEye.x() - eyeWall.x()) *
+            toNear;
+        frustum.right() =
+            (rendered.right() * toWall + renderedEye.x() - eyeWall.x()) *
+            toNear;
+        frustum.bottom() =
+            (rendered.bottom() * toWall + renderedEye.y() - eyeWall.y()) *
+            toNear;
+        frustum.top() =
+            (rendered.top() * toWall + renderedEye.y() - eyeWall.y()) * toNear;
+
+        transform.array[12] -= delta.x();
+        transform.array[13] -= delta.y();
+        transform.array[14] -= delta.z();
+    }
+
+    _transform = frustum.computePerspectiveMatrix() * transform *
+                 renderedTransform.inverse() *
+                 rendered.computePerspectiveMatrix().inverse();
+    return true;
+}
+
+void Reprojector::apply(const PixelViewport& pvp)
+{
+    if (!pvp.hasArea())
+        return;
+
+    const size_t size = size_t(pvp.w) * size_t(pvp.h);
+    _color.resize(size);
+    _depth.resize(size);
+    EQ_GL_CALL(glReadPixels(pvp.x, pvp.y, pvp.w, pvp.h, GL_RGBA,
+                            GL_UNSIGNED_BYTE, _color.data()));
+    EQ_GL_CALL(glReadPixels(pvp.x, pvp.y, pvp.w, pvp.h, GL_DEPTH_COMPONENT,
+                            GL_FLOAT, _depth.data()));
+
+    _transformPixels(pvp);
+    _splatPixels(pvp);
+
+    EQ_GL_CALL(glRasterPos2i(pvp.x, pvp.y));
+    EQ_GL_CALL(glDrawPixels(pvp.w, pvp.h, GL_RGBA, GL_UNSIGNED_BYTE,
+                            _warpedColor.data()));
+}
+
+void Reprojector::_transformPixels(const PixelViewport& pvp)
+{
+    const size_t size = _depth.size();
+    _x.resize(size);
+    _y.resize(size);
+    _z.resize(size);
+
+    const float* m = _transform.array;
+    const float width = float(pvp.w);
+    const float height = float(pvp.h);
+    const float behindEye = std::numeric_limits<float>::max();
+
+    // Branch-free inner loop over contiguous rows, vectorized by the compiler
+#pragma omp parallel for
+    for (int32_t y = 0; y < pvp.h; ++y)
+    {
+        const size_t row = size_t(y) * size_t(pvp.w);
+        const float* depth = &_depth[row];
+        float* outX = &_x[row];
+        float* outY = &_y[row];
+        float* outZ = &_z[row];
+        const float ndcY = (float(y) + .5f) * 2.f / height - 1.f;
+
+        for (int32_t x = 0; x < pvp.w; ++x)
+        {
+            const float ndcX = (float(x) + .5f) * 2.f / width - 1.f;
+            const float ndcZ = depth[x] * 2.f - 1.f;
+            const float clipX = m[0] * ndcX + m[4] * ndcY + m[8] * ndcZ + m[12];
+            const float clipY = m[1] * ndcX + m[5] * ndcY + m[9] * ndcZ + m[13];
+            const float clipZ =
+                m[2] * ndcX + m[6] * ndcY + m[10] * ndcZ + m[14];
+            const float clipW =
+                m[3] * ndcX + m[7] * ndcY + m[11] * ndcZ + m[15];
+            const float invW = 1.f / clipW;
+
+            outX[x] = (clipX * invW + 1.f) * .5f * width;
+            outY[x] = (clipY * invW + 1.f) * .5f * height;
+            outZ[x] = clipW > 0.f ? clipZ * invW : behindEye;
+        }
+    }
+}
+
+void Reprojector::_splatPixels(const PixelViewport& pvp)
+{
+    // holes keep the rendered color
+    _warpedColor = _color;
+    _warpedDepth.assign(_color.size(), std::numeric_limits<float>::max());
+
+    const size_t size = _color.size();
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float z = _z[i];
+        const float fx = std::floor(_x[i]);
+        const float fy = std::floor(_y[i]);
+        if (!(fx >= 0.f && fy >= 0.f && fx < float(pvp.w) &&
+              fy < float(pvp.h))) // also rejects NaN
+        {
+            continue;
+        }
+
+        const size_t j = size_t(fy) * size_t(pvp.w) + size_t(fx);
+        if (z >= _warpedDepth[j])
+            continue;
+
+        _warpedDepth[j] = z;
+        _warpedColor[j] = _color[i];
+    }
+}
+}
+}
@@ -0,0 +1,75 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_REPROJECTOR_H
+#define EQ_DETAIL_REPROJECTOR_H
+
+#include <eq/fabric/vmmlib.h> // member
+#include <eq/types.h>
+
+#include <vector>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Late reprojection of a destination channel to the newest head position.
+ *
+ * With a frame latency, the assembled image of a view shows the head position
+ * of an older frame. Before the swap, the color and depth buffer of the
+ * channel are read back and each pixel is forward-warped to the newest head
+ * position with a depth test. Pixels not covered by the warped image keep
+ * their rendered color. Regions without depth, e.g., 2D-assembled
+ * contributions, are warped at the far plane.
+ */
+class Reprojector
+{
+public:
+    /**
+     * Compute the warp of the channel's current perspective context from the
+     * head matrix it was rendered with to the given newer head matrix.
+     *
+     * @return true if the channel needs to be warped.
+     */
+    bool setup(const Channel& channel, const Matrix4f& renderedHead,
+               const Matrix4f& head);
+
+    /**
+     * Warp the given pixel viewport of the current read and draw buffer.
+     *
+     * Has to be called with the assembly state applied.
+     */
+    void apply(const PixelViewport& pvp);
+
+private:
+    Matrix4f _transform; //!< rendered to warped clip space
+
+    std::vector<uint32_t> _color;
+    std::vector<float> _depth;
+    std::vector<float> _x; //!< warped window coordinates
+    std::vector<float> _y;
+    std::vector<float> _z; //!< warped depth, max() behind the eye
+    std::vector<uint32_t> _warpedColor;
+    std::vector<float> _warpedDepth;
+
+    void _transformPixels(const PixelViewport& pvp);
+    void _splatPixels(const PixelViewport& pvp);
+};
+}
+}
+
+#endif // EQ_DETAIL_REPROJECTOR_H
@@ -0,0 +1,183 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "sharedImageRing.h"
+
+#include <lunchbox/debug.h>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
+namespace bip = boost::interprocess;
+
+namespace eq
+{
+namespace detail
+{
+namespace
+{
+struct BlockHeader
+{
+    std::atomic<uint32_t> used;
+    uint32_t padding;
+    uint64_t size;
+};
+
+const uint64_t _alignment = 64;
+
+uint64_t _align(const uint64_t size)
+{
+    return (size + _alignment - 1) & ~(_alignment - 1);
+}
+
+// short enough for the 31 character limit of POSIX shm names on OS X
+std::string _getName(const co::NodeID& node)
+{
+    std::ostringstream name;
+    name << "eq" << std::hex << (node.high() ^ node.low());
+    return name.str();
+}
+}
+
+SharedImageRing::SharedImageRing(const co::NodeID& owner, const uint64_t size)
+    : _name(_getName(owner))
+    , _owner(true)
+    , _head(0)
+{
+    bip::shared_memory_object::remove(_name.c_str());
+    bip::shared_memory_object shm(bip::create_only, _name.c_str(),
+                                  bip::read_write);
+    shm.truncate(bip::offset_t(size));
+#ifdef __linux__
+    // Reserve the pages now: writing past the space left in /dev/shm would
+    // raise SIGBUS during rendering instead of failing here
+    const int error =
+        ::posix_fallocate(shm.get_mapping_handle().handle, 0, off_t(size));
+    if (error != 0)
+    {
+        bip::shared_memory_object::remove(_name.c_str());
+        throw std::runtime_error("Can't allocate " + std::to_string(size) +
+                                 " bytes of shared memory: " +
+                                 ::strerror(error));
+    }
+#endif
+    _region.reset(new bip::mapped_region(shm, bip::read_write));
+}
+
+SharedImageRing::SharedImageRing(const co::NodeID& owner)
+    : _name(_getName(owner))
+    , _owner(false)
+    , _head(0)
+{
+    bip::shared_memory_object shm(bip::open_only, _name.c_str(),
+                                  bip::read_write);
+    _region.reset(new bip::mapped_region(shm, bip::read_write));
+}
+
+SharedImageRing::~SharedImageRing()
+{
+    _region.reset();
+    if (_owner)
+        bip::shared_memory_object::remove(_name.c_str());
+}
+
+bool SharedImageRing::exists(const co::NodeID& owner)
+{
+    try
+    {
+        bip::shared_memory_object shm(bip::open_only, _getName(owner).c_str(),
+                                      bip::read_only);
+        return true;
+    }
+    catch (const bip::interprocess_exception&)
+    {
+        return false;
+    }
+}
+
+uint8_t* SharedImageRing::alloc(const uint64_t size, uint64_t& offset)
+{
+    LBASSERT(_owner);
+    _reclaim();
+
+    const uint64_t capacity = _region->get_size();
+    const uint64_t needed = _align(sizeof(BlockHeader) + size);
+
+    if (_blocks.empty())
+        _head = 0;
+
+    if (_blocks.empty() || _head > _blocks.front().first)
+    {
+        // free space at [head, capacity) and [0, tail)
+        if (_head + needed > capacity)
+        {
+            if (!_blocks.empty() && needed >= _blocks.front().first)
+                return nullptr;
+            if (needed > capacity)
+                return nullptr;
+            _head = 0;
+        }
+    }
+    else if (_head + needed >= _blocks.front().first) // free: [head, tail)
+        return nullptr;
+
+    offset = _head;
+    _head += needed;
+    _blocks.push_back(std::make_pair(offset, needed));
+
+    uint8_t* data = static_cast<uint8_t*>(_region->get_address()) + offset;
+    BlockHeader* header = new (data) BlockHeader;
+    header->size = size;
+    header->used.store(1, std::memory_order_release);
+    return data + sizeof(BlockHeader);
+}
+
+const uint8_t* SharedImageRing::getData(const uint64_t offset) const
+{
+    LBASSERT(offset + sizeof(BlockHeader) <= _region->get_size());
+    return static_cast<const uint8_t*>(_region->get_address()) + offset +
+           sizeof(BlockHeader);
+}
+
+void SharedImageRing::release(const uint64_t offset)
+{
+    uint8_t* data = static_cast<uint8_t*>(_region->get_address()) + offset;
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(data);
+    header->used.store(0, std::memory_order_release);
+}
+
+void SharedImageRing::_reclaim()
+{
+    const uint8_t* data = static_cast<const uint8_t*>(_region->get_address());
+    while (!_blocks.empty())
+    {
+        const BlockHeader* header =
+            reinterpret_cast<const BlockHeader*>(data + _blocks.front().first);
+        if (header->used.load(std::memory_order_acquire) != 0)
+            return;
+        _blocks.pop_front();
+    }
+}
+}
+}
@@ -0,0 +1,95 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_SHAREDIMAGERING_H
+#define EQ_DETAIL_SHAREDIMAGERING_H
+
+#include <eq/types.h>
+
+#include <deque>
+#include <memory>
+
+namespace boost
+{
+namespace interprocess
+{
+class mapped_region;
+}
+}
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * A host-local shared memory ring buffer used to transport image pixels
+ * between co-located render processes.
+ *
+ * Each node owns one ring, named after its network node identifier and written
+ * by its transmit thread. The existence of a node's ring signals that the node
+ * runs on the local host. Receivers map the ring of the sender, read the pixel
+ * data in place and release the block afterwards.
+ */
+class SharedImageRing
+{
+public:
+    /**
+     * Create the ring of the given local node, reserving all of its memory.
+     * Throws on error.
+     */
+    SharedImageRing(const co::NodeID& owner, uint64_t size);
+
+    /** Map the ring of the given node. Throws if it does not exist. */
+    explicit SharedImageRing(const co::NodeID& owner);
+
+    /** Unmap the ring, and remove it if this instance is the owner. */
+    ~SharedImageRing();
+
+    /** @return true if the ring of the given node exists on this host. */
+    static bool exists(const co::NodeID& owner);
+
+    /**
+     * Allocate a block in the ring. Owner only.
+     *
+     * @param size the number of bytes to allocate.
+     * @param offset returns the offset of the allocated block.
+     * @return the block data, or nullptr if the ring is full.
+     */
+    uint8_t* alloc(uint64_t size, uint64_t& offset);
+
+    /** @return the data of the block at the given offset. */
+    const uint8_t* getData(uint64_t offset) const;
+
+    /** Release the block at the given offset after reading it. */
+    void release(uint64_t offset);
+
+private:
+    const std::string _name;
+    const bool _owner;
+    std::unique_ptr<boost::interprocess::mapped_region> _region;
+
+    uint64_t _head; //!< owner only: next allocation position
+    std::deque<std::pair<uint64_t, uint64_t>> _blocks; //!< owner: in-flight
+
+    SharedImageRing(const SharedImageRing&) = delete;
+    SharedImageRing& operator=(const SharedImageRing&) = delete;
+
+    void _reclaim();
+};
+}
+}
+
+#endif // EQ_DETAIL_SHAREDIMAGERING_H
@@ -0,0 +1,210 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "threadPlacement.h"
+
+#include <lunchbox/log.h>
+#include <lunchbox/thread.h>
+
+#ifdef EQUALIZER_USE_HWLOC
+#include <hwloc.h>
+#endif
+#ifdef EQUALIZER_USE_HWLOC_GL
+#include <hwloc/gl.h>
+#endif
+
+namespace eq
+{
+namespace detail
+{
+namespace threadPlacement
+{
+namespace
+{
+#ifdef EQUALIZER_USE_HWLOC
+/** The I/O topology of the local machine, loaded on first use. */
+class Topology
+{
+public:
+    Topology()
+        : _topology(0)
+    {
+        if (hwloc_topology_init(&_topology) < 0)
+        {
+            LBINFO << "Automatic thread placement failed: "
+                   << "hwloc_topology_init() failed" << std::endl;
+            _topology = 0;
+            return;
+        }
+
+        // Load I/O devices, bridges and their relevant info
+        const unsigned long loading_flags =
+            HWLOC_TOPOLOGY_FLAG_IO_BRIDGES | HWLOC_TOPOLOGY_FLAG_IO_DEVICES;
+        if (hwloc_topology_set_flags(_topology, loading_flags) < 0)
+        {
+            LBINFO << "Automatic thread placement failed: "
+                   << "hwloc_topology_set_flags() failed" << std::endl;
+            _destroy();
+            return;
+        }
+
+        if (hwloc_topology_load(_topology) < 0)
+        {
+            LBINFO << "Automatic thread placement failed: "
+                   << "hwloc_topology_load() failed" << std::endl;
+            _destroy();
+        }
+    }
+
+    ~Topology() { _destroy(); }
+    hwloc_topology_t get() const { return _topology; }
+    /** @return the socket affinity of the given I/O device. */
+    int32_t getAffinity(const hwloc_obj_t osdev) const
+    {
+        const hwloc_obj_t parent =
+            hwloc_get_non_io_ancestor_obj(_topology, osdev->parent);
+        const int numCpus =
+            hwloc_get_nbobjs_inside_cpuset_by_type(_topology, parent->cpuset,
+                                                   HWLOC_OBJ_SOCKET);
+        if (numCpus != 1)
+        {
+            LBINFO << "Automatic thread placement failed: " << osdev->name
+                   << " attached to " << numCpus << " processors?"
+                   << std::endl;
+            return lunchbox::Thread::NONE;
+        }
+
+        const hwloc_obj_t cpuObj =
+            hwloc_get_obj_inside_cpuset_by_type(_topology, parent->cpuset,
+                                                HWLOC_OBJ_SOCKET, 0);
+        if (cpuObj == 0)
+        {
+            LBINFO << "Automatic thread placement failed: "
+                   << "hwloc_get_obj_inside_cpuset_by_type() failed"
+                   << std::endl;
+            return lunchbox::Thread::NONE;
+        }
+        return cpuObj->logical_index + lunchbox::Thread::SOCKET;
+    }
+
+private:
+    hwloc_topology_t _topology;
+
+    void _destroy()
+    {
+        if (_topology)
+            hwloc_topology_destroy(_topology);
+        _topology = 0;
+    }
+};
+
+const Topology& _getTopology()
+{
+    static const Topology topology;
+    return topology;
+}
+#endif
+}
+
+int32_t getGPUAffinity(uint32_t port LB_UNUSED, uint32_t device LB_UNUSED)
+{
+#ifdef EQUALIZER_USE_HWLOC_GL
+    if (port == LB_UNDEFINED_UINT32 && device == LB_UNDEFINED_UINT32)
+        return lunchbox::Thread::NONE;
+
+    if (port == LB_UNDEFINED_UINT32)
+        port = 0;
+    if (device == LB_UNDEFINED_UINT32)
+        device = 0;
+
+    const Topology& topology = _getTopology();
+    if (!topology.get())
+        return lunchbox::Thread::NONE;
+
+    const hwloc_obj_t osdev =
+        hwloc_gl_get_display_osdev_by_port_device(topology.get(), int(port),
+                                                  int(device));
+    if (!osdev)
+    {
+        LBINFO << "Automatic pipe thread placement failed: GPU not found"
+               << std::endl;
+        return lunchbox::Thread::NONE;
+    }
+    return topology.getAffinity(osdev);
+#else
+    LBDEBUG << "Automatic thread placement not supported, no hwloc GL support"
+            << std::endl;
+    return lunchbox::Thread::NONE;
+#endif
+}
+
+int32_t getNetworkAffinity()
+{
+#ifdef EQUALIZER_USE_HWLOC
+    const Topology& topology = _getTopology();
+    if (!topology.get())
+        return lunchbox::Thread::NONE;
+
+    // Prefer InfiniBand adapters over Ethernet interfaces
+    hwloc_obj_t network = 0;
+    for (hwloc_obj_t osdev = hwloc_get_next_osdev(topology.get(), 0); osdev;
+         osdev = hwloc_get_next_osdev(topology.get(), osdev))
+    {
+        if (!osdev->parent)
+            continue;
+
+        const hwloc_obj_osdev_type_t type = osdev->attr->osdev.type;
+        if (type == HWLOC_OBJ_OSDEV_OPENFABRICS)
+        {
+            network = osdev;
+            break;
+        }
+        if (type == HWLOC_OBJ_OSDEV_NETWORK && !network)
+            network = osdev;
+    }
+
+    if (!network)
+    {
+        LBINFO << "Automatic node thread placement failed: no network device"
+               << std::endl;
+        return lunchbox::Thread::NONE;
+    }
+    return topology.getAffinity(network);
+#else
+    LBDEBUG << "Automatic thread placement not supported, no hwloc support"
+            << std::endl;
+    return lunchbox::Thread::NONE;
+#endif
+}
+
+void report(const std::string& thread, const int32_t affinity,
+            const std::string& reason)
+{
+    if (affinity >= lunchbox::Thread::CORE)
+        LBINFO << "Thread " << thread << " bound to core "
+               << affinity - lunchbox::Thread::CORE << " (" << reason << ")"
+               << std::endl;
+    else if (affinity >= lunchbox::Thread::SOCKET && affinity < 0)
+        LBINFO << "Thread " << thread << " bound to socket "
+               << affinity - lunchbox::Thread::SOCKET << " (" << reason << ")"
+               << std::endl;
+    else
+        LBINFO << "Thread " << thread << " not bound (" << reason << ")"
+               << std::endl;
+}
+}
+}
+}
@@ -0,0 +1,51 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQ_DETAIL_THREADPLACEMENT_H
+#define EQ_DETAIL_THREADPLACEMENT_H
+
+#include <eq/types.h>
+
+#include <string>
+
+namespace eq
+{
+namespace detail
+{
+/**
+ * Topology-aware placement of Equalizer-owned threads.
+ *
+ * Uses the hwloc topology of the local machine, loaded once per process, to
+ * find the processor socket closest to a device. Threads bound to a socket
+ * allocate their working buffers on the local memory node (first touch).
+ * All functions return lunchbox::Thread::NONE if the placement is unknown.
+ */
+namespace threadPlacement
+{
+/** @return the socket affinity closest to the given GPU. */
+int32_t getGPUAffinity(uint32_t port, uint32_t device);
+
+/** @return the socket affinity closest to the fastest network interface. */
+int32_t getNetworkAffinity();
+
+/** Log the placement of the named thread at startup. */
+void report(const std::string& thread, int32_t affinity,
+            const std::string& reason);
+}
+}
+}
+
+#endif // EQ_DETAIL_THREADPLACEMENT_H
@@ -282,6 +282,10 @@ public:
         IATTR_HINT_STATISTICS,
         /** Use a send token for output frames (OFF, ON) */
         IATTR_HINT_SENDTOKEN,
+        /** Reuse output frames of unchanged source contributions (OFF, ON) */
+        IATTR_HINT_RESULT_CACHE,
+        /** Warp the view to the newest head position before swap (OFF, ON) */
+        IATTR_HINT_REPROJECTION,
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -36,7 +36,9 @@ namespace
 #define MAKE_ATTR_STRING(attr) (std::string("EQ_CHANNEL_") + #attr)
 static std::string _iAttributeStrings[] = {
     MAKE_ATTR_STRING(IATTR_HINT_STATISTICS),
-    MAKE_ATTR_STRING(IATTR_HINT_SENDTOKEN)};
+    MAKE_ATTR_STRING(IATTR_HINT_SENDTOKEN),
+    MAKE_ATTR_STRING(IATTR_HINT_RESULT_CACHE),
+    MAKE_ATTR_STRING(IATTR_HINT_REPROJECTION)};
 
 static std::string _sAttributeStrings[] = {MAKE_ATTR_STRING(SATTR_DUMP_IMAGE)};
 }
@@ -88,6 +88,8 @@ enum ConfigCommand
     CMD_CONFIG_SYNC_CLOCK,
     CMD_CONFIG_SWAP_OBJECT,
     CMD_CONFIG_CHECK_FRAME,
+    CMD_CONFIG_FRAMEDATA_TRANSMIT,
+    CMD_CONFIG_FRAMEDATA_READY,
     CMD_CONFIG_CUSTOM
 };
 
@@ -107,6 +109,7 @@ enum NodeCommand
     CMD_NODE_FRAME_TASKS_FINISH,
     CMD_NODE_FRAMEDATA_TRANSMIT,
     CMD_NODE_FRAMEDATA_READY,
+    CMD_NODE_FRAMEDATA_TRANSMIT_SHARED,
     CMD_NODE_CUSTOM
 };
 
@@ -54,6 +54,8 @@ public:
         FLAG_LOAD_EQ_VERTICAL = LB_BIT6,
         /** Auto-config: 2D partition for load equalizer */
         FLAG_LOAD_EQ_2D = LB_BIT7,
+        /** Auto-config: add the frame-parallel DPlex layout (--eq-offline) */
+        FLAG_OFFLINE = LB_BIT8,
         /** @internal */
         FLAG_LOAD_EQ_ALL =
             FLAG_LOAD_EQ_HORIZONTAL | FLAG_LOAD_EQ_VERTICAL | FLAG_LOAD_EQ_2D,
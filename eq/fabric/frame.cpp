@@ -27,8 +27,15 @@ namespace fabric
 {
 struct ToNodes
 {
+    ToNodes()
+        : preCompositeSize(0)
+    {
+    }
+
     std::vector<uint128_t> inputNodes;
     co::NodeIDs inputNetNodes;
+    uint128_t preCompositeGroup;
+    uint32_t preCompositeSize;
 };
 
 namespace detail
@@ -49,7 +56,8 @@ public:
 
         for (unsigned i = 0; i < NUM_EYES; ++i)
             os << frameDataVersion[i] << toNodes[i].inputNodes
-               << toNodes[i].inputNetNodes;
+               << toNodes[i].inputNetNodes << toNodes[i].preCompositeGroup
+               << toNodes[i].preCompositeSize;
     }
 
     void deserialize(co::DataIStream& is)
@@ -58,7 +66,8 @@ public:
 
         for (unsigned i = 0; i < NUM_EYES; ++i)
             is >> frameDataVersion[i] >> toNodes[i].inputNodes >>
-                toNodes[i].inputNetNodes;
+                toNodes[i].inputNetNodes >> toNodes[i].preCompositeGroup >>
+                toNodes[i].preCompositeSize;
     }
 };
 }
@@ -132,6 +141,24 @@ const co::NodeIDs& Frame::getInputNetNodes(const Eye eye) const
     return _impl->toNodes[lunchbox::getIndexOfLastBit(eye)].inputNetNodes;
 }
 
+void Frame::setPreComposite(const Eye eye, const uint128_t& group,
+                            const uint32_t size)
+{
+    ToNodes& toNodes = _impl->toNodes[lunchbox::getIndexOfLastBit(eye)];
+    toNodes.preCompositeGroup = group;
+    toNodes.preCompositeSize = size;
+}
+
+const uint128_t& Frame::getPreCompositeGroup(const Eye eye) const
+{
+    return _impl->toNodes[lunchbox::getIndexOfLastBit(eye)].preCompositeGroup;
+}
+
+uint32_t Frame::getPreCompositeSize(const Eye eye) const
+{
+    return _impl->toNodes[lunchbox::getIndexOfLastBit(eye)].preCompositeSize;
+}
+
 std::vector<uint128_t>& Frame::_getInputNodes(const unsigned i)
 {
     return _impl->toNodes[i].inputNodes;
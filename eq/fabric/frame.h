@@ -106,6 +106,26 @@ public:
     /** @internal @return the receiving co::Node IDs of an output frame */
     EQFABRIC_API const co::NodeIDs& getInputNetNodes(const Eye eye) const;
 
+    /**
+     * @internal Set the node-local pre-composition group of an output frame.
+     *
+     * The outputs of a group are rendered on the same node for the same input
+     * frame. They are depth-composited on the sending node and transmitted as
+     * one image with the frame data of the group leader.
+     *
+     * @param eye the eye pass.
+     * @param group the identifier of the leader's frame data.
+     * @param size the number of outputs in the group, 0 if not grouped.
+     */
+    EQFABRIC_API void setPreComposite(const Eye eye, const uint128_t& group,
+                                      const uint32_t size);
+
+    /** @internal @return the leader frame data of the pre-composition group */
+    EQFABRIC_API const uint128_t& getPreCompositeGroup(const Eye eye) const;
+
+    /** @internal @return the number of outputs in the pre-composition group */
+    EQFABRIC_API uint32_t getPreCompositeSize(const Eye eye) const;
+
 protected:
     virtual ChangeType getChangeType() const { return INSTANCE; }
     EQFABRIC_API virtual void getInstanceData(co::DataOStream& os);
@@ -80,7 +80,13 @@ public:
            model</a> */
         IATTR_THREAD_MODEL,
         IATTR_LAUNCH_TIMEOUT, //!< Timeout when auto-launching the node
+        /**
+         * Thread affinity of the transmit, receiver and command threads. AUTO
+         * binds them to the socket of the network interface if hwloc is
+         * available, OFF leaves them unbound.
+         */
         IATTR_HINT_AFFINITY,
+        IATTR_HINT_SHARED_MEMORY, //!< MB of host-local image transport memory
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST + 5
     };
@@ -36,7 +36,8 @@ namespace
 
 std::string _iAttributeStrings[] = {MAKE_ATTR_STRING(IATTR_THREAD_MODEL),
                                     MAKE_ATTR_STRING(IATTR_LAUNCH_TIMEOUT),
-                                    MAKE_ATTR_STRING(IATTR_HINT_AFFINITY)};
+                                    MAKE_ATTR_STRING(IATTR_HINT_AFFINITY),
+                                    MAKE_ATTR_STRING(IATTR_HINT_SHARED_MEMORY)};
 }
 
 template <class C, class N, class P, class V>
@@ -65,8 +65,10 @@ public:
     Eye eye;               //!< current eye pass
     uint32_t alignToEight; //!< @internal padding
 
+    Vector3f eyeWall;     //!< eye position wrt the frustum wall
     ColorMask bufferMask; //!< color mask for anaglyph stereo
-    bool alignDummy[28];  //!< @internal padding
+    bool headMounted;     //!< frustum wall moves with the observer's head
+    bool alignDummy[15];  //!< @internal padding
 };
 
 EQFABRIC_API std::ostream& operator<<(std::ostream&, const RenderContext&);
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2009-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2009-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -54,18 +54,30 @@ static StatisticData _statisticData[] = {
     {Statistic::CHANNEL_FRAME_COMPRESS, "compress", Vector3f(0.f, .7f, 1.f)},
     {Statistic::CHANNEL_FRAME_WAIT_SENDTOKEN, "wait send token",
      Vector3f(1.f, 0.f, 0.f)},
+    {Statistic::CHANNEL_REPROJECT, "reproject", Vector3f(.5f, .5f, 1.f)},
+    {Statistic::CHANNEL_MOTION_TO_DISPLAY, "motion to display",
+     Vector3f(1.f, .5f, 0.f)},
+    {Statistic::CHANNEL_FRAME_TILES, "tiles", Vector3f(.5f, 1.f, .5f)},
+    {Statistic::CHANNEL_RESULT_CACHE, "result cache", Vector3f(0.f, 1.f, 1.f)},
     {Statistic::WINDOW_FINISH, "finish", Vector3f(1.0f, 1.0f, 0.f)},
     {Statistic::WINDOW_THROTTLE_FRAMERATE, "throttle",
      Vector3f(1.0f, 0.f, 1.f)},
+    {Statistic::WINDOW_FRAME_PACING, "pacing", Vector3f(.5f, 0.f, 1.f)},
     {Statistic::WINDOW_SWAP_BARRIER, "barrier", Vector3f(1.0f, 0.f, 0.f)},
     {Statistic::WINDOW_SWAP, "swap", Vector3f(1.f, 1.f, 1.f)},
     {Statistic::WINDOW_FPS, "FPS", Vector3f(1.f, 1.f, 1.f)},
     {Statistic::PIPE_IDLE, "pipe idle", Vector3f(1.f, 1.f, 1.f)},
+    {Statistic::PIPE_REMOTE_READBACK, "remote readback",
+     Vector3f(1.f, .3f, .3f)},
     {Statistic::NODE_FRAME_DECOMPRESS, "decompress", Vector3f(0.f, .7f, 1.f)},
+    {Statistic::NODE_LAUNCH, "launch", Vector3f(.5f, .5f, 1.f)},
+    {Statistic::NODE_CONNECT, "connect resident", Vector3f(.5f, 1.f, 1.f)},
+    {Statistic::NODE_INIT, "node init", Vector3f(.3f, .3f, 1.f)},
     {Statistic::CONFIG_START_FRAME, "start frame", Vector3f(.5f, 1.0f, .5f)},
     {Statistic::CONFIG_FINISH_FRAME, "finish frame", Vector3f(.5f, .5f, .5f)},
     {Statistic::CONFIG_WAIT_FINISH_FRAME, "wait finish",
      Vector3f(1.0f, 0.f, 0.f)},
+    {Statistic::CONFIG_UPDATE, "reconfigure", Vector3f(1.0f, .5f, 0.f)},
     {Statistic::ALL, "ALL EVENTS", Vector3f(0.0f, 0.f, 0.f)}};
 }
 
@@ -55,18 +55,38 @@ struct Statistic : public Event
         CHANNEL_FRAME_COMPRESS,   //!< Sampling of frame compression
         /** Sampling of waiting for a send token from the receiver */
         CHANNEL_FRAME_WAIT_SENDTOKEN,
+        CHANNEL_REPROJECT, //!< Sampling of the late reprojection before swap
+        /** Age of the displayed head position, ratio is warped / rendered */
+        CHANNEL_MOTION_TO_DISPLAY,
+        /** Sampling of the tile loop, idle time is the per-tile overhead */
+        CHANNEL_FRAME_TILES,
+        /** Reused source contributions, ratio is hits / eligible lookups */
+        CHANNEL_RESULT_CACHE,
         WINDOW_FINISH, //!< Sampling of Window::finish before a swap barrier
         /** Sampling of throttling of framerate_equalizer */
         WINDOW_THROTTLE_FRAMERATE,
+        /** Draw time of a paced frame, ratio is actual / predicted time */
+        WINDOW_FRAME_PACING,
         WINDOW_SWAP_BARRIER,   //!< Sampling of swap barrier block
         WINDOW_SWAP,           //!< Sampling of Window::swapBuffers
         WINDOW_FPS,            //!< Framerate sampling
         PIPE_IDLE,             //!< Pipe thread idle ratio
+        /**
+         * Time from pipe frame start to the last readback for another node.
+         * totalTime and idleTime are the channel tasks until that readback in
+         * traversal and scheduled order, ratio is scheduled / traversal.
+         */
+        PIPE_REMOTE_READBACK,
         NODE_FRAME_DECOMPRESS, //!< Sampling of frame decompression
+        NODE_LAUNCH,           //!< Time to launch a render client process
+        NODE_CONNECT,          //!< Time to connect a resident render client
+        NODE_INIT,             //!< Time of the node initialization
         CONFIG_START_FRAME,    //!< Sampling of Config::startFrame
         CONFIG_FINISH_FRAME,   //!< Sampling of Config::finishFrame
         /** Sampling of synchronization time during Config::finishFrame */
         CONFIG_WAIT_FINISH_FRAME,
+        /** Sampling of the stall during a runtime reconfiguration */
+        CONFIG_UPDATE,
         ALL // must be last
     };
 
@@ -77,7 +97,7 @@ struct Statistic : public Event
 
     int64_t startTime; //!< Absolute start time of the operation
     int64_t endTime;   //!< Absolute end time of the operation
-    int64_t idleTime;  //!< Absolute idle time of PIPE_IDLE
+    int64_t idleTime;  //!< Idle time of PIPE_IDLE, overhead of FRAME_TILES
     int64_t totalTime; //!< Total time of a pipe frame (PIPE_IDLE)
 
     float ratio;      //!< compression ratio (transfer, compression)
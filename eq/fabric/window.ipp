@@ -58,7 +58,8 @@ std::string _iAttributeStrings[] = {
     MAKE_WINDOW_ATTR_STRING(IATTR_PLANES_STENCIL),
     MAKE_WINDOW_ATTR_STRING(IATTR_PLANES_ACCUM),
     MAKE_WINDOW_ATTR_STRING(IATTR_PLANES_ACCUM_ALPHA),
-    MAKE_WINDOW_ATTR_STRING(IATTR_PLANES_SAMPLES)};
+    MAKE_WINDOW_ATTR_STRING(IATTR_PLANES_SAMPLES),
+    MAKE_WINDOW_ATTR_STRING(IATTR_HINT_FRAME_PACING)};
 }
 
 template <class P, class W, class C, class Settings>
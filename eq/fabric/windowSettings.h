@@ -79,6 +79,7 @@ public:
         IATTR_PLANES_ACCUM,       //!< No of accumulation buffer planes
         IATTR_PLANES_ACCUM_ALPHA, //!< No of alpha accum buffer planes
         IATTR_PLANES_SAMPLES,     //!< No of multisample (AA) planes
+        IATTR_HINT_FRAME_PACING,  //!< Delay drawing to meet the max FPS
         IATTR_LAST,
         IATTR_ALL = IATTR_LAST
     };
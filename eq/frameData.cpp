@@ -42,6 +42,8 @@
 #include <boost/foreach.hpp>
 
 #include <algorithm>
+#include <deque>
+#include <unordered_map>
 
 namespace eq
 {
@@ -60,6 +62,7 @@ public:
         , depthQuality(1.f)
         , colorCompressor(EQ_COMPRESSOR_AUTO)
         , depthCompressor(EQ_COMPRESSOR_AUTO)
+        , preCompositeSize(0)
     {
     }
 
@@ -69,7 +72,40 @@ public:
 
     ROIFinder roiFinder;
 
-    Images pendingImages;
+    /** A received image, protected by pendingLock. */
+    struct PendingImage
+    {
+        uint64_t version;
+        Image* image;
+        bool complete; //!< pixel data is set
+    };
+    std::vector<PendingImage> pendingImages;
+
+    /** Images using received pixels in place, with their release function. */
+    std::unordered_map<const Image*, std::function<void()>> mappedImages;
+    std::mutex mappedLock;
+
+    /** Release the pixels of the given images, or of all if empty. */
+    void releaseMapped(const Images& images_)
+    {
+        std::lock_guard<std::mutex> lock(mappedLock);
+        if (images_.empty())
+        {
+            for (auto& mapped : mappedImages)
+                mapped.second();
+            mappedImages.clear();
+            return;
+        }
+
+        for (const Image* image : images_)
+        {
+            auto i = mappedImages.find(image);
+            if (i == mappedImages.end())
+                continue;
+            i->second();
+            mappedImages.erase(i);
+        }
+    }
 
     uint64_t version; //!< The current version
 
@@ -85,6 +121,24 @@ public:
 
     uint32_t colorCompressor;
     uint32_t depthCompressor;
+
+    /** Node-local pre-composition group of output data, see Pipe::getFrame */
+    uint128_t preCompositeGroup;
+    uint32_t preCompositeSize;
+
+    /** Received ready versions waiting for their image decompression. */
+    typedef std::pair<co::ObjectVersion, fabric::FrameData> PendingReady;
+    std::deque<PendingReady> pendingReadies;
+    std::mutex pendingLock;
+
+    /** @return true if all images up to the given version are complete. */
+    bool isComplete(const uint64_t version_) const
+    {
+        for (const PendingImage& pending : pendingImages)
+            if (pending.version <= version_ && !pending.complete)
+                return false;
+        return true;
+    }
 };
 }
 
@@ -98,6 +152,7 @@ FrameData::FrameData()
 FrameData::~FrameData()
 {
     clear();
+    _impl->releaseMapped(Images()); // pending images never set ready
 
     for (Image* image : _impl->imageCache)
     {
@@ -164,6 +219,9 @@ void FrameData::applyInstanceData(co::DataIStream& is)
 
 void FrameData::clear()
 {
+    if (!_impl->images.empty())
+        _impl->releaseMapped(_impl->images);
+
     _impl->imageCacheLock.lock();
     _impl->imageCache.insert(_impl->imageCache.end(), _impl->images.begin(),
                              _impl->images.end());
@@ -343,6 +401,22 @@ void FrameData::setVersion(const uint64_t version)
     LBLOG(LOG_ASSEMBLY) << "New v" << version << std::endl;
 }
 
+void FrameData::setPreComposite(const uint128_t& group, const uint32_t size)
+{
+    _impl->preCompositeGroup = group;
+    _impl->preCompositeSize = size;
+}
+
+const uint128_t& FrameData::getPreCompositeGroup() const
+{
+    return _impl->preCompositeGroup;
+}
+
+uint32_t FrameData::getPreCompositeSize() const
+{
+    return _impl->preCompositeSize;
+}
+
 void FrameData::waitReady(const uint32_t timeout) const
 {
     if (!_impl->readyVersion.timedWaitGE(_impl->version, timeout))
@@ -356,6 +430,21 @@ void FrameData::setReady()
 
 void FrameData::setReady(const co::ObjectVersion& frameData,
                          const fabric::FrameData& data)
+{
+    std::lock_guard<std::mutex> lock(_impl->pendingLock);
+    if (!_impl->pendingReadies.empty() ||
+        !_impl->isComplete(frameData.version.low()))
+    {
+        // applied by the last decompression in setPixelData()
+        _impl->pendingReadies.push_back(std::make_pair(frameData, data));
+        return;
+    }
+    _applyReady(frameData, data);
+}
+
+// pendingLock is held by the caller
+void FrameData::_applyReady(const co::ObjectVersion& frameData,
+                            const fabric::FrameData& data)
 {
     clear();
     LBASSERT(frameData.version.high() == 0);
@@ -364,7 +453,13 @@ void FrameData::setReady(const co::ObjectVersion& frameData,
              _impl->readyVersion + 1 == frameData.version.low());
     LBASSERT(_impl->version == frameData.version.low());
 
-    _impl->images.swap(_impl->pendingImages);
+    const uint64_t version = frameData.version.low();
+    auto& pending = _impl->pendingImages;
+    auto i = pending.begin();
+    for (; i != pending.end() && i->version <= version; ++i)
+        _impl->images.push_back(i->image);
+    pending.erase(pending.begin(), i);
+
     fabric::FrameData::operator=(data);
     _setReady(frameData.version.low());
 
@@ -415,16 +510,67 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
                          const Frame::Buffer buffers_, const bool useAlpha,
                          uint8_t* data)
 {
-    LBASSERT(_impl->readyVersion < frameDataVersion.version.low());
-    if (_impl->readyVersion >= frameDataVersion.version.low())
+    Image* image = addPendingImage(frameDataVersion, pvp, useAlpha);
+    if (!image)
         return false;
 
+    setPixelData(image, zoom, context, buffers_, data);
+    return true;
+}
+
+Image* FrameData::addPendingImage(const co::ObjectVersion& frameDataVersion,
+                                  const PixelViewport& pvp,
+                                  const bool useAlpha)
+{
+    const uint64_t version = frameDataVersion.version.low();
+    LBASSERT(_impl->readyVersion < version);
+    if (_impl->readyVersion >= version)
+        return 0;
+
     Image* image = _allocImage(Frame::TYPE_MEMORY, DrawableConfig(),
                                false /* set quality */);
 
     image->setPixelViewport(pvp);
     image->setAlphaUsage(useAlpha);
 
+    // keep the receive order, independent of the decompression order
+    std::lock_guard<std::mutex> lock(_impl->pendingLock);
+    const detail::FrameData::PendingImage pending = {version, image, false};
+    _impl->pendingImages.push_back(pending);
+    return image;
+}
+
+bool FrameData::addMappedImage(const co::ObjectVersion& frameDataVersion,
+                               const PixelViewport& pvp, const Zoom& zoom,
+                               const RenderContext& context,
+                               const Frame::Buffer buffers_,
+                               const bool useAlpha, uint8_t* data,
+                               const std::function<void()>& release)
+{
+    Image* image = addPendingImage(frameDataVersion, pvp, useAlpha);
+    if (!image)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(_impl->mappedLock);
+        _impl->mappedImages[image] = release;
+    }
+    _setPixelData(image, zoom, context, buffers_, data, true);
+    return true;
+}
+
+void FrameData::setPixelData(Image* image, const Zoom& zoom,
+                             const RenderContext& context,
+                             const Frame::Buffer buffers_, uint8_t* data)
+{
+    _setPixelData(image, zoom, context, buffers_, data, false);
+}
+
+void FrameData::_setPixelData(Image* image, const Zoom& zoom,
+                              const RenderContext& context,
+                              const Frame::Buffer buffers_, uint8_t* data,
+                              const bool map)
+{
     Frame::Buffer buffers[] = {Frame::Buffer::color, Frame::Buffer::depth};
     for (unsigned i = 0; i < 2; ++i)
     {
@@ -473,12 +619,25 @@ bool FrameData::addImage(const co::ObjectVersion& frameDataVersion,
             image->setZoom(zoom);
             image->setContext(context);
             image->setQuality(buffer, header->quality);
-            image->setPixelData(buffer, pixelData);
+            if (map && compressor <= EQ_COMPRESSOR_NONE)
+                image->mapPixelData(buffer, pixelData);
+            else
+                image->setPixelData(buffer, pixelData);
         }
     }
 
-    _impl->pendingImages.push_back(image);
-    return true;
+    std::lock_guard<std::mutex> lock(_impl->pendingLock);
+    for (auto& pending : _impl->pendingImages)
+        if (pending.image == image)
+            pending.complete = true;
+
+    auto& readies = _impl->pendingReadies;
+    while (!readies.empty() &&
+           _impl->isComplete(readies.front().first.version.low()))
+    {
+        _applyReady(readies.front().first, readies.front().second);
+        readies.pop_front();
+    }
 }
 
 std::ostream& operator<<(std::ostream& os, const FrameData& data)
@@ -27,6 +27,8 @@
 #include <lunchbox/monitor.h>  // member
 #include <lunchbox/spinLock.h> // member
 
+#include <functional>
+
 namespace eq
 {
 namespace detail
@@ -175,6 +177,18 @@ public:
     /** @internal */
     void setVersion(const uint64_t version);
 
+    /**
+     * @internal Set the node-local pre-composition group of output data.
+     * @sa fabric::Frame::setPreComposite()
+     */
+    void setPreComposite(const uint128_t& group, const uint32_t size);
+
+    /** @internal @return the leader frame data of the group. */
+    const uint128_t& getPreCompositeGroup() const;
+
+    /** @internal @return the number of outputs in the group, 0 if none. */
+    uint32_t getPreCompositeSize() const;
+
     typedef lunchbox::Monitor<uint32_t> Listener; //!< Ready listener
 
     /**
@@ -202,6 +216,35 @@ public:
                   const PixelViewport& pvp, const Zoom& zoom,
                   const RenderContext& context, const Frame::Buffer buffers,
                   const bool useAlpha, uint8_t* data);
+
+    /**
+     * @internal Add a received image without pixel data.
+     *
+     * The pixels have to be set using setPixelData(), possibly from another
+     * thread. A received ready version is only applied once all pending
+     * images have their pixel data.
+     * @return the new image, or 0 if the version is already ready.
+     */
+    Image* addPendingImage(const co::ObjectVersion& frameDataVersion,
+                           const PixelViewport& pvp, const bool useAlpha);
+
+    /** @internal Decompress the received pixels of a pending image. */
+    void setPixelData(Image* image, const Zoom& zoom,
+                      const RenderContext& context,
+                      const Frame::Buffer buffers, uint8_t* data);
+
+    /**
+     * @internal Add a received image using its uncompressed pixels in place.
+     *
+     * The release function is called once the image is no longer used, that
+     * is, when the frame data is cleared or destroyed.
+     */
+    bool addMappedImage(const co::ObjectVersion& frameDataVersion,
+                        const PixelViewport& pvp, const Zoom& zoom,
+                        const RenderContext& context,
+                        const Frame::Buffer buffers, const bool useAlpha,
+                        uint8_t* data, const std::function<void()>& release);
+
     void setReady(const co::ObjectVersion& frameData,
                   const fabric::FrameData& data); //!< @internal
 
@@ -213,6 +256,10 @@ protected:
 private:
     detail::FrameData* const _impl;
 
+    void _setPixelData(Image* image, const Zoom& zoom,
+                       const RenderContext& context,
+                       const Frame::Buffer buffers, uint8_t* data, bool map);
+
     /** Allocate or reuse an image. */
     Image* _allocImage(const Frame::Type type, const DrawableConfig& config,
                        const bool setQuality);
@@ -220,6 +267,10 @@ private:
     /** Apply all received images of the given version. */
     void _applyVersion(const uint128_t& version);
 
+    /** Apply a received ready version with its images, pending locked. */
+    void _applyReady(const co::ObjectVersion& frameData,
+                     const fabric::FrameData& data);
+
     /** Set a specific version ready. */
     void _setReady(const uint64_t version);
 
@@ -28,16 +28,33 @@
 #include <lunchbox/debug.h>
 #include <lunchbox/log.h>
 
+#ifdef __linux__
+#include <cerrno>
+#include <climits>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 namespace eq
 {
 namespace glx
 {
 MessagePump::MessagePump()
+#ifdef __linux__
+    : _epoll(::epoll_create1(EPOLL_CLOEXEC))
+#else
+    : _epoll(-1)
+#endif
+    , _notifier(-1)
 {
 }
 
 MessagePump::~MessagePump()
 {
+#ifdef __linux__
+    if (_epoll >= 0)
+        ::close(_epoll);
+#endif
 }
 
 void MessagePump::postWakeup()
@@ -53,7 +70,7 @@ void MessagePump::dispatchOne(const uint32_t timeout)
     case co::ConnectionSet::EVENT_DISCONNECT:
     {
         co::ConnectionPtr connection = _connections.getConnection();
-        _connections.removeConnection(connection);
+        _removeConnection(connection);
         LBERROR << "Display connection shut down" << std::endl;
         break;
     }
@@ -86,6 +103,53 @@ void MessagePump::dispatchOne(const uint32_t timeout)
     }
 }
 
+bool MessagePump::wait(const int notifier LB_UNUSED,
+                       const uint32_t timeout LB_UNUSED)
+{
+#ifdef __linux__
+    if (_epoll < 0)
+        return false;
+
+    if (notifier != _notifier)
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.ptr = 0;
+        if (_notifier >= 0)
+            ::epoll_ctl(_epoll, EPOLL_CTL_DEL, _notifier, &event);
+        if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, notifier, &event) != 0)
+        {
+            LBWARN << "Can't add notifier to epoll set: "
+                   << lunchbox::sysError() << std::endl;
+            _notifier = -1;
+            return false;
+        }
+        _notifier = notifier;
+    }
+
+    const int ms = timeout > INT_MAX ? -1 : int(timeout);
+    epoll_event events[8];
+    const int nEvents = ::epoll_wait(_epoll, events, 8, ms);
+    if (nEvents < 0 && errno != EINTR)
+        LBWARN << "Error during epoll: " << lunchbox::sysError() << std::endl;
+
+    // Data is dispatched by dispatchAll(), only handle closed connections
+    for (int i = 0; i < nEvents; ++i)
+    {
+        co::Connection* connection =
+            static_cast<co::Connection*>(events[i].data.ptr);
+        if (connection && (events[i].events & (EPOLLHUP | EPOLLERR)))
+        {
+            LBERROR << "Display connection shut down" << std::endl;
+            _removeConnection(connection);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 void MessagePump::dispatchAll()
 {
     EventHandler::dispatch();
@@ -97,7 +161,7 @@ void MessagePump::dispatchAll()
 void MessagePump::register_(Display* display)
 {
     if (++_referenced[display] == 1)
-        _connections.addConnection(new X11Connection(display));
+        _addConnection(new X11Connection(display));
 }
 
 void MessagePump::deregister(Display* display)
@@ -113,7 +177,7 @@ void MessagePump::deregister(Display* display)
                 dynamic_cast<const X11Connection*>(connection.get());
             if (x11Connection && x11Connection->getDisplay() == display)
             {
-                _connections.removeConnection(connection);
+                _removeConnection(connection);
                 break;
             }
         }
@@ -125,7 +189,7 @@ void MessagePump::register_(deflect::Proxy* proxy LB_UNUSED)
 {
 #ifdef EQUALIZER_USE_DEFLECT
     if (++_referenced[proxy] == 1)
-        _connections.addConnection(new deflect::Connection(proxy));
+        _addConnection(new deflect::Connection(proxy));
 #endif
 }
 
@@ -143,7 +207,7 @@ void MessagePump::deregister(deflect::Proxy* proxy LB_UNUSED)
                 dynamic_cast<const deflect::Connection*>(connection.get());
             if (dcConnection && dcConnection->getProxy() == proxy)
             {
-                _connections.removeConnection(connection);
+                _removeConnection(connection);
                 break;
             }
         }
@@ -151,5 +215,36 @@ void MessagePump::deregister(deflect::Proxy* proxy LB_UNUSED)
     }
 #endif
 }
+
+void MessagePump::_addConnection(co::ConnectionPtr connection)
+{
+    _connections.addConnection(connection);
+#ifdef __linux__
+    if (_epoll < 0)
+        return;
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.ptr = connection.get();
+    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, connection->getNotifier(),
+                    &event) != 0)
+    {
+        LBWARN << "Can't add connection to epoll set: "
+               << lunchbox::sysError() << std::endl;
+    }
+#endif
+}
+
+void MessagePump::_removeConnection(co::ConnectionPtr connection)
+{
+#ifdef __linux__
+    if (_epoll >= 0)
+    {
+        epoll_event event = {};
+        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, connection->getNotifier(), &event);
+    }
+#endif
+    _connections.removeConnection(connection);
+}
 }
 }
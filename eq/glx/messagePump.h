@@ -43,6 +43,9 @@ public:
     void dispatchAll() final;
     void dispatchOne(const uint32_t timeout = LB_TIMEOUT_INDEFINITE) final;
 
+    /** Wait on all Display connections and the notifier using epoll. */
+    bool wait(const int notifier, const uint32_t timeout) final;
+
     /**
      * Register a new Display connection for event dispatch.
      *
@@ -68,6 +71,12 @@ public:
 private:
     co::ConnectionSet _connections; //!< Registered Display connections
     std::unordered_map<void*, size_t> _referenced; //!< # of registrations
+
+    int _epoll;    //!< epoll set of connections and notifier, -1 if n/a
+    int _notifier; //!< notifier currently in the epoll set
+
+    void _addConnection(co::ConnectionPtr connection);
+    void _removeConnection(co::ConnectionPtr connection);
 };
 }
 }
@@ -318,6 +318,43 @@ public:
         pression::PluginRegistry::getInstance().accept(finder);
         return finder.result;
     }
+
+    /** Reset the memory of the buffer to the format of the given pixels. */
+    Memory& setFormat(const eq::Frame::Buffer buffer, const PixelData& pixels)
+    {
+        Memory& memory = getMemory(buffer);
+        memory.externalFormat = pixels.externalFormat;
+        memory.internalFormat = pixels.internalFormat;
+        memory.pixelSize = pixels.pixelSize;
+        memory.pvp = pixels.pvp;
+        memory.state = Memory::INVALID;
+        memory.compressedData = pression::CompressorResult();
+        memory.hasAlpha = false;
+
+        const EqCompressorInfos& transferrers =
+            findTransferers(buffer, 0 /*GLEW context*/);
+        if (transferrers.empty())
+        {
+            LBWARN << "No upload engines found for given pixel data"
+                   << std::endl;
+            return memory;
+        }
+
+        memory.hasAlpha =
+            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
+#ifndef NDEBUG
+        for (EqCompressorInfosCIter i = transferrers.begin();
+             i != transferrers.end(); ++i)
+        {
+            LBASSERTINFO(memory.hasAlpha ==
+                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
+                         "Uploaders don't agree on alpha state of external "
+                             << "format: " << transferrers.front()
+                             << " != " << *i);
+        }
+#endif
+        return memory;
+    }
 };
 }
 
@@ -939,37 +976,24 @@ void Image::validatePixelData(const Frame::Buffer buffer)
     memory.compressedData = pression::CompressorResult();
 }
 
-void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
+void Image::mapPixelData(const Frame::Buffer buffer, const PixelData& pixels)
 {
-    Memory& memory = _impl->getMemory(buffer);
-    memory.externalFormat = pixels.externalFormat;
-    memory.internalFormat = pixels.internalFormat;
-    memory.pixelSize = pixels.pixelSize;
-    memory.pvp = pixels.pvp;
-    memory.state = Memory::INVALID;
-    memory.compressedData = pression::CompressorResult();
-    memory.hasAlpha = false;
+    LBASSERT(pixels.compressedData.compressor <= EQ_COMPRESSOR_NONE);
+    LBASSERT(pixels.pixels);
 
-    const EqCompressorInfos& transferrers =
-        _impl->findTransferers(buffer, 0 /*GLEW context*/);
-    if (transferrers.empty())
-        LBWARN << "No upload engines found for given pixel data" << std::endl;
-    else
-    {
-        memory.hasAlpha =
-            transferrers.front().capabilities & EQ_COMPRESSOR_IGNORE_ALPHA;
-#ifndef NDEBUG
-        for (EqCompressorInfosCIter i = transferrers.begin();
-             i != transferrers.end(); ++i)
-        {
-            LBASSERTINFO(memory.hasAlpha ==
-                             bool(i->capabilities & EQ_COMPRESSOR_IGNORE_ALPHA),
-                         "Uploaders don't agree on alpha state of external "
-                             << "format: " << transferrers.front()
-                             << " != " << *i);
-        }
-#endif
-    }
+    Memory& memory = _impl->setFormat(buffer, pixels);
+    if (getPixelDataSize(buffer) == 0 || !pixels.pixels)
+        return;
+
+    // reference the pixels, the next validatePixelData() restores the
+    // local buffer
+    memory.pixels = pixels.pixels;
+    memory.state = Memory::VALID;
+}
+
+void Image::setPixelData(const Frame::Buffer buffer, const PixelData& pixels)
+{
+    Memory& memory = _impl->setFormat(buffer, pixels);
 
     const uint32_t size = getPixelDataSize(buffer);
     LBASSERT(size > 0);
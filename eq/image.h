@@ -248,6 +248,15 @@ public:
      */
     EQ_API void setPixelData(const Frame::Buffer buffer, const PixelData& data);
 
+    /**
+     * @internal
+     * Reference uncompressed pixel data without copying it.
+     *
+     * The caller keeps the pixels valid until the image is reset, flushed or
+     * receives new pixel data.
+     */
+    void mapPixelData(const Frame::Buffer buffer, const PixelData& data);
+
     /**
      * Set alpha data preservation during download and compression.
      * @version 1.0
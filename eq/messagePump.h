@@ -45,6 +45,22 @@ public:
     virtual void dispatchOne(
         const uint32_t timeout = LB_TIMEOUT_INDEFINITE) = 0;
 
+    /**
+     * Wait for a system event or for the given notifier to become readable.
+     *
+     * Does not dispatch events. Message pumps implementing this method do not
+     * need postWakeup() to be interrupted, the caller signals the notifier.
+     *
+     * @param notifier the file descriptor to wait on with the system events
+     * @param timeout the time to wait
+     * @return false if waiting on a notifier is not supported.
+     * @version 2.1
+     */
+    virtual bool wait(const int /*notifier*/, const uint32_t /*timeout*/)
+    {
+        return false;
+    }
+
     /** Register a new Deflect connection for event dispatch. @version 1.7.1 */
     virtual void register_(deflect::Proxy*)
     {
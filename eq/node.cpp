@@ -21,6 +21,9 @@
 
 #include "client.h"
 #include "config.h"
+#include "detail/preCompositor.h"
+#include "detail/sharedImageRing.h"
+#include "detail/threadPlacement.h"
 #include "error.h"
 #include "exception.h"
 #include "frameData.h"
@@ -28,6 +31,7 @@
 #include "log.h"
 #include "nodeFactory.h"
 #include "nodeStatistics.h"
+#include "observer.h"
 #include "pipe.h"
 #include "server.h"
 
@@ -42,8 +46,14 @@
 #include <co/connection.h>
 #include <co/global.h>
 #include <co/objectICommand.h>
+#include <lunchbox/mtQueue.h>
 #include <lunchbox/scopedMutex.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+
 namespace eq
 {
 namespace
@@ -52,6 +62,15 @@ typedef std::unordered_map<uint128_t, co::Barrier*> BarrierHash;
 typedef std::unordered_map<uint128_t, FrameDataPtr> FrameDataHash;
 typedef FrameDataHash::const_iterator FrameDataHashCIter;
 typedef FrameDataHash::iterator FrameDataHashIter;
+typedef std::shared_ptr<detail::SharedImageRing> SharedImageRingPtr;
+typedef std::unordered_map<uint128_t, SharedImageRingPtr> SharedImageRings;
+
+/** Default and maximum size of the host-local image transport ring in MB */
+static const int32_t _sharedImageRingSize = 64;
+static const int32_t _maxSharedImageRingSize = 1024;
+
+/** Upper limit of threads decompressing received images */
+static const unsigned _maxDecompressThreads = 4;
 
 enum State
 {
@@ -86,6 +105,35 @@ private:
     co::CommandQueue _queue;
 };
 
+/** Decompresses received images in parallel to the node command thread. */
+class DecompressThread : public lunchbox::Thread
+{
+public:
+    typedef std::function<void(uint32_t)> Task; //!< called with thread index
+    typedef lunchbox::MTQueue<Task> Queue;
+
+    DecompressThread(Queue& queue, const uint32_t index,
+                     const std::atomic<int32_t>& affinity)
+        : _queue(queue)
+        , _index(index)
+        , _affinity(affinity)
+    {
+    }
+    virtual ~DecompressThread() {}
+protected:
+    bool init() override
+    {
+        setName(std::string("Decomp") + std::to_string(_index));
+        return true;
+    }
+    void run() override;
+
+private:
+    Queue& _queue;
+    const uint32_t _index;
+    const std::atomic<int32_t>& _affinity;
+};
+
 class Node
 {
 public:
@@ -93,6 +141,7 @@ public:
         : state(STATE_STOPPED)
         , finishedFrame(0)
         , unlockedFrame(0)
+        , decompressAffinity(lunchbox::Thread::NONE)
     {
     }
 
@@ -114,7 +163,24 @@ public:
     /** All frame datas used by the node during rendering. */
     lunchbox::Lockable<FrameDataHash> frameDatas;
 
+    /** The image ring for receivers on this host, transmit thread only. */
+    SharedImageRingPtr sharedImageRing;
+
+    /** Network nodes known to be on this host, transmit thread only. */
+    std::unordered_map<uint128_t, bool> localNodes;
+
+    /** Pending DB outputs merged before transmission, transmit thread only. */
+    detail::PreCompositor preCompositor;
+
+    /** Image rings of senders on this host, mapped by the command thread. */
+    lunchbox::Lockable<SharedImageRings> senderRings;
+
     TransmitThread transmitter;
+
+    /** Decompression of received images, see Node::_addFrameDataImage() */
+    DecompressThread::Queue decompressQueue;
+    std::vector<std::unique_ptr<DecompressThread>> decompressors;
+    std::atomic<int32_t> decompressAffinity; //!< same as the command thread
 };
 }
 
@@ -165,6 +231,9 @@ void Node::attach(const uint128_t& id, const uint32_t instanceID)
                     NodeFunc(this, &Node::_cmdFrameDataTransmit), commandQ);
     registerCommand(fabric::CMD_NODE_FRAMEDATA_READY,
                     NodeFunc(this, &Node::_cmdFrameDataReady), commandQ);
+    registerCommand(fabric::CMD_NODE_FRAMEDATA_TRANSMIT_SHARED,
+                    NodeFunc(this, &Node::_cmdFrameDataTransmitShared),
+                    commandQ);
 }
 
 void Node::setDirty(const uint64_t bits)
@@ -255,6 +324,28 @@ FrameDataPtr Node::getFrameData(const co::ObjectVersion& frameDataVersion)
     return data;
 }
 
+detail::SharedImageRing* Node::getSharedImageRing(const co::NodeID& receiver)
+{
+    if (!_impl->sharedImageRing)
+        return 0;
+
+    auto i = _impl->localNodes.find(receiver);
+    if (i == _impl->localNodes.end())
+    {
+        const bool isLocal = detail::SharedImageRing::exists(receiver);
+        i = _impl->localNodes.insert(std::make_pair(receiver, isLocal)).first;
+        if (isLocal)
+            LBINFO << "Using shared memory image transport to " << receiver
+                   << std::endl;
+    }
+    return i->second ? _impl->sharedImageRing.get() : 0;
+}
+
+detail::PreCompositor& Node::getPreCompositor()
+{
+    return _impl->preCompositor;
+}
+
 void Node::releaseFrameData(FrameDataPtr data)
 {
     lunchbox::ScopedWrite mutex(_impl->frameDatas);
@@ -295,25 +386,35 @@ bool Node::configExit()
 
 void Node::_setAffinity()
 {
-    const int32_t affinity = getIAttribute(IATTR_HINT_AFFINITY);
+    int32_t affinity = getIAttribute(IATTR_HINT_AFFINITY);
+    std::string reason = "configured";
     switch (affinity)
     {
     case OFF:
-        break;
+        detail::threadPlacement::report("Xmit, Rcv, Cmd",
+                                        lunchbox::Thread::NONE, "disabled");
+        return;
 
     case AUTO:
-        // TODO
-        LBVERB << "No automatic thread placement for node threads "
-               << std::endl;
+        // network receive, compression and transmission run near the NIC
+        affinity = detail::threadPlacement::getNetworkAffinity();
+        reason = "near network interface";
+        if (affinity == lunchbox::Thread::NONE)
+        {
+            detail::threadPlacement::report("Xmit, Rcv, Cmd", affinity,
+                                            "no network interface found");
+            return;
+        }
         break;
 
     default:
-        co::LocalNodePtr node = getLocalNode();
-        send(node, fabric::CMD_NODE_SET_AFFINITY) << affinity;
-
-        node->setAffinity(affinity);
         break;
     }
+
+    co::LocalNodePtr node = getLocalNode();
+    send(node, fabric::CMD_NODE_SET_AFFINITY) << affinity;
+    node->setAffinity(affinity);
+    detail::threadPlacement::report("Xmit, Rcv, Cmd", affinity, reason);
 }
 
 void Node::waitFrameStarted(const uint32_t frameNumber) const
@@ -531,6 +632,73 @@ void detail::TransmitThread::run()
     }
 }
 
+void detail::DecompressThread::run()
+{
+    int32_t affinity = lunchbox::Thread::NONE;
+    while (true)
+    {
+        const Task task = _queue.pop();
+        if (!task)
+            return; // exit thread
+
+        if (affinity != _affinity)
+        {
+            affinity = _affinity;
+            lunchbox::Thread::setAffinity(affinity);
+        }
+        task(_index);
+    }
+}
+
+void Node::_startDecompressors()
+{
+    LBASSERT(_impl->decompressors.empty());
+    const unsigned nThreads =
+        std::max(1u, std::min(_maxDecompressThreads,
+                              std::thread::hardware_concurrency() / 4));
+
+    for (unsigned i = 0; i < nThreads; ++i)
+    {
+        _impl->decompressors.emplace_back(
+            new detail::DecompressThread(_impl->decompressQueue, i + 1,
+                                         _impl->decompressAffinity));
+        _impl->decompressors.back()->start();
+    }
+}
+
+void Node::_stopDecompressors()
+{
+    for (size_t i = 0; i < _impl->decompressors.size(); ++i)
+        _impl->decompressQueue.push(detail::DecompressThread::Task());
+    for (auto& decompressor : _impl->decompressors)
+        decompressor->join();
+    _impl->decompressors.clear();
+}
+
+void Node::_createSharedImageRing()
+{
+    const int32_t hint = getIAttribute(IATTR_HINT_SHARED_MEMORY);
+    if (hint == OFF)
+        return;
+
+    // ON and AUTO use the default size, larger values are the size in MB
+    const int32_t size = hint > ON ? std::min(hint, _maxSharedImageRingSize)
+                                   : _sharedImageRingSize;
+    try
+    {
+        _impl->sharedImageRing.reset(new detail::SharedImageRing(
+            getLocalNode()->getNodeID(), uint64_t(size) << 20));
+        LBLOG(LOG_INIT) << "Using " << size
+                        << " MB for shared memory image transport"
+                        << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        LBWARN << "No shared memory image transport: " << e.what()
+               << std::endl;
+    }
+}
+
 void Node::dirtyClientExit()
 {
     const Pipes& pipes = getPipes();
@@ -541,6 +709,7 @@ void Node::dirtyClientExit()
     }
     getTransmitterQueue()->push(co::ICommand()); // wake up to exit
     _impl->transmitter.join();
+    _stopDecompressors();
 }
 
 //---------------------------------------------------------------------------
@@ -601,13 +770,17 @@ bool Node::_cmdConfigInit(co::ICommand& cmd)
 
     const uint128_t& initID = command.read<uint128_t>();
     const uint32_t frameNumber = command.read<uint32_t>();
+    const bool hasLocalPeer = command.read<bool>();
 
     _impl->currentFrame = frameNumber;
     _impl->unlockedFrame = frameNumber;
     _impl->finishedFrame = frameNumber;
     _setAffinity();
+    if (hasLocalPeer)
+        _createSharedImageRing();
 
     _impl->transmitter.start();
+    _startDecompressors();
     const uint64_t result = configInit(initID);
 
     if (getIAttribute(IATTR_THREAD_MODEL) == eq::UNDEFINED)
@@ -637,6 +810,13 @@ bool Node::_cmdConfigExit(co::ICommand& cmd)
     _impl->state = configExit() ? STATE_STOPPED : STATE_FAILED;
     getTransmitterQueue()->push(co::ICommand()); // wake up to exit
     _impl->transmitter.join();
+    _stopDecompressors();
+    _impl->sharedImageRing.reset();
+    _impl->localNodes.clear();
+    {
+        lunchbox::ScopedWrite mutex(_impl->senderRings);
+        _impl->senderRings.data.clear();
+    }
     _flushObjects();
 
     getConfig()->send(getLocalNode(), fabric::CMD_CONFIG_DESTROY_NODE)
@@ -667,6 +847,10 @@ bool Node::_cmdFrameStart(co::ICommand& cmd)
         config->sync(configVersion);
     sync(version);
 
+    const int64_t time = config->getTime();
+    for (Observer* observer : config->getObservers())
+        observer->addHeadSample(frameNumber, time);
+
     config->_frameStart();
     frameStart(frameID, frameNumber);
 
@@ -726,7 +910,12 @@ bool Node::_cmdFrameTasksFinish(co::ICommand& cmd)
 bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
+    _addFrameDataImage(command);
+    return true;
+}
 
+void Node::_addFrameDataImage(co::ObjectICommand& command)
+{
     const co::ObjectVersion& frameDataVersion =
         command.read<co::ObjectVersion>();
     const PixelViewport& pvp = command.read<PixelViewport>();
@@ -747,20 +936,103 @@ bool Node::_cmdFrameDataTransmit(co::ICommand& cmd)
     FrameDataPtr frameData = getFrameData(frameDataVersion);
     LBASSERT(!frameData->isReady());
 
-    NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, this, frameNumber);
-
     // Note on the const_cast: since the PixelData structure stores non-const
     // pointers, we have to go non-const at some point, even though we do not
     // modify the data.
-    LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context, buffers,
-                                useAlpha, const_cast<uint8_t*>(data)));
+    uint8_t* pixels = const_cast<uint8_t*>(data);
+    if (_impl->decompressors.empty())
+    {
+        NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, this,
+                             frameNumber);
+        LBCHECK(frameData->addImage(frameDataVersion, pvp, zoom, context,
+                                    buffers, useAlpha, pixels));
+        return;
+    }
+
+    // The image is queued in receive order, the frame data is set ready once
+    // all its images are decompressed. The command copy keeps the received
+    // buffer alive until then.
+    Image* image = frameData->addPendingImage(frameDataVersion, pvp, useAlpha);
+    LBASSERT(image);
+    if (!image)
+        return;
+
+    const co::ICommand buffer = command;
+    _impl->decompressQueue.push([this, frameData, image, zoom, context,
+                                 buffers, frameNumber, pixels,
+                                 buffer](const uint32_t thread) {
+        NodeStatistics event(Statistic::NODE_FRAME_DECOMPRESS, this,
+                             frameNumber);
+        event.statistic.task = thread;
+        frameData->setPixelData(image, zoom, context, buffers, pixels);
+    });
+}
+
+bool Node::_cmdFrameDataTransmitShared(co::ICommand& cmd)
+{
+    co::ObjectICommand command(cmd);
+
+    const co::ObjectVersion& frameDataVersion =
+        command.read<co::ObjectVersion>();
+    const PixelViewport& pvp = command.read<PixelViewport>();
+    const Zoom& zoom = command.read<Zoom>();
+    const RenderContext& context = command.read<RenderContext>();
+    const Frame::Buffer buffers = command.read<Frame::Buffer>();
+    const uint32_t frameNumber = command.read<uint32_t>();
+    const bool useAlpha = command.read<bool>();
+    const uint64_t offset = command.read<uint64_t>();
+    const co::NodeID sender = command.getRemoteNode()->getNodeID();
+
+    LBLOG(LOG_ASSEMBLY) << "received shared image data for "
+                        << frameDataVersion << ", buffers " << buffers
+                        << " pvp " << pvp << " frame " << frameNumber
+                        << std::endl;
+
+    lunchbox::ScopedWrite mutex(_impl->senderRings);
+    SharedImageRingPtr& ring = _impl->senderRings.data[sender];
+    if (!ring)
+    {
+        try
+        {
+            ring.reset(new detail::SharedImageRing(sender));
+        }
+        catch (const std::exception& e)
+        {
+            LBERROR << "Can't map shared image data of " << sender << ": "
+                    << e.what() << std::endl;
+            _impl->senderRings.data.erase(sender);
+            return true;
+        }
+    }
+
+    FrameDataPtr frameData = getFrameData(frameDataVersion);
+    LBASSERT(!frameData->isReady());
+
+    // The image uses the uncompressed pixels in the shared memory. The block
+    // is released for reuse by the sender once the frame data recycles the
+    // image, the release keeps the ring mapped until then.
+    uint8_t* data = const_cast<uint8_t*>(ring->getData(offset));
+    const SharedImageRingPtr mappedRing = ring;
+    if (!frameData->addMappedImage(frameDataVersion, pvp, zoom, context,
+                                   buffers, useAlpha, data,
+                                   [mappedRing, offset] {
+                                       mappedRing->release(offset);
+                                   }))
+    {
+        ring->release(offset);
+    }
     return true;
 }
 
 bool Node::_cmdFrameDataReady(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
+    _setFrameDataReady(command);
+    return true;
+}
 
+void Node::_setFrameDataReady(co::ObjectICommand& command)
+{
     const co::ObjectVersion& frameDataVersion =
         command.read<co::ObjectVersion>();
     fabric::FrameData data;
@@ -771,16 +1043,17 @@ bool Node::_cmdFrameDataReady(co::ICommand& cmd)
     FrameDataPtr frameData = getFrameData(frameDataVersion);
     LBASSERT(frameData);
     LBASSERT(!frameData->isReady());
+    // ready once all images are decompressed, possibly later
     frameData->setReady(frameDataVersion, data);
-    LBASSERT(frameData->isReady());
-    return true;
 }
 
 bool Node::_cmdSetAffinity(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
 
-    lunchbox::Thread::setAffinity(command.read<int32_t>());
+    const int32_t affinity = command.read<int32_t>();
+    lunchbox::Thread::setAffinity(affinity);
+    _impl->decompressAffinity = affinity;
     return true;
 }
 }
@@ -32,6 +32,8 @@ namespace eq
 namespace detail
 {
 class Node;
+class PreCompositor;
+class SharedImageRing;
 }
 
 /**
@@ -92,6 +94,16 @@ public:
     /** @internal Release the frame data instance. */
     void releaseFrameData(FrameDataPtr data);
 
+    /**
+     * @internal Transmit thread only.
+     * @return the shared memory image ring of this node if the given network
+     *         node runs on the same host, 0 otherwise.
+     */
+    detail::SharedImageRing* getSharedImageRing(const co::NodeID& receiver);
+
+    /** @internal Transmit thread only. */
+    detail::PreCompositor& getPreCompositor();
+
     /** @internal Wait for the node to be initialized. */
     EQ_API void waitInitialized() const;
 
@@ -268,14 +280,28 @@ protected:
 
 private:
     detail::Node* const _impl;
+    friend class Config;
 
     void _setAffinity();
 
+    /** Start and stop the threads decompressing received images. */
+    void _startDecompressors();
+    void _stopDecompressors();
+
+    /** Create the ring for host-local image transport to co-located nodes. */
+    void _createSharedImageRing();
+
     void _finishFrame(const uint32_t frameNumber) const;
     void _frameFinish(const uint128_t& frameID, const uint32_t frameNumber);
 
     void _flushObjects();
 
+    /** Add the image data of a frame data transmission to the frame data. */
+    void _addFrameDataImage(co::ObjectICommand& command);
+
+    /** Set the frame data of a ready command ready. */
+    void _setFrameDataReady(co::ObjectICommand& command);
+
     /** The command functions. */
     bool _cmdCreatePipe(co::ICommand& command);
     bool _cmdDestroyPipe(co::ICommand& command);
@@ -287,6 +313,7 @@ private:
     bool _cmdFrameTasksFinish(co::ICommand& command);
     bool _cmdFrameDataTransmit(co::ICommand& command);
     bool _cmdFrameDataReady(co::ICommand& command);
+    bool _cmdFrameDataTransmitShared(co::ICommand& command);
     bool _cmdSetAffinity(co::ICommand& command);
 
     LB_TS_VAR(_nodeThread);
@@ -43,6 +43,7 @@ NodeStatistics::NodeStatistics(const Statistic::Type type, Node* node,
         snprintf(statistic.resourceName, 32, "%s", name.c_str());
 
     statistic.resourceName[31] = 0;
+    statistic.task = 0;
 
     co::LocalNodePtr localNode = node->getLocalNode();
     LBASSERT(localNode);
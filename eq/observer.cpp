@@ -26,13 +26,19 @@
 #include <eq/fabric/commands.h>
 #include <eq/fabric/event.h>
 #include <eq/fabric/paths.h>
+#include <lunchbox/scopedMutex.h>
+#include <lunchbox/spinLock.h>
 #include <vmmlib/quaternion.hpp>
 
+#include <deque>
+
 #ifdef EQUALIZER_USE_OPENCV
 #include "detail/cvTracker.h"
 #endif
-#ifdef EQUALIZER_USE_VRPN
+#if defined(EQUALIZER_USE_VRPN) || defined(EQUALIZER_USE_OPENCV)
 #include <co/buffer.h>
+#endif
+#ifdef EQUALIZER_USE_VRPN
 #include <vrpn_Tracker.h>
 #else
 class vrpn_Tracker_Remote;
@@ -50,12 +56,32 @@ public:
     Observer()
         : vrpnTracker(0)
         , cvTracker(0)
+        , frameStartTime(0)
+        , frameTime(0.f)
     {
     }
 
     vrpn_Tracker_Remote* vrpnTracker;
     CVTracker* cvTracker;
+
+    /** Start time and smoothed duration of frames, to predict display time */
+    int64_t frameStartTime;
+    float frameTime;
+
+    struct HeadSample
+    {
+        uint32_t frameNumber;
+        int64_t time;
+        Matrix4f matrix;
+    };
+
+    /** Head matrices of the last frames, synced by the node thread. */
+    std::deque<HeadSample> headSamples;
+    mutable lunchbox::SpinLock headLock;
 };
+
+/** Number of remembered head samples, larger than any sensible latency. */
+static const size_t _maxHeadSamples = 16;
 }
 
 typedef fabric::Observer<Config, Observer> Super;
@@ -78,7 +104,7 @@ ServerPtr Observer::getServer()
     return (config ? config->getServer() : 0);
 }
 
-#ifdef EQUALIZER_USE_VRPN
+#if defined(EQUALIZER_USE_VRPN) || defined(EQUALIZER_USE_OPENCV)
 namespace
 {
 class MotionEvent
@@ -97,15 +123,8 @@ public:
     EventOCommand command;
 };
 
-void VRPN_CALLBACK trackerCB(void* userdata, const vrpn_TRACKERCB data)
+void _dispatchMotion(Observer* observer, const Matrix4f& head)
 {
-    if (data.sensor != 0)
-        return; // Only use first sensor
-
-    const Matrix4f head(Quaternionf(data.quat[0], data.quat[1], data.quat[2],
-                                    data.quat[3]),
-                        Vector3f(data.pos[0], data.pos[1], data.pos[2]));
-    Observer* observer = static_cast<Observer*>(userdata);
     Config* config = observer->getConfig();
 
     // Directly dispatch the event: We're called from Config::startFrame and
@@ -123,9 +142,58 @@ void VRPN_CALLBACK trackerCB(void* userdata, const vrpn_TRACKERCB data)
     EventICommand iEvent(iCommand);
     config->handleEvent(iEvent); // config dispatch so app can update state
 }
+
+#ifdef EQUALIZER_USE_VRPN
+void VRPN_CALLBACK trackerCB(void* userdata, const vrpn_TRACKERCB data)
+{
+    if (data.sensor != 0)
+        return; // Only use first sensor
+
+    const Matrix4f head(Quaternionf(data.quat[0], data.quat[1], data.quat[2],
+                                    data.quat[3]),
+                        Vector3f(data.pos[0], data.pos[1], data.pos[2]));
+    _dispatchMotion(static_cast<Observer*>(userdata), head);
+}
+#endif
 }
 #endif
 
+void Observer::addHeadSample(const uint32_t frameNumber, const int64_t time)
+{
+    const detail::Observer::HeadSample sample = {frameNumber, time,
+                                                 getHeadMatrix()};
+    lunchbox::ScopedFastWrite mutex(_impl->headLock);
+    _impl->headSamples.push_back(sample);
+    if (_impl->headSamples.size() > detail::_maxHeadSamples)
+        _impl->headSamples.pop_front();
+}
+
+bool Observer::getHeadSample(const uint32_t frameNumber, Matrix4f& matrix,
+                             int64_t& time) const
+{
+    lunchbox::ScopedFastRead mutex(_impl->headLock);
+    for (const detail::Observer::HeadSample& sample : _impl->headSamples)
+    {
+        if (sample.frameNumber != frameNumber)
+            continue;
+        matrix = sample.matrix;
+        time = sample.time;
+        return true;
+    }
+    return false;
+}
+
+bool Observer::getLatestHeadSample(Matrix4f& matrix, int64_t& time) const
+{
+    lunchbox::ScopedFastRead mutex(_impl->headLock);
+    if (_impl->headSamples.empty())
+        return false;
+
+    matrix = _impl->headSamples.back().matrix;
+    time = _impl->headSamples.back().time;
+    return true;
+}
+
 bool Observer::configInit()
 {
 #ifdef EQUALIZER_USE_VRPN
@@ -196,6 +264,29 @@ void Observer::frameStart(const uint32_t /*frame*/)
     if (_impl->vrpnTracker)
         _impl->vrpnTracker->mainloop();
 #endif
+#ifdef EQUALIZER_USE_OPENCV
+    if (!_impl->cvTracker)
+        return;
+
+    const Config* config = getConfig();
+    const int64_t time = config->getTime();
+    if (_impl->frameStartTime > 0)
+    {
+        const float frameTime = float(time - _impl->frameStartTime);
+        _impl->frameTime = _impl->frameTime > 0.f
+                               ? .9f * _impl->frameTime + .1f * frameTime
+                               : frameTime;
+    }
+    _impl->frameStartTime = time;
+
+    // this frame is displayed after latency frames in flight and itself
+    const int64_t displayTime =
+        time + int64_t(_impl->frameTime * float(config->getLatency() + 1));
+
+    Matrix4f head;
+    if (_impl->cvTracker->predict(displayTime, head))
+        _dispatchMotion(this, head);
+#endif
 }
 }
 
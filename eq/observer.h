@@ -64,6 +64,26 @@ public:
     //@{
     /** @return the Server of this observer. @version 1.0 */
     EQ_API ServerPtr getServer();
+
+    /**
+     * @internal Remember the head matrix of the given frame.
+     *
+     * Called by the node thread after the frame's version has been synced.
+     * The history covers the frame latency, so that pipe threads can compare
+     * the head position of the frame they render with the newest one.
+     */
+    void addHeadSample(uint32_t frameNumber, int64_t time);
+
+    /**
+     * @internal
+     * @return true if the head matrix and its sync time of the given frame
+     *         are known.
+     */
+    bool getHeadSample(uint32_t frameNumber, Matrix4f& matrix,
+                       int64_t& time) const;
+
+    /** @internal @return true if a head matrix has been remembered. */
+    bool getLatestHeadSample(Matrix4f& matrix, int64_t& time) const;
     //@}
 
     void addView(View*) { /* nop */}    //!< @internal
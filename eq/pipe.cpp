@@ -40,6 +40,7 @@
 #include "view.h"
 #include "window.h"
 
+#include "detail/threadPlacement.h"
 #include "messagePump.h"
 #include "systemPipe.h"
 
@@ -55,11 +56,6 @@
 #include <co/worker.h>
 #include <sstream>
 
-#ifdef EQUALIZER_USE_HWLOC_GL
-#include <hwloc.h>
-#include <hwloc/gl.h>
-#endif
-
 #ifdef EQUALIZER_USE_QT5WIDGETS
 #include <QGuiApplication>
 #include <QRegularExpression>
@@ -130,6 +126,7 @@ public:
         , _index(index)
         , _qThread(nullptr)
         , _stop(false)
+        , _affinity(lunchbox::Thread::NONE)
     {
     }
 
@@ -138,6 +135,8 @@ public:
         if (!co::Worker::init())
             return false;
         setName(std::string("Tfer") + std::to_string(_index));
+        if (_affinity != lunchbox::Thread::NONE)
+            lunchbox::Thread::setAffinity(_affinity);
 #ifdef EQ_QT_USED
         _qThread = QThread::currentThread();
 #endif
@@ -147,10 +146,13 @@ public:
     bool stopRunning() override { return _stop; }
     void postStop() { _stop = true; }
     QThread* getQThread() { return _qThread; }
+    /** Set the affinity applied when the thread starts. */
+    void setAffinity(const int32_t affinity) { _affinity = affinity; }
 private:
     uint32_t _index;
     QThread* _qThread;
     bool _stop; // thread will exit if this is true
+    int32_t _affinity;
 };
 
 class Pipe
@@ -170,9 +172,13 @@ public:
         , state(STATE_STOPPED)
         , currentFrame(0)
         , frameTime(0)
+        , remoteReadbackEnd(0)
         , thread(0)
         , transferThread(index)
+        , affinity(lunchbox::Thread::NONE)
     {
+        criticalPath[0] = 0;
+        criticalPath[1] = 0;
     }
 
     ~Pipe()
@@ -206,6 +212,12 @@ public:
     /** The base time for the currently active frame. */
     int64_t frameTime;
 
+    /** The end time of the last remote readback of the current frame. */
+    int64_t remoteReadbackEnd;
+
+    /** Channel tasks until the last remote readback, before/after schedule. */
+    uint32_t criticalPath[2];
+
     /** All assembly frames used by the pipe during rendering. */
     FrameHash frames;
 
@@ -225,6 +237,9 @@ public:
     RenderThread* thread;
 
     detail::TransferThread transferThread;
+
+    /** The thread placement of the pipe and transfer threads. */
+    int32_t affinity;
 };
 
 void RenderThread::run()
@@ -439,104 +454,35 @@ void Pipe::_setupCommandQueue()
 
 int32_t Pipe::_getAutoAffinity() const
 {
-#ifdef EQUALIZER_USE_HWLOC_GL
-    uint32_t port = getPort();
-    uint32_t device = getDevice();
-
-    if (port == LB_UNDEFINED_UINT32 && device == LB_UNDEFINED_UINT32)
-        return lunchbox::Thread::NONE;
-
-    if (port == LB_UNDEFINED_UINT32)
-        port = 0;
-    if (device == LB_UNDEFINED_UINT32)
-        device = 0;
-
-    hwloc_topology_t topology;
-    if (hwloc_topology_init(&topology) < 0)
-    {
-        LBINFO << "Automatic pipe thread placement failed: "
-               << "hwloc_topology_init() failed" << std::endl;
-        return lunchbox::Thread::NONE;
-    }
-
-    // Load I/O devices, bridges and their relevant info
-    const unsigned long loading_flags =
-        HWLOC_TOPOLOGY_FLAG_IO_BRIDGES | HWLOC_TOPOLOGY_FLAG_IO_DEVICES;
-    if (hwloc_topology_set_flags(topology, loading_flags) < 0)
-    {
-        LBINFO << "Automatic pipe thread placement failed: "
-               << "hwloc_topology_set_flags() failed" << std::endl;
-        hwloc_topology_destroy(topology);
-        return lunchbox::Thread::NONE;
-    }
-
-    if (hwloc_topology_load(topology) < 0)
-    {
-        LBINFO << "Automatic pipe thread placement failed: "
-               << "hwloc_topology_load() failed" << std::endl;
-        hwloc_topology_destroy(topology);
-        return lunchbox::Thread::NONE;
-    }
-
-    const hwloc_obj_t osdev =
-        hwloc_gl_get_display_osdev_by_port_device(topology, int(port),
-                                                  int(device));
-    if (!osdev)
-    {
-        LBINFO << "Automatic pipe thread placement failed: GPU not found"
-               << std::endl;
-        hwloc_topology_destroy(topology);
-        return lunchbox::Thread::NONE;
-    }
-
-    const hwloc_obj_t pcidev = osdev->parent;
-    const hwloc_obj_t parent = hwloc_get_non_io_ancestor_obj(topology, pcidev);
-    const int numCpus =
-        hwloc_get_nbobjs_inside_cpuset_by_type(topology, parent->cpuset,
-                                               HWLOC_OBJ_SOCKET);
-    if (numCpus != 1)
-    {
-        LBINFO << "Automatic pipe thread placement failed: GPU attached to "
-               << numCpus << " processors?" << std::endl;
-        hwloc_topology_destroy(topology);
-        return lunchbox::Thread::NONE;
-    }
-
-    const hwloc_obj_t cpuObj =
-        hwloc_get_obj_inside_cpuset_by_type(topology, parent->cpuset,
-                                            HWLOC_OBJ_SOCKET, 0);
-    if (cpuObj == 0)
-    {
-        LBINFO << "Automatic pipe thread placement failed: "
-               << "hwloc_get_obj_inside_cpuset_by_type() failed" << std::endl;
-        hwloc_topology_destroy(topology);
-        return lunchbox::Thread::NONE;
-    }
-
-    const int cpuIndex = cpuObj->logical_index;
-    hwloc_topology_destroy(topology);
-    return cpuIndex + lunchbox::Thread::SOCKET;
-#else
-    LBDEBUG << "Automatic thread placement not supported, no hwloc GL support"
-            << std::endl;
-#endif
-    return lunchbox::Thread::NONE;
+    return detail::threadPlacement::getGPUAffinity(getPort(), getDevice());
 }
 
 void Pipe::_setupAffinity()
 {
     const int32_t affinity = getIAttribute(IATTR_HINT_AFFINITY);
+    const std::string name = "Draw" + std::to_string(getPath().pipeIndex);
     switch (affinity)
     {
     case AUTO:
-        lunchbox::Thread::setAffinity(_getAutoAffinity());
+    {
+        _impl->affinity = _getAutoAffinity();
+        std::stringstream reason;
+        reason << "near GPU " << getPort() << "." << getDevice();
+        detail::threadPlacement::report(name, _impl->affinity, reason.str());
         break;
+    }
 
     case OFF:
+        _impl->affinity = lunchbox::Thread::NONE;
+        detail::threadPlacement::report(name, _impl->affinity, "disabled");
+        break;
+
     default:
-        lunchbox::Thread::setAffinity(affinity);
+        _impl->affinity = affinity;
+        detail::threadPlacement::report(name, _impl->affinity, "configured");
         break;
     }
+    lunchbox::Thread::setAffinity(_impl->affinity);
 }
 
 void Pipe::_exitCommandQueue()
@@ -624,6 +570,8 @@ Frame* Pipe::getFrame(const co::ObjectVersion& frameVersion, const Eye eye,
         else if (frameData->getVersion() < dataVersion.version)
             frameData->sync(dataVersion.version);
 
+        frameData->setPreComposite(frame->getPreCompositeGroup(eye),
+                                   frame->getPreCompositeSize(eye));
         _impl->outputFrameDatas[dataVersion.identifier] = frameData;
     }
     else
@@ -831,6 +779,12 @@ void Pipe::notifyMapped()
     _impl->state = STATE_MAPPED;
 }
 
+void Pipe::markRemoteReadback()
+{
+    LB_TS_THREAD(_pipeThread);
+    _impl->remoteReadbackEnd = getConfig()->getTime();
+}
+
 namespace
 {
 class WaitFinishedVisitor : public PipeVisitor
@@ -1043,6 +997,11 @@ bool Pipe::startTransferThread()
     if (_impl->transferThread.isRunning())
         return true;
 
+    // readback and compression run close to the GPU, like the pipe thread
+    _impl->transferThread.setAffinity(_impl->affinity);
+    detail::threadPlacement::report(
+        "Tfer" + std::to_string(getPath().pipeIndex), _impl->affinity,
+        "same as pipe thread");
     return _impl->transferThread.start();
 }
 
@@ -1239,6 +1198,9 @@ bool Pipe::_cmdFrameStart(co::ICommand& cmd)
     const uint128_t& version = command.read<uint128_t>();
     const uint128_t& frameID = command.read<uint128_t>();
     const uint32_t frameNumber = command.read<uint32_t>();
+    _impl->criticalPath[0] = command.read<uint32_t>();
+    _impl->criticalPath[1] = command.read<uint32_t>();
+    _impl->remoteReadbackEnd = 0;
 
     LBVERB << "handle pipe frame start " << command << " frame " << frameNumber
            << " id " << frameID << std::endl;
@@ -1270,9 +1232,35 @@ bool Pipe::_cmdFrameStart(co::ICommand& cmd)
                  "current " << _impl->currentFrame << " start " << frameNumber);
 
     frameStart(frameID, frameNumber);
+    _paceFrame();
     return true;
 }
 
+void Pipe::_paceFrame()
+{
+    // All windows draw on this thread, wait once for the most urgent one
+    const int64_t now = getConfig()->getTime();
+    Window* pacer = 0;
+    float delay = 0.f;
+    for (Window* window : getWindows())
+    {
+        float windowDelay = 0.f;
+        if (window->_getFramePacingDelay(now, windowDelay) &&
+            (!pacer || windowDelay < delay))
+        {
+            pacer = window;
+            delay = windowDelay;
+        }
+    }
+
+    if (pacer)
+        pacer->_paceFrame(delay);
+
+    const int64_t drawStart = getConfig()->getTime();
+    for (Window* window : getWindows())
+        window->_startFramePacing(drawStart);
+}
+
 bool Pipe::_cmdFrameFinish(co::ICommand& cmd)
 {
     LB_TS_THREAD(_pipeThread);
@@ -1288,6 +1276,19 @@ bool Pipe::_cmdFrameFinish(co::ICommand& cmd)
                  "current " << _impl->currentFrame << " finish "
                             << frameNumber);
 
+    if (_impl->remoteReadbackEnd > _impl->frameTime)
+    {
+        PipeStatistics event(Statistic::PIPE_REMOTE_READBACK, this);
+        event.statistic.frameNumber = frameNumber;
+        event.statistic.startTime = _impl->frameTime;
+        event.statistic.endTime = _impl->remoteReadbackEnd;
+        event.statistic.totalTime = _impl->criticalPath[0];
+        event.statistic.idleTime = _impl->criticalPath[1];
+        if (_impl->criticalPath[0] > 0)
+            event.statistic.ratio = float(_impl->criticalPath[1]) /
+                                    float(_impl->criticalPath[0]);
+    }
+
     frameFinish(frameID, frameNumber);
 
     LBASSERTINFO(_impl->finishedFrame >= frameNumber,
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2015, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *                          Daniel Nachbaur <danielnachbaur@gmail.com>
  *
@@ -140,6 +140,13 @@ public:
     void waitExited() const; //!<  @internal Wait for the pipe to be exited
     void notifyMapped();     //!< @internal
 
+    /**
+     * @internal
+     * Mark the end of a readback of an output frame needed by another node in
+     * the current frame.
+     */
+    void markRemoteReadback();
+
     /**
      * @internal
      * Wait for a frame to be finished.
@@ -376,6 +383,9 @@ private:
 
     void _stopTransferThread();
 
+    /** @internal Delay the draw start of all paced windows once. */
+    void _paceFrame();
+
     /** @internal Release the views not used for some revisions. */
     void _releaseViews();
 
@@ -104,11 +104,18 @@ void Canvas::_switchLayout(const uint32_t oldIndex, const uint32_t newIndex)
     Layout* oldLayout = (oldIndex >= nLayouts) ? 0 : layouts[oldIndex];
     Layout* newLayout = (newIndex >= nLayouts) ? 0 : layouts[newIndex];
 
+    if (newIndex == LB_UNDEFINED_UINT32) // exit, Config::exit() saves state
+    {
+        if (oldLayout)
+            oldLayout->trigger(this, false);
+        return;
+    }
+
     if (oldLayout)
+    {
         oldLayout->trigger(this, false);
-
-    if (newIndex == LB_UNDEFINED_UINT32)
-        return;
+        getConfig()->saveEqualizerState();
+    }
 
     Super::activateLayout(newIndex);
 
@@ -29,10 +29,12 @@
 #include "log.h"
 #include "node.h"
 #include "segment.h"
+#include "server.h"
 #include "view.h"
 #include "window.h"
 
 #include <eq/fabric/commands.h>
+#include <eq/fabric/eventType.h>
 #include <eq/fabric/paths.h>
 #include <eq/fabric/statistic.h>
 
@@ -40,6 +42,7 @@
 
 #include <lunchbox/debug.h>
 
+#include <cstdio>
 #include <set>
 
 namespace eq
@@ -341,6 +344,14 @@ void Channel::configExit()
 
     LBLOG(LOG_INIT) << "Exit channel" << std::endl;
     send(fabric::CMD_CHANNEL_CONFIG_EXIT);
+
+    const uint64_t lookups = _resultCache.getLookups();
+    if (lookups > 0)
+        LBINFO << "Channel " << getName() << " reused "
+               << _resultCache.getHits() << " of " << lookups
+               << " source contributions ("
+               << 100 * _resultCache.getHits() / lookups << "%)" << std::endl;
+    _resultCache.clear();
 }
 
 bool Channel::syncConfigExit()
@@ -371,6 +382,29 @@ void Channel::_setupRenderContext(const uint128_t& frameID,
                                          << getName());
 }
 
+void Channel::_sendResultCacheStatistic(const uint32_t frameNumber)
+{
+    const uint32_t lookups = _resultCache.getLookups(frameNumber);
+    if (lookups == 0)
+        return;
+
+    Config* config = getConfig();
+    Statistic stat;
+    stat.type = Statistic::CHANNEL_RESULT_CACHE;
+    stat.serial = getSerial();
+    stat.originator = getID();
+    stat.frameNumber = frameNumber;
+    stat.task = 0;
+    stat.startTime = config->getServer()->getTime();
+    stat.endTime = stat.startTime;
+    stat.ratio = float(_resultCache.getHits(frameNumber)) / float(lookups);
+    snprintf(stat.resourceName, 32, "%s", getName().c_str());
+    stat.resourceName[31] = 0;
+
+    config->send(config->findApplicationNetNode(), fabric::CMD_CONFIG_EVENT)
+        << EVENT_STATISTIC << stat;
+}
+
 bool Channel::update(const uint128_t& frameID, const uint32_t frameNumber)
 {
     if (!isRunning())
@@ -409,6 +443,7 @@ bool Channel::update(const uint128_t& frameID, const uint32_t frameNumber)
     send(fabric::CMD_CHANNEL_FRAME_FINISH) << context << frameNumber;
     LBLOG(LOG_TASKS) << "TASK channel " << getName() << " finish frame  "
                      << frameNumber << std::endl;
+    _sendResultCacheStatistic(frameNumber);
     _lastDrawCompound = 0;
 
     return updated;
@@ -512,8 +547,13 @@ void Channel::output(std::ostream& os) const
 
         os << (i == IATTR_HINT_STATISTICS
                    ? "hint_statistics   "
-                   : i == IATTR_HINT_SENDTOKEN ? "hint_sendtoken    "
-                                               : "ERROR ")
+                   : i == IATTR_HINT_SENDTOKEN
+                         ? "hint_sendtoken    "
+                         : i == IATTR_HINT_RESULT_CACHE
+                               ? "hint_result_cache "
+                               : i == IATTR_HINT_REPROJECTION
+                                     ? "hint_reprojection "
+                                     : "ERROR ")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
     for (SAttribute i = static_cast<SAttribute>(0); i < SATTR_LAST;
@@ -19,7 +19,8 @@
 #ifndef EQSERVER_CHANNEL_H
 #define EQSERVER_CHANNEL_H
 
-#include "state.h" // enum
+#include "resultCache.h" // member
+#include "state.h"       // enum
 #include "types.h"
 #include <eq/server/api.h>
 
@@ -123,6 +124,9 @@ public:
         _lastDrawCompound = compound;
     }
     const Compound* getLastDrawCompound() const { return _lastDrawCompound; }
+    /** @return the cache of unchanged source contributions. */
+    ResultCache& getResultCache() { return _resultCache; }
+    const ResultCache& getResultCache() const { return _resultCache; }
     void setIAttribute(const IAttribute attr, const int32_t value)
     {
         fabric::Channel<Window, Channel>::setIAttribute(attr, value);
@@ -198,6 +202,8 @@ private:
     /** The last draw compound for this entity */
     const Compound* _lastDrawCompound;
 
+    ResultCache _resultCache;
+
     typedef std::vector<ChannelListener*> ChannelListeners;
     ChannelListeners _listeners;
 
@@ -210,6 +216,7 @@ private:
     Vector3ub _getUniqueColor() const;
 
     void _setupRenderContext(const uint128_t& frameID, RenderContext& context);
+    void _sendResultCacheStatistic(uint32_t frameNumber);
 
     void _fireLoadData(const uint32_t frameNumber, const Statistics& statistics,
                        const Viewport& region);
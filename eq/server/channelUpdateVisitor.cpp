@@ -134,6 +134,15 @@ VisitorResult ChannelUpdateVisitor::visitLeaf(const Compound* compound)
     const RenderContext& context = _setupRenderContext(compound);
     _updateFrameRate(compound);
     _updateViewStart(compound, context);
+
+    // Output frames of a cached source contribution retain the last images
+    if (_channel->getResultCache().isCached(compound, _frameNumber))
+    {
+        LBLOG(LOG_TASKS) << "TASK cached " << _channel->getName() << std::endl;
+        _updateDrawFinish(compound);
+        return TRAVERSE_CONTINUE;
+    }
+
     _updateDraw(compound, context);
     _updateDrawFinish(compound);
     _updatePostDraw(compound, context);
@@ -422,6 +431,8 @@ void ChannelUpdateVisitor::_updateReadback(const Compound* compound,
 
         if (!frame->hasData(_eye)) // TODO: filter: buffers, vp, eye
             continue;
+        if (frame->isRetained()) // receivers reuse the last images
+            continue;
 
         frames.push_back(co::ObjectVersion(frame));
         LBLOG(LOG_ASSEMBLY) << *frame << std::endl;
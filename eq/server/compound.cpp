@@ -693,6 +693,10 @@ void Compound::_computePerspective(RenderContext& context,
     const bool isHMD = (frustumData.getType() != Wall::TYPE_FIXED);
     if (isHMD)
         context.headTransform *= _getInverseHeadMatrix();
+
+    // for late reprojection on the destination channel
+    context.eyeWall = eye;
+    context.headMounted = isHMD;
 }
 
 void Compound::_computeOrtho(RenderContext& context, const Vector3f& eye) const
@@ -1030,6 +1034,8 @@ void Compound::activate(const uint32_t eyes)
 
 void Compound::deactivate(const uint32_t eyes)
 {
+    storeEqualizerState(); // learned state of the active compound tree
+
     for (size_t i = 0; i < NUM_EYES; ++i)
     {
         const fabric::Eye eye = static_cast<Eye>(1 << i);
@@ -1046,6 +1052,16 @@ void Compound::deactivate(const uint32_t eyes)
     }
 }
 
+void Compound::storeEqualizerState()
+{
+    EqualizerState& state = getConfig()->getEqualizerState();
+    for (const Equalizer* equalizer : _equalizers)
+        equalizer->storeState(state);
+
+    for (Compound* child : _children)
+        child->storeEqualizerState();
+}
+
 void Compound::init()
 {
     CompoundInitVisitor initVisitor;
@@ -1158,7 +1174,7 @@ void Compound::restore()
 //---------------------------------------------------------------------------
 // pre-render compound state update
 //---------------------------------------------------------------------------
-void Compound::update(const uint32_t frameNumber)
+void Compound::update(const uint128_t& frameID, const uint32_t frameNumber)
 {
     // https://github.com/Eyescale/Equalizer/issues/76
     CompoundUpdateActivateVisitor updateActivateVisitor(frameNumber);
@@ -1167,18 +1183,39 @@ void Compound::update(const uint32_t frameNumber)
     CompoundUpdateDataVisitor updateDataVisitor(frameNumber);
     accept(updateDataVisitor);
 
-    CompoundUpdateOutputVisitor updateOutputVisitor(frameNumber);
+    CompoundUpdateOutputVisitor updateOutputVisitor(frameID, frameNumber);
     accept(updateOutputVisitor);
 
     const FrameMap& outputFrames = updateOutputVisitor.getOutputFrames();
     const TileQueueMap& outputQueues = updateOutputVisitor.getOutputQueues();
     CompoundUpdateInputVisitor updateInputVisitor(outputFrames, outputQueues);
     accept(updateInputVisitor);
+    updateInputVisitor.updatePreComposition();
+
+    // render cached contributions if a new input did not receive the data
+    for (FrameMapCIter i = outputFrames.begin(); i != outputFrames.end(); ++i)
+    {
+        const Frame* frame = i->second;
+        if (frame->isRetained() && !frame->hasRetainedInputs())
+        {
+            Compound* compound = frame->getCompound();
+            compound->getChannel()->getResultCache().invalidate(compound);
+        }
+    }
 
     // commit output frames after input frames have been set
     for (FrameMapCIter i = outputFrames.begin(); i != outputFrames.end(); ++i)
     {
         Frame* frame = i->second;
+        Compound* compound = frame->getCompound();
+        if (frame->isRetained() &&
+            (!frame->hasRetainedInputs() ||
+             (!frame->getHoldData() &&
+              !compound->getChannel()->getResultCache().isCached(
+                  compound, frameNumber))))
+        {
+            frame->cycleRetainedData(frameNumber, compound);
+        }
         frame->commit();
     }
 
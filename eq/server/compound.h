@@ -407,6 +407,9 @@ public:
     /** @internal Deactivate the given eyes for the the compound tree. */
     void deactivate(const uint32_t eyes);
 
+    /** @internal Store the learned state of all equalizers of the tree. */
+    void storeEqualizerState();
+
     /**
      * @return if the compound is activated for selected eye
      and current (DPlex).
@@ -450,7 +453,7 @@ public:
      *
      * The compound's parameters for the next frame are computed.
      */
-    void update(const uint32_t frameNumber);
+    void update(const uint128_t& frameID, const uint32_t frameNumber);
 
     /** Update the inherit data of this compound. */
     void updateInheritData(const uint32_t frameNumber);
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2007-2012, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2007-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2011, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -21,15 +21,70 @@
 #include "frame.h"
 #include "frameData.h"
 #include "log.h"
+#include "node.h"
 #include "server.h"
 #include "tileQueue.h"
 
 #include <eq/fabric/iAttribute.h>
 
+#include <map>
+
 namespace eq
 {
 namespace server
 {
+namespace
+{
+/**
+ * @return the only input frame of a DB output frame rendered on another node,
+ *         or 0 if the output can't be pre-composited with others.
+ */
+const Frame* _getPreCompositeInput(const Frame* output)
+{
+    const FrameData* data = output->getMasterData();
+    if (!data || output->isRetained() ||
+        !output->getCompound()->getInputTileQueues().empty() ||
+        data->getType() != Frame::TYPE_MEMORY ||
+        !(data->getBuffers() & Frame::Buffer::color) ||
+        !(data->getBuffers() & Frame::Buffer::depth))
+    {
+        return 0;
+    }
+
+    const Frame* input = 0;
+    for (unsigned i = 0; i < NUM_EYES; ++i)
+    {
+        const Frames& inputs = output->getInputFrames(Eye(1 << i));
+        if (inputs.empty())
+            continue;
+        if (inputs.size() != 1 || (input && input != inputs.front()))
+            return 0;
+        input = inputs.front();
+    }
+
+    if (!input || input->getNode() == output->getNode())
+        return 0;
+    return input;
+}
+
+/** @return true if both outputs are merged into the same pixels. */
+bool _isPreCompositeMember(const Frame* leader, const Frame* leaderInput,
+                           const Frame* output, const Frame* input)
+{
+    for (unsigned i = 0; i < NUM_EYES; ++i)
+        if (leader->hasData(Eye(1 << i)) != output->hasData(Eye(1 << i)))
+            return false;
+
+    const FrameData* leaderData = leader->getMasterData();
+    const FrameData* data = output->getMasterData();
+    return output->getZoom() == leader->getZoom() &&
+           data->getPixelViewport() == leaderData->getPixelViewport() &&
+           data->getZoom() == leaderData->getZoom() &&
+           input->getOffset() == leaderInput->getOffset() &&
+           input->getZoom() == leaderInput->getZoom();
+}
+}
+
 CompoundUpdateInputVisitor::CompoundUpdateInputVisitor(
     const Compound::FrameMap& outputFrames,
     const Compound::TileQueueMap& outputQueues)
@@ -161,6 +216,59 @@ void CompoundUpdateInputVisitor::_updateFrames(Compound* compound)
     }
 }
 
+void CompoundUpdateInputVisitor::updatePreComposition()
+{
+    // candidate outputs with their input, by source node and destination
+    typedef std::pair<const Node*, const Compound*> Key;
+    typedef std::vector<std::pair<Frame*, const Frame*>> Outputs;
+    std::map<Key, Outputs> candidates;
+
+    for (const auto& i : _outputFrames)
+    {
+        Frame* output = i.second;
+        for (unsigned j = 0; j < NUM_EYES; ++j)
+            output->setPreComposite(Eye(1 << j), uint128_t(), 0);
+
+        const Frame* input = _getPreCompositeInput(output);
+        if (input)
+            candidates[Key(output->getNode(), input->getCompound())].push_back(
+                std::make_pair(output, input));
+    }
+
+    for (const auto& i : candidates)
+    {
+        const Frame* leader = i.second.front().first;
+        const Frame* leaderInput = i.second.front().second;
+        Outputs members;
+        for (const auto& candidate : i.second)
+            if (_isPreCompositeMember(leader, leaderInput, candidate.first,
+                                      candidate.second))
+            {
+                members.push_back(candidate);
+            }
+
+        if (members.size() < 2)
+            continue;
+
+        for (unsigned j = 0; j < NUM_EYES; ++j)
+        {
+            const Eye eye = Eye(1 << j);
+            const FrameData* group = leader->getData(eye);
+            if (!group)
+                continue;
+
+            for (const auto& member : members)
+                member.first->setPreComposite(eye, group->getID(),
+                                              uint32_t(members.size()));
+        }
+
+        LBLOG(LOG_ASSEMBLY) << "Pre-composite " << members.size()
+                            << " outputs on node " << i.first.first->getName()
+                            << " for input frame \"" << leaderInput->getName()
+                            << "\"" << std::endl;
+    }
+}
+
 void CompoundUpdateInputVisitor::_updateZoom(const Compound* compound,
                                              Frame* frame,
                                              const Frame* outputFrame)
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2007-2011, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2007-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2011, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -36,6 +36,13 @@ public:
     /** Visit all compounds. */
     virtual VisitorResult visit(Compound* compound);
 
+    /**
+     * Group the DB outputs rendered on the same node for the same remote input
+     * frame, to be depth-composited on that node before transmission. Called
+     * after all compounds have been visited.
+     */
+    void updatePreComposition();
+
 private:
     const Compound::FrameMap& _outputFrames;
     const Compound::TileQueueMap& _outputQueues;
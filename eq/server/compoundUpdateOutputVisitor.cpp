@@ -18,6 +18,7 @@
 
 #include "compoundUpdateOutputVisitor.h"
 
+#include "channel.h"
 #include "config.h"
 #include "frame.h"
 #include "frameData.h"
@@ -35,8 +36,10 @@ namespace eq
 {
 namespace server
 {
-CompoundUpdateOutputVisitor::CompoundUpdateOutputVisitor(const uint32_t frame)
-    : _frameNumber(frame)
+CompoundUpdateOutputVisitor::CompoundUpdateOutputVisitor(
+    const uint128_t& frameID, const uint32_t frame)
+    : _frameID(frameID)
+    , _frameNumber(frame)
 {
 }
 
@@ -83,10 +86,13 @@ void CompoundUpdateOutputVisitor::_updateFrames(Compound* compound)
     if (outputFrames.empty())
         compound->unsetInheritTask(fabric::TASK_READBACK);
 
-    const Channel* channel = compound->getChannel();
+    Channel* channel = compound->getChannel();
     if (!compound->testInheritTask(fabric::TASK_READBACK) || !channel)
         return;
 
+    const bool cached =
+        channel->getResultCache().lookup(compound, _frameID, _frameNumber);
+
     for (FramesCIter i = outputFrames.begin(); i != outputFrames.end(); ++i)
     {
         //----- Check uniqueness of output frame name
@@ -101,6 +107,20 @@ void CompoundUpdateOutputVisitor::_updateFrames(Compound* compound)
             continue;
         }
 
+        //----- Reuse the frame data of an unchanged contribution or of an
+        //      output refreshed at a lower rate
+        if ((cached || frame->getHoldData()) &&
+            frame->retainData(_frameNumber))
+        {
+            _outputFrames[name] = frame;
+            LBLOG(LOG_ASSEMBLY)
+                << "Retain output frame \"" << name << "\" data id "
+                << frame->getMasterData()->getID() << " on channel \""
+                << channel->getName() << "\"" << std::endl;
+            continue;
+        }
+        LBASSERT(!cached);
+
         //----- compute readback area
         const Viewport& frameVP = frame->getViewport();
         const PixelViewport& inheritPVP = compound->getInheritPixelViewport();
@@ -33,7 +33,8 @@ namespace server
 class CompoundUpdateOutputVisitor : public CompoundVisitor
 {
 public:
-    explicit CompoundUpdateOutputVisitor(const uint32_t frameNumber);
+    CompoundUpdateOutputVisitor(const uint128_t& frameID,
+                                const uint32_t frameNumber);
     virtual ~CompoundUpdateOutputVisitor() {}
     /** Visit all compounds. */
     virtual VisitorResult visit(Compound* compound);
@@ -49,6 +50,7 @@ public:
     }
 
 private:
+    const uint128_t _frameID;
     const uint32_t _frameNumber;
 
     Compound::BarrierMap _swapBarriers;
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric Stalder@gmail.com>
  *                          Daniel Nachbaur <danielnachbaur@gmail.com>
  *
@@ -30,6 +30,7 @@
 #include "log.h"
 #include "node.h"
 #include "observer.h"
+#include "residentPool.h"
 #include "segment.h"
 #include "server.h"
 #include "view.h"
@@ -42,12 +43,15 @@
 
 #include <co/objectICommand.h>
 
+#include <boost/filesystem/path.hpp>
 #include <boost/foreach.hpp>
+#include <lunchbox/scopedMutex.h>
 #include <lunchbox/sleep.h>
 
 #include "channelStopFrameVisitor.h"
 #include "configDeregistrator.h"
 #include "configRegistrator.h"
+#include "configUpdateCheckVisitor.h"
 #include "configUpdateSyncVisitor.h"
 #include "configUpdateVisitor.h"
 #include "nodeFailedVisitor.h"
@@ -173,6 +177,11 @@ public:
         return TRAVERSE_CONTINUE;
     }
 };
+
+const char* _getEqualizerStateFile()
+{
+    return getenv("EQ_EQUALIZER_STATE");
+}
 }
 
 const Channel* Config::findChannel(const std::string& name) const
@@ -583,6 +592,9 @@ bool Config::_connectNodes()
 {
     bool success = true;
     lunchbox::Clock clock;
+    Nodes starting;
+    const boost::filesystem::path renderClient(getRenderClient());
+    ResidentPool residents(renderClient.stem().string());
     const Nodes& nodes = getNodes();
     for (Nodes::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
     {
@@ -590,7 +602,9 @@ bool Config::_connectNodes()
         if (!node->isActive())
             continue;
 
-        if (!node->connect())
+        if (!node->isApplicationNode() && node->isStopped() && !node->getNode())
+            starting.push_back(node);
+        if (!node->connect(residents))
             success = false;
     }
 
@@ -601,6 +615,16 @@ bool Config::_connectNodes()
             success = false;
     }
 
+    if (!starting.empty())
+    {
+        size_t nResident = 0;
+        for (const Node* node : starting)
+            if (node->isResident() && node->getNode())
+                ++nResident;
+        LBINFO << "Started " << starting.size() << " render clients ("
+               << nResident << " resident) in " << clock.getTimef() << " ms"
+               << std::endl;
+    }
     return success;
 }
 
@@ -785,6 +809,10 @@ bool Config::_init(const uint128_t& initID)
     _finishedFrame = 0;
     _initID = initID;
 
+    const char* stateFile = _getEqualizerStateFile();
+    if (stateFile)
+        _equalizerState.load(stateFile);
+
     for (auto compound : _compounds)
         compound->init();
 
@@ -807,7 +835,7 @@ bool Config::_init(const uint128_t& initID)
 
     // Needed to set up active state for first LB update
     for (CompoundsCIter i = _compounds.begin(); i != _compounds.end(); ++i)
-        (*i)->update(0);
+        (*i)->update(uint128_t(), 0);
 
     // Update equalizer properties in views
     UpdateEqualizersVisitor updater;
@@ -818,6 +846,13 @@ bool Config::_init(const uint128_t& initID)
     return true;
 }
 
+void Config::saveEqualizerState() const
+{
+    const char* stateFile = _getEqualizerStateFile();
+    if (stateFile)
+        _equalizerState.save(stateFile);
+}
+
 //---------------------------------------------------------------------------
 // exit
 //---------------------------------------------------------------------------
@@ -829,6 +864,11 @@ bool Config::exit()
     LBASSERT(_state == STATE_RUNNING || _state == STATE_INITIALIZING);
     _state = STATE_EXITING;
 
+    // learned state of all compounds, including configs without canvases
+    for (Compound* compound : _compounds)
+        compound->storeEqualizerState();
+    saveEqualizerState();
+
     const Canvases& canvases = getCanvases();
     for (Canvases::const_iterator i = canvases.begin(); i != canvases.end();
          ++i)
@@ -877,7 +917,7 @@ void Config::_startFrame(const uint128_t& frameID)
          i != _compounds.end(); ++i)
     {
         Compound* compound = *i;
-        compound->update(_currentFrame);
+        compound->update(frameID, _currentFrame);
     }
 
     ConfigUpdateDataVisitor configDataVisitor;
@@ -917,6 +957,9 @@ void Config::_verifyFrameFinished(const uint32_t frameNumber)
 
 void Config::notifyNodeFrameFinished(const uint32_t frameNumber)
 {
+    // called from the command thread, while _updateRunning may start or stop
+    // nodes from the main thread
+    lunchbox::ScopedWrite mutex(_nodeStateLock);
     if (_finishedFrame >= frameNumber) // node finish already done
         return;
 
@@ -1038,19 +1081,39 @@ bool Config::_cmdUpdate(co::ICommand& cmd)
     if (!_needsFinish)
     {
         send(node, fabric::CMD_CONFIG_UPDATE_VERSION)
-            << getVersion() << versionID << finishID << LB_UNDEFINED_UINT32;
+            << getVersion() << versionID << finishID << LB_UNDEFINED_UINT32
+            << false;
         return true;
     }
 
+    // Only nodes with entities to initialize or exit need to be idle, unless
+    // the application node is affected, which waits for all frames.
+    ConfigUpdateCheckVisitor check;
+    accept(check);
+    const bool drainAll = check.isApplicationNodeAffected();
+    const Nodes& affected = check.getAffectedNodes();
+
     co::LocalNodePtr localNode = getLocalNode();
     lunchbox::Request<void> request = localNode->registerRequest<void>();
 
-    send(node, fabric::CMD_CONFIG_UPDATE_VERSION) << getVersion() << versionID
-                                                  << finishID << request;
+    send(node, fabric::CMD_CONFIG_UPDATE_VERSION)
+        << getVersion() << versionID << finishID << request << drainAll;
 
-    _flushAllFrames();
-    _finishedFrame.waitEQ(_currentFrame); // wait for render clients idle
-    request.wait();                       // wait for app sync
+    lunchbox::Clock clock;
+    if (drainAll)
+    {
+        _flushAllFrames();
+        _finishedFrame.waitEQ(_currentFrame); // wait for render clients idle
+    }
+    else
+    {
+        for (Node* affectedNode : affected)
+            affectedNode->flushFrames(_currentFrame);
+        for (const Node* affectedNode : affected)
+            affectedNode->waitFrameFinished(_currentFrame);
+    }
+    request.wait(); // wait for app sync
+    const float drainTime = clock.getTimef();
     _needsFinish = false;
 
     const bool canFail = (getIAttribute(IATTR_ROBUSTNESS) != OFF);
@@ -1061,6 +1124,11 @@ bool Config::_cmdUpdate(co::ICommand& cmd)
         exit();
     }
 
+    LBINFO << "Reconfiguration stalled "
+           << (drainAll ? "all" : std::to_string(affected.size())) << " of "
+           << getNodes().size() << " nodes for " << clock.getTimef()
+           << " ms, " << drainTime << " ms to finish frames" << std::endl;
+
     const uint128_t version = commit();
     send(command.getRemoteNode(), fabric::CMD_CONFIG_UPDATE_REPLY)
         << version << command.read<uint32_t>() << result;
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Daniel Nachbaur <danielnachbaur@gmail.com>
  *                          Cedric Stalder <cedric Stalder@gmail.com>
  *
@@ -20,13 +20,15 @@
 #ifndef EQSERVER_CONFIG_H
 #define EQSERVER_CONFIG_H
 
-#include "server.h" // used in inline method
+#include "equalizers/equalizerState.h" // member
+#include "server.h"                      // used in inline method
 #include "state.h"  // enum
 #include "types.h"
 #include "visitorResult.h" // enum
 #include <eq/server/api.h>
 
 #include <eq/fabric/config.h> // base class
+#include <lunchbox/lock.h>    // member
 #include <lunchbox/monitor.h> // member
 
 #include <iostream>
@@ -193,10 +195,24 @@ public:
     /** Initialize the given canvas in a running configuration */
     virtual void updateCanvas(Canvas* canvas);
 
+    /** @return the learned state of the load equalizers. */
+    EqualizerState& getEqualizerState() { return _equalizerState; }
+    const EqualizerState& getEqualizerState() const { return _equalizerState; }
+
+    /** Write the learned equalizer state to EQ_EQUALIZER_STATE, if set. */
+    void saveEqualizerState() const;
+
     /** Request a finish of outstanding frames on next frame */
     void postNeedsFinish() { _needsFinish = true; }
+    /** @internal @return the last started frame */
+    uint32_t getCurrentFrame() const { return _currentFrame; }
     /** @internal @return the last finished frame */
     uint32_t getFinishedFrame() const { return _finishedFrame.get(); }
+    /**
+     * @internal @return the lock to hold while a node enters or leaves the
+     *                   running state.
+     */
+    lunchbox::Lock& getNodeStateLock() const { return _nodeStateLock; }
     /** @internal */
     virtual VisitorResult _acceptCompounds(ConfigVisitor& visitor);
     /** @internal */
@@ -245,10 +261,15 @@ private:
     /** The last finished frame, or 0. */
     lunchbox::Monitor<uint32_t> _finishedFrame;
 
+    /** Serializes node run state changes with notifyNodeFrameFinished. */
+    mutable lunchbox::Lock _nodeStateLock;
+
     State _state;
 
     bool _needsFinish; //!< true after runtime changes
 
+    EqualizerState _equalizerState;
+
     int64_t _lastCheck;
 
     struct Private;
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2011-2015, Stefan Eilemann <eile@eyescale.h>
+/* Copyright (c) 2011-2017, Stefan Eilemann <eile@eyescale.h>
  *               2012-2014, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -143,6 +143,9 @@ void Display::discoverLocal(Config* config, const ConfigParams& params)
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_2D_STATIC);
         names.push_back(EQ_SERVER_CONFIG_LAYOUT_SUBPIXEL);
 
+        if (params.getFlags() & fabric::ConfigParams::FLAG_OFFLINE)
+            names.push_back(EQ_SERVER_CONFIG_LAYOUT_DPLEX);
+
         if (params.getFlags() & fabric::ConfigParams::FLAG_MULTIPROCESS_DB &&
             nodes.size() > 1)
         {
@@ -22,6 +22,7 @@
 #include "../compound.h"
 #include "../configVisitor.h"
 #include "../connectionDescription.h"
+#include "../equalizers/dplexEqualizer.h"
 #include "../equalizers/loadEqualizer.h"
 #include "../frame.h"
 #include "../layout.h"
@@ -570,6 +571,8 @@ Compound* Resources::_addMonoCompound(Compound* root, const Channels& channels,
     }
     else if (name == EQ_SERVER_CONFIG_LAYOUT_SUBPIXEL)
         compound = _addSubpixelCompound(root, activeChannels);
+    else if (name == EQ_SERVER_CONFIG_LAYOUT_DPLEX)
+        compound = _addDPlexCompound(root, activeChannels);
     else
     {
         LBASSERTINFO(false, "Unimplemented mode " << name);
@@ -851,6 +854,18 @@ Compound* Resources::_addSubpixelCompound(Compound* root,
     return compound;
 }
 
+Compound* Resources::_addDPlexCompound(Compound* root,
+                                       const Channels& channels)
+{
+    Compound* compound = new Compound(root);
+    compound->setName(EQ_SERVER_CONFIG_LAYOUT_DPLEX);
+    compound->addEqualizer(new DPlexEqualizer);
+
+    // Each frame is rendered by the first free source and assembled in order
+    _addSources(compound, channels);
+    return compound;
+}
+
 const Compounds& Resources::_addSources(Compound* compound,
                                         const Channels& channels,
                                         const bool destChannelFrame)
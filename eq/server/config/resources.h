@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2011-2013, Stefan Eilemann <eile@eyescale.h>
+/* Copyright (c) 2011-2017, Stefan Eilemann <eile@eyescale.h>
  *                    2012, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -29,6 +29,7 @@
 #define EQ_SERVER_CONFIG_LAYOUT_DB_DS "DBDirectSend"
 #define EQ_SERVER_CONFIG_LAYOUT_DB_2D "DB_2D"
 #define EQ_SERVER_CONFIG_LAYOUT_SUBPIXEL "Subpixel"
+#define EQ_SERVER_CONFIG_LAYOUT_DPLEX "DPlex"
 
 namespace eq
 {
@@ -60,6 +61,7 @@ private:
     static Compound* _addDB2DCompound(Compound* root, const Channels& channels,
                                       fabric::ConfigParams params);
     static Compound* _addSubpixelCompound(Compound* root, const Channels&);
+    static Compound* _addDPlexCompound(Compound* root, const Channels&);
     static const Compounds& _addSources(Compound* compound, const Channels&,
                                         const bool destChannelFrame = false);
     static void _fill2DCompound(Compound* compound, const Channels& channels);
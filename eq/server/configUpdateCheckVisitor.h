@@ -0,0 +1,107 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_CONFIGUPDATECHECKVISITOR_H
+#define EQSERVER_CONFIGUPDATECHECKVISITOR_H
+
+#include "configVisitor.h" // base class
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+/**
+ * Finds the running nodes affected by a runtime reconfiguration.
+ *
+ * A node is affected if any entity in its subtree is initialized, exited or
+ * deleted by the next ConfigUpdateVisitor pass. Only these nodes need to be
+ * idle during the update, all others may continue with their queued frames.
+ */
+class ConfigUpdateCheckVisitor : public ConfigVisitor
+{
+public:
+    ConfigUpdateCheckVisitor()
+        : _changed(false)
+        , _appNodeAffected(false)
+    {
+    }
+    virtual ~ConfigUpdateCheckVisitor() {}
+    VisitorResult visitPre(Node* node) override
+    {
+        _changed = _needsUpdate(node);
+        return TRAVERSE_CONTINUE;
+    }
+
+    VisitorResult visitPost(Node* node) override
+    {
+        const uint32_t state = node->getState() & ~STATE_DELETE;
+        if (!_changed || state != STATE_RUNNING)
+            return TRAVERSE_CONTINUE;
+
+        _affected.push_back(node);
+        if (node->isApplicationNode())
+            _appNodeAffected = true;
+        return TRAVERSE_CONTINUE;
+    }
+
+    VisitorResult visitPre(Pipe* pipe) override { return _check(pipe); }
+    VisitorResult visitPre(Window* window) override { return _check(window); }
+    VisitorResult visit(Channel* channel) override { return _check(channel); }
+    /** @return the running nodes which have to finish all frames. */
+    const Nodes& getAffectedNodes() const { return _affected; }
+
+    /** @return true if the application node has to finish all frames. */
+    bool isApplicationNodeAffected() const { return _appNodeAffected; }
+private:
+    Nodes _affected;
+    bool _changed;
+    bool _appNodeAffected;
+
+    template <class T>
+    VisitorResult _check(const T* entity)
+    {
+        if (_changed)
+            return TRAVERSE_PRUNE;
+        _changed = _needsUpdate(entity);
+        return TRAVERSE_CONTINUE;
+    }
+
+    template <class T>
+    static bool _needsUpdate(const T* entity)
+    {
+        const uint32_t state = entity->getState();
+        if (state & STATE_DELETE)
+            return true;
+
+        switch (state)
+        {
+        case STATE_STOPPED:
+            return entity->isActive();
+        case STATE_RUNNING:
+        case STATE_FAILED:
+            return !entity->isActive();
+        default:
+            return true;
+        }
+    }
+};
+}
+}
+}
+
+#endif // EQSERVER_CONFIGUPDATECHECKVISITOR_H
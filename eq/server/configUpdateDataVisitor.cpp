@@ -1,5 +1,4 @@
-
-/* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -18,19 +17,174 @@
 #include "configUpdateDataVisitor.h"
 
 #include "channel.h"
+#include "compound.h"
+#include "compoundVisitor.h"
+#include "frame.h"
+#include "log.h"
 #include "node.h"
 #include "pipe.h"
 #include "view.h"
 #include "window.h"
 
+#include <algorithm>
+
 namespace eq
 {
 namespace server
 {
+namespace
+{
+/** The position of a channel's tasks on the critical path of a frame. */
+enum Rank
+{
+    RANK_TRANSMIT, //!< Readback of output frames needed by another pipe
+    RANK_DRAW,     //!< Local rendering and readback
+    RANK_ASSEMBLE  //!< Assembly of input frames
+};
+
+/**
+ * Finds the most critical task of a channel in the compound tree, and the
+ * channels of the same pipe assembling its output frames.
+ */
+class ChannelRankVisitor : public CompoundVisitor
+{
+public:
+    explicit ChannelRankVisitor(const Channel* channel)
+        : _channel(channel)
+        , _rank(RANK_DRAW)
+    {
+    }
+
+    VisitorResult visit(const Compound* compound) override
+    {
+        if (compound->getChannel() != _channel ||
+            compound->getInheritTasks() == fabric::TASK_NONE)
+        {
+            return TRAVERSE_CONTINUE;
+        }
+
+        for (size_t i = 0; i < NUM_EYES; ++i)
+        {
+            const Eye eye = Eye(1 << i);
+            if (!compound->isInheritActive(eye))
+                continue;
+
+            if (_updateOutputs(compound, eye))
+                _rank = RANK_TRANSMIT;
+            else if (_rank != RANK_TRANSMIT &&
+                     compound->testInheritTask(fabric::TASK_ASSEMBLE) &&
+                     !compound->getInputFrames().empty())
+            {
+                _rank = RANK_ASSEMBLE;
+            }
+        }
+        return TRAVERSE_CONTINUE;
+    }
+
+    Rank getRank() const { return _rank; }
+    const std::vector<const Channel*>& getConsumers() const
+    {
+        return _consumers;
+    }
+
+private:
+    const Channel* const _channel;
+    Rank _rank;
+    std::vector<const Channel*> _consumers;
+
+    /** @return true if an output frame is needed by another pipe. */
+    bool _updateOutputs(const Compound* compound, const Eye eye)
+    {
+        if (!compound->testInheritTask(fabric::TASK_READBACK))
+            return false;
+
+        const Pipe* pipe = _channel->getPipe();
+        bool transmitting = false;
+        for (const Frame* output : compound->getOutputFrames())
+        {
+            if (!output->hasData(eye))
+                continue;
+
+            for (const Frame* input : output->getInputFrames(eye))
+            {
+                const Channel* channel = input->getChannel();
+                if (!channel || channel == _channel)
+                    continue;
+                if (channel->getPipe() != pipe)
+                    transmitting = true;
+                else if (std::find(_consumers.begin(), _consumers.end(),
+                                   channel) == _consumers.end())
+                {
+                    _consumers.push_back(channel);
+                }
+            }
+        }
+        return transmitting;
+    }
+};
+
+typedef std::vector<size_t> Indices;
+
+/**
+ * Order items topologically by their dependencies. Of the items ready to run,
+ * the one with the lowest rank, and the earliest one on equal rank, is
+ * scheduled first.
+ *
+ * @param ranks the rank of each item in traversal order.
+ * @param successors the items depending on each item.
+ * @return the scheduled order, or the traversal order for cyclic dependencies.
+ */
+Indices _schedule(const std::vector<uint32_t>& ranks,
+                  const std::vector<Indices>& successors)
+{
+    const size_t size = ranks.size();
+    std::vector<size_t> nPredecessors(size, 0);
+    for (const Indices& items : successors)
+        for (const size_t item : items)
+            ++nPredecessors[item];
+
+    std::vector<bool> scheduled(size, false);
+    Indices order;
+    while (order.size() < size)
+    {
+        size_t next = size;
+        for (size_t i = 0; i < size; ++i)
+            if (!scheduled[i] && nPredecessors[i] == 0 &&
+                (next == size || ranks[i] < ranks[next]))
+            {
+                next = i;
+            }
+
+        if (next == size)
+        {
+            LBLOG(LOG_TASKS) << "Cyclic frame dependencies within a pipe, "
+                             << "using traversal order" << std::endl;
+            order.clear();
+            for (size_t i = 0; i < size; ++i)
+                order.push_back(i);
+            return order;
+        }
+
+        scheduled[next] = true;
+        order.push_back(next);
+        for (const size_t item : successors[next])
+            --nPredecessors[item];
+    }
+    return order;
+}
+
+/** @return the number of channel tasks until the last transmitting one. */
+uint32_t _getLastTransmit(const std::vector<uint32_t>& ranks)
+{
+    for (size_t i = ranks.size(); i > 0; --i)
+        if (ranks[i - 1] == RANK_TRANSMIT)
+            return uint32_t(i);
+    return 0;
+}
+}
+
 ConfigUpdateDataVisitor::ConfigUpdateDataVisitor()
-    : _lastDrawChannel(0)
-    , _lastDrawWindow(0)
-    , _lastDrawPipe(0)
+    : _lastDrawPipe(0)
 {
 }
 
@@ -45,37 +199,133 @@ VisitorResult ConfigUpdateDataVisitor::visitPost(Node* node)
     return TRAVERSE_CONTINUE;
 }
 
+bool ConfigUpdateDataVisitor::_isConsumer(const Channel* producer,
+                                          const Channel* consumer) const
+{
+    const ChannelConsumers::const_iterator i = _consumers.find(producer);
+    return i != _consumers.end() &&
+           std::find(i->second.begin(), i->second.end(), consumer) !=
+               i->second.end();
+}
+
 VisitorResult ConfigUpdateDataVisitor::visitPre(Pipe*)
 {
-    _lastDrawWindow = 0;
+    _windows.clear();
+    _tasks.clear();
+    _consumers.clear();
     return TRAVERSE_CONTINUE;
 }
 VisitorResult ConfigUpdateDataVisitor::visitPost(Pipe* pipe)
 {
-    pipe->setLastDrawWindow(_lastDrawWindow);
-    if (_lastDrawWindow)
+    // A window runs before the windows assembling its output
+    Ranks ranks;
+    std::vector<Indices> successors(_windows.size());
+    for (size_t i = 0; i < _windows.size(); ++i)
+    {
+        ranks.push_back(_windows[i].rank);
+        for (size_t j = 0; j < _windows.size(); ++j)
+        {
+            if (i == j)
+                continue;
+            for (const Channel* producer : _windows[i].window->getChannels())
+                for (const Channel* consumer :
+                     _windows[j].window->getChannels())
+                {
+                    if (_isConsumer(producer, consumer) &&
+                        std::find(successors[i].begin(), successors[i].end(),
+                                  j) == successors[i].end())
+                    {
+                        successors[i].push_back(j);
+                    }
+                }
+        }
+    }
+
+    // The last draw window has to be last in the scheduled order
+    Windows schedule;
+    Ranks scheduledTasks;
+    const Window* lastDrawWindow = 0;
+    for (const size_t i : _schedule(ranks, successors))
+    {
+        const RankedWindow& window = _windows[i];
+        schedule.push_back(window.window);
+        scheduledTasks.insert(scheduledTasks.end(), window.tasks.begin(),
+                              window.tasks.end());
+        if (window.window->getLastDrawChannel())
+            lastDrawWindow = window.window;
+    }
+
+    const uint32_t before = _getLastTransmit(_tasks);
+    const uint32_t after = _getLastTransmit(scheduledTasks);
+    LBLOG(LOG_TASKS) << "Last remote readback of " << pipe->getName()
+                     << " moved from channel task " << before << " to "
+                     << after << " of " << _tasks.size() << std::endl;
+
+    pipe->setSchedule(schedule);
+    pipe->setCriticalPath(before, after);
+    pipe->setLastDrawWindow(lastDrawWindow);
+    if (lastDrawWindow)
         _lastDrawPipe = pipe;
     return TRAVERSE_CONTINUE;
 }
 
 VisitorResult ConfigUpdateDataVisitor::visitPre(Window*)
 {
-    _lastDrawChannel = 0;
+    _channels.clear();
     return TRAVERSE_CONTINUE;
 }
 VisitorResult ConfigUpdateDataVisitor::visitPost(Window* window)
 {
-    window->setLastDrawChannel(_lastDrawChannel);
-    if (_lastDrawChannel)
-        _lastDrawWindow = window;
+    // A channel runs before the channels assembling its output
+    Ranks ranks;
+    std::vector<Indices> successors(_channels.size());
+    for (size_t i = 0; i < _channels.size(); ++i)
+    {
+        ranks.push_back(_channels[i].first);
+        for (size_t j = 0; j < _channels.size(); ++j)
+            if (i != j && _isConsumer(_channels[i].second, _channels[j].second))
+                successors[i].push_back(j);
+    }
+
+    // The last draw channel has to be last in the scheduled order
+    RankedWindow ranked = {RANK_ASSEMBLE, window, Ranks()};
+    Channels schedule;
+    const Channel* lastDrawChannel = 0;
+    for (const size_t i : _schedule(ranks, successors))
+    {
+        const RankedChannel& channel = _channels[i];
+        schedule.push_back(channel.second);
+        if (channel.second->isRunning())
+            ranked.tasks.push_back(channel.first);
+        if (channel.second->getLastDrawCompound())
+            lastDrawChannel = channel.second;
+        ranked.rank = std::min(ranked.rank, channel.first);
+    }
+
+    window->setSchedule(schedule);
+    window->setLastDrawChannel(lastDrawChannel);
+    if (!window->isRunning())
+        ranked.tasks.clear();
+    _windows.push_back(ranked);
     return TRAVERSE_CONTINUE;
 }
 
 VisitorResult ConfigUpdateDataVisitor::visit(Channel* channel)
 {
-    if (channel->getLastDrawCompound())
-        _lastDrawChannel = channel;
+    ChannelRankVisitor visitor(channel);
+    if (channel->isRunning())
+    {
+        const Compounds& compounds = channel->getCompounds();
+        for (const Compound* compound : compounds)
+            compound->accept(visitor);
+
+        if (!visitor.getConsumers().empty())
+            _consumers[channel] = visitor.getConsumers();
+        if (channel->getWindow()->isRunning())
+            _tasks.push_back(visitor.getRank());
+    }
 
+    _channels.push_back(RankedChannel(visitor.getRank(), channel));
     return TRAVERSE_CONTINUE;
 }
 }
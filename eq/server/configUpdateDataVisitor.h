@@ -1,5 +1,4 @@
-
-/* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -20,11 +19,23 @@
 
 #include "configVisitor.h" // base class
 
+#include <map>
+#include <vector>
+
 namespace eq
 {
 namespace server
 {
-/** The config visitor updating config data after the compound update */
+/**
+ * The config visitor updating config data after the compound update.
+ *
+ * Besides the last draw entities, it computes the task order of each pipe for
+ * the frame. Channels and windows are ordered topologically by the output to
+ * input frame dependencies within the pipe. Among the ready ones, those reading
+ * back frames needed by another pipe are scheduled first, followed by local
+ * draws and finally assembly, so that remote pipes waiting for input frames are
+ * not delayed by local work.
+ */
 class ConfigUpdateDataVisitor : public ConfigVisitor
 {
 public:
@@ -41,9 +52,31 @@ public:
     // No need to traverse compounds
     VisitorResult visitPre(Compound*) override { return TRAVERSE_PRUNE; }
 private:
-    const Channel* _lastDrawChannel;
-    const Window* _lastDrawWindow;
     const Pipe* _lastDrawPipe;
+
+    typedef std::vector<uint32_t> Ranks;
+    typedef std::pair<uint32_t, Channel*> RankedChannel;
+    typedef std::vector<RankedChannel> RankedChannels;
+    typedef std::vector<const Channel*> ConstChannels;
+    typedef std::map<const Channel*, ConstChannels> ChannelConsumers;
+
+    struct RankedWindow
+    {
+        uint32_t rank;
+        Window* window;
+        Ranks tasks; //!< channel task ranks in scheduled order
+    };
+    typedef std::vector<RankedWindow> RankedWindows;
+
+    RankedChannels _channels; //!< of the current window
+    RankedWindows _windows;   //!< of the current pipe
+    Ranks _tasks;             //!< channel task ranks in traversal order
+
+    /** Channels of the current pipe assembling the output of a channel. */
+    ChannelConsumers _consumers;
+
+    /** @return true if consumer assembles an output frame of producer. */
+    bool _isConsumer(const Channel* producer, const Channel* consumer) const;
 };
 }
 }
@@ -0,0 +1,154 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "dplexEqualizer.h"
+
+#include "../channel.h"
+#include "../compound.h"
+#include "../log.h"
+
+#include <lunchbox/debug.h>
+
+namespace eq
+{
+namespace server
+{
+DPlexEqualizer::DPlexEqualizer()
+{
+    LBINFO << "New DPlexEqualizer @" << (void*)this << std::endl;
+}
+
+DPlexEqualizer::DPlexEqualizer(const DPlexEqualizer& from)
+    : Equalizer(from)
+{
+}
+
+DPlexEqualizer::~DPlexEqualizer()
+{
+    attach(0);
+}
+
+void DPlexEqualizer::attach(Compound* compound)
+{
+    _exit();
+    Equalizer::attach(compound);
+}
+
+void DPlexEqualizer::_init()
+{
+    Compound* compound = getCompound();
+    if (!_loadListeners.empty() || !compound)
+        return;
+
+    // Subscribe to child channel load events to track finished frames
+    const Compounds& children = compound->getChildren();
+    _loadListeners.resize(children.size());
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        LoadListener& listener = _loadListeners[i];
+        listener.child = children[i];
+        listener.lastFrame = 0;
+        listener.period = listener.child->getPeriod();
+        listener.phase = listener.child->getPhase();
+        listener.child->getChannel()->addListener(&listener);
+    }
+}
+
+void DPlexEqualizer::_exit()
+{
+    // restore the configured DPlex of all children deactivated by us
+    for (LoadListener& listener : _loadListeners)
+    {
+        listener.child->setPeriod(listener.period);
+        listener.child->setPhase(listener.phase);
+        listener.child->getChannel()->removeListener(&listener);
+    }
+    _loadListeners.clear();
+}
+
+void DPlexEqualizer::notifyUpdatePre(Compound* compound,
+                                     const uint32_t frameNumber)
+{
+    _init();
+    if (_loadListeners.empty() || !compound->isActive())
+        return;
+
+    const size_t chosen = _chooseChild(frameNumber);
+    for (size_t i = 0; i < _loadListeners.size(); ++i)
+    {
+        // a phase outside of the period never matches, deactivating the child
+        Compound* child = _loadListeners[i].child;
+        child->setPeriod(1);
+        child->setPhase(i == chosen ? 0 : 1);
+    }
+
+    LoadListener& listener = _loadListeners[chosen];
+    listener.frames.insert(frameNumber);
+    listener.lastFrame = frameNumber;
+
+    LBLOG(LOG_LB2) << "Frame " << frameNumber << " of " << compound->getName()
+                   << " dispatched to "
+                   << listener.child->getChannel()->getName() << ", "
+                   << listener.frames.size() << " frames in flight"
+                   << std::endl;
+}
+
+size_t DPlexEqualizer::_chooseChild(const uint32_t frameNumber) const
+{
+    const size_t nChildren = _loadListeners.size();
+    if (!isActive() || isFrozen())
+        return frameNumber % nChildren;
+
+    // The child with the fewest frames in flight, or the one idle the longest
+    size_t chosen = nChildren;
+    for (size_t i = 0; i < nChildren; ++i)
+    {
+        const LoadListener& listener = _loadListeners[i];
+        if (!listener.child->getChannel()->isRunning())
+            continue;
+
+        if (chosen == nChildren)
+        {
+            chosen = i;
+            continue;
+        }
+
+        const LoadListener& best = _loadListeners[chosen];
+        if (listener.frames.size() < best.frames.size() ||
+            (listener.frames.size() == best.frames.size() &&
+             listener.lastFrame < best.lastFrame))
+        {
+            chosen = i;
+        }
+    }
+    return chosen == nChildren ? frameNumber % nChildren : chosen;
+}
+
+void DPlexEqualizer::LoadListener::notifyLoadData(
+    Channel*, const uint32_t frameNumber, const Statistics&, const Viewport&)
+{
+    frames.erase(frameNumber);
+}
+
+std::ostream& operator<<(std::ostream& os, const DPlexEqualizer* lb)
+{
+    if (lb)
+        os << "DPlex_equalizer {}" << std::endl;
+    return os;
+}
+}
+}
@@ -0,0 +1,85 @@
+
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQS_DPLEXEQUALIZER_H
+#define EQS_DPLEXEQUALIZER_H
+
+#include "../channelListener.h" // base class
+#include "equalizer.h"          // base class
+
+#include <set>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+std::ostream& operator<<(std::ostream& os, const DPlexEqualizer*);
+
+/**
+ * Dispatches each frame to one child of a DPlex compound.
+ *
+ * Instead of a fixed period and phase, every new frame is assigned to the
+ * child with the fewest frames in flight, that is, to the first free pipe.
+ * Frames are considered finished once the channel reports its load data. A
+ * frozen or inactive equalizer falls back to a static round-robin DPlex.
+ */
+class DPlexEqualizer : public Equalizer
+{
+public:
+    EQSERVER_API DPlexEqualizer();
+    DPlexEqualizer(const DPlexEqualizer& from);
+    virtual ~DPlexEqualizer();
+    void toStream(std::ostream& os) const final { os << this; }
+    /** @sa Equalizer::attach */
+    void attach(Compound* compound) final;
+
+    /** @sa CompoundListener::notifyUpdatePre */
+    void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
+
+    uint32_t getType() const final { return fabric::DPLEX_EQUALIZER; }
+protected:
+    void notifyChildAdded(Compound*, Compound*) override { _exit(); }
+    void notifyChildRemove(Compound*, Compound*) override { _exit(); }
+private:
+    /** Tracks the frames in flight of one compound child. */
+    class LoadListener : public ChannelListener
+    {
+    public:
+        /** @sa ChannelListener::notifyLoadData */
+        void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                            const Statistics& statistics,
+                            const Viewport& region) final;
+
+        Compound* child;
+        std::set<uint32_t> frames; //!< assigned, unfinished frames
+        uint32_t lastFrame;        //!< last assigned frame
+        uint32_t period;           //!< configured period of the child
+        uint32_t phase;            //!< configured phase of the child
+    };
+
+    /** One listener for each compound child. */
+    std::vector<LoadListener> _loadListeners;
+
+    void _init();
+    void _exit();
+    size_t _chooseChild(uint32_t frameNumber) const;
+};
+}
+}
+
+#endif // EQS_DPLEXEQUALIZER_H
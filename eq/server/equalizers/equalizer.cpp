@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2008-2014, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2011, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -18,12 +18,16 @@
 
 #include "equalizer.h"
 
+#include "../channel.h"
 #include "../compound.h"
 #include "../config.h"
 #include "../log.h"
+#include "../view.h"
 
 #include <lunchbox/debug.h>
 
+#include <sstream>
+
 namespace eq
 {
 namespace server
@@ -81,5 +85,35 @@ const Config* Equalizer::getConfig() const
     LBASSERT(_compound);
     return _compound->getConfig();
 }
+
+Config* Equalizer::getConfig()
+{
+    LBASSERT(_compound);
+    return _compound->getConfig();
+}
+
+std::string Equalizer::getStateKey() const
+{
+    LBASSERT(_compound);
+    const Channel* channel = _compound->getChannel();
+    const View* view = channel ? channel->getView() : 0;
+
+    std::ostringstream key;
+    key << getType() << " " << getMode() << " " << _compound->getName() << " "
+        << (channel ? channel->getName() : std::string()) << " "
+        << (view ? view->getName() : std::string());
+
+    // Any change in the resources invalidates the learned state
+    for (const Compound* child : _compound->getChildren())
+    {
+        key << " |";
+        const Channel* childChannel = child->getChannel();
+        if (childChannel)
+            key << " " << childChannel->getPath() << " "
+                << childChannel->getName();
+        key << " " << child->getUsage();
+    }
+    return key.str();
+}
 }
 }
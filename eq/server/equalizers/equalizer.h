@@ -54,6 +54,7 @@ public:
     Compound* getCompound() { return _compound; }
     /** @return the config. */
     const Config* getConfig() const;
+    Config* getConfig();
 
     /** Attach to a compound and detach the previous compound. */
     virtual void attach(Compound*);
@@ -62,6 +63,15 @@ public:
     bool isActive() const { return _active; }
     virtual uint32_t getType() const = 0;
 
+    /**
+     * @return the key of the learned state of this equalizer, describing the
+     *         compound, view and the resources of the children.
+     */
+    std::string getStateKey() const;
+
+    /** Store the learned state, called before the compound is deactivated. */
+    virtual void storeState(EqualizerState&) const {}
+
 private:
     // override in sub-classes to handle dynamic compounds.
     void notifyChildAdded(Compound*, Compound*) override { LBUNIMPLEMENTED }
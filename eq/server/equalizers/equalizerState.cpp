@@ -0,0 +1,93 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "equalizerState.h"
+
+#include "../log.h"
+
+#include <lunchbox/log.h>
+
+#include <fstream>
+#include <sstream>
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+// File format: one key line followed by one line of values per entry
+const std::string _header("#Equalizer load state 1");
+}
+
+const EqualizerState::Values* EqualizerState::get(const std::string& key) const
+{
+    std::map<std::string, Values>::const_iterator i = _values.find(key);
+    return i == _values.end() ? 0 : &i->second;
+}
+
+bool EqualizerState::load(const std::string& filename)
+{
+    std::ifstream file(filename.c_str());
+    if (!file)
+        return true; // first run, nothing learned yet
+
+    std::string line;
+    if (!std::getline(file, line) || line != _header)
+    {
+        LBWARN << "Ignoring load state " << filename << ": unknown format"
+               << std::endl;
+        return false;
+    }
+
+    std::string key;
+    while (std::getline(file, key) && std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        Values& values = _values[key];
+        values.clear();
+
+        float value;
+        while (stream >> value)
+            values.push_back(value);
+    }
+
+    LBLOG(LOG_LB1) << "Loaded " << _values.size() << " equalizer states from "
+                   << filename << std::endl;
+    return true;
+}
+
+bool EqualizerState::save(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str());
+    if (!file)
+    {
+        LBWARN << "Can't write load state " << filename << std::endl;
+        return false;
+    }
+
+    file << _header << std::endl;
+    for (const auto& entry : _values)
+    {
+        file << entry.first << std::endl;
+        for (const float value : entry.second)
+            file << value << ' ';
+        file << std::endl;
+    }
+    return file.good();
+}
+}
+}
@@ -0,0 +1,65 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_EQUALIZERSTATE_H
+#define EQSERVER_EQUALIZERSTATE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * The learned state of the load equalizers of a config.
+ *
+ * Equalizers store their converged split state when their compound is
+ * deactivated, and restore it when they rebuild their split tree. Each entry is
+ * keyed by a description of the equalizer's compound, view and resources, see
+ * Equalizer::getStateKey(), so that a changed configuration starts from the
+ * uniform split. If EQ_EQUALIZER_STATE names a file, the state is loaded at
+ * config initialization and written when a layout is deactivated, which
+ * includes config exit.
+ */
+class EqualizerState
+{
+public:
+    typedef std::vector<float> Values;
+
+    /** Store the values for the given key. */
+    void set(const std::string& key, const Values& values)
+    {
+        _values[key] = values;
+    }
+
+    /** @return the values for the given key, or 0 if not known. */
+    const Values* get(const std::string& key) const;
+
+    /** @return false if the file exists but can't be read. */
+    bool load(const std::string& filename);
+
+    /** @return true if the file was written. */
+    bool save(const std::string& filename) const;
+
+private:
+    std::map<std::string, Values> _values;
+};
+}
+}
+
+#endif // EQSERVER_EQUALIZERSTATE_H
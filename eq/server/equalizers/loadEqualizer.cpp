@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2011, Cedric Stalder <cedric.stalder@gmail.com>
  *                    2012, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
@@ -20,7 +20,9 @@
 #include "loadEqualizer.h"
 
 #include "../compound.h"
+#include "../config.h"
 #include "../log.h"
+#include "equalizerState.h"
 
 #include <eq/fabric/statistic.h>
 #include <lunchbox/debug.h>
@@ -80,6 +82,7 @@ void LoadEqualizer::notifyUpdatePre(Compound* compound,
 
         default:
             _tree = _buildTree(children);
+            _restoreState();
             break;
         }
     }
@@ -146,6 +149,69 @@ void LoadEqualizer::_clearTree(Node* node)
     }
 }
 
+void LoadEqualizer::storeState(EqualizerState& state) const
+{
+    if (!_tree || _history.empty() || _history.front().first == 0)
+        return;
+
+    const LBDatas& items = _history.front().second;
+    if (items.size() != getCompound()->getChildren().size())
+        return;
+
+    EqualizerState::Values values;
+    values.reserve(items.size() * 7);
+    for (const Data& data : items)
+    {
+        if (data.time < 0) // no complete data set
+            return;
+
+        values.push_back(data.vp.x);
+        values.push_back(data.vp.y);
+        values.push_back(data.vp.w);
+        values.push_back(data.vp.h);
+        values.push_back(data.range.start);
+        values.push_back(data.range.end);
+        values.push_back(float(data.time));
+    }
+    state.set(getStateKey(), values);
+}
+
+void LoadEqualizer::_restoreState()
+{
+    const Compounds& children = getCompound()->getChildren();
+    const EqualizerState::Values* values =
+        getConfig()->getEqualizerState().get(getStateKey());
+    if (!values || values->size() != children.size() * 7)
+        return;
+
+    LBFrameData frameData;
+    frameData.first = 0; // older than any real frame
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        const float* value = &(*values)[i * 7];
+        Data data;
+        data.channel = children[i]->getChannel();
+        data.taskID = children[i]->getTaskID();
+        data.vp = Viewport(value[0], value[1], value[2], value[3]);
+        data.range = Range(value[4], value[5]);
+        data.time = int64_t(value[6]);
+
+        if (!data.vp.isValid() || !data.range.isValid() || data.time < 0)
+        {
+            LBWARN << "Ignoring invalid stored load data " << data.vp << ", "
+                   << data.range << std::endl;
+            return;
+        }
+        frameData.second.push_back(data);
+    }
+
+    // replaces the fake data set
+    _history.clear();
+    _history.push_back(frameData);
+    LBLOG(LOG_LB1) << "Restored load of " << children.size() << " children for "
+                   << getCompound()->getChannel()->getName() << std::endl;
+}
+
 void LoadEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
                                    const Statistics& statistics,
                                    const Viewport& region)
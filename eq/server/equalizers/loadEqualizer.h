@@ -51,6 +51,9 @@ public:
                         const Viewport& region) final;
 
     uint32_t getType() const final { return fabric::LOAD_EQUALIZER; }
+    /** Store the youngest complete load data set. */
+    void storeState(EqualizerState& state) const final;
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override { LBASSERT(!_tree); }
     void notifyChildRemove(Compound*, Compound*) override { LBASSERT(!_tree); }
@@ -125,6 +128,9 @@ private:
     /** Clear the tree, does not delete the nodes. */
     void _clearTree(Node* node);
 
+    /** Start from a stored load data set instead of the uniform split. */
+    void _restoreState();
+
     /** get the total time used by the rendering. */
     int64_t _getTotalTime();
 
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2009-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2009-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -23,6 +23,7 @@
 #include "../frame.h"
 #include "../log.h"
 #include "../segment.h"
+#include "../server.h"
 #include "../view.h"
 
 #include <eq/fabric/viewport.h>
@@ -70,12 +71,20 @@ private:
 }
 
 MonitorEqualizer::MonitorEqualizer()
+    : _period(1)
+    , _rate(0.f)
+    , _lastFrame(0)
+    , _lastTime(0)
 {
     LBINFO << "New monitor equalizer @" << (void*)this << std::endl;
 }
 
 MonitorEqualizer::MonitorEqualizer(const MonitorEqualizer& from)
     : Equalizer(from)
+    , _period(from._period)
+    , _rate(from._rate)
+    , _lastFrame(0)
+    , _lastTime(0)
 {
 }
 
@@ -89,13 +98,39 @@ void MonitorEqualizer::attach(Compound* compound)
 {
     _outputFrames.clear();
     _viewports.clear();
+    _lastFrame = 0;
+    _lastTime = 0;
     Equalizer::attach(compound);
 }
 
-void MonitorEqualizer::notifyUpdatePre(Compound*, const uint32_t)
+void MonitorEqualizer::notifyUpdatePre(Compound*, const uint32_t frameNumber)
 {
     _updateViewports();
     _updateZoomAndOffset();
+
+    const bool refresh = _needsRefresh(frameNumber);
+    for (Frame* frame : _outputFrames)
+        if (frame)
+            frame->setHoldData(!refresh);
+}
+
+bool MonitorEqualizer::_needsRefresh(const uint32_t frameNumber)
+{
+    if (_period <= 1 && _rate <= 0.f)
+        return true;
+
+    const int64_t time = getConfig()->getServer()->getTime();
+    if (_lastFrame > 0)
+    {
+        if (frameNumber < _lastFrame + _period)
+            return false;
+        if (_rate > 0.f && float(time - _lastTime) < 1000.f / _rate)
+            return false;
+    }
+
+    _lastFrame = frameNumber;
+    _lastTime = time;
+    return true;
 }
 
 void MonitorEqualizer::_updateViewports()
@@ -177,8 +212,22 @@ void MonitorEqualizer::_updateZoomAndOffset()
 
 std::ostream& operator<<(std::ostream& os, const MonitorEqualizer* equalizer)
 {
-    if (equalizer)
+    if (!equalizer)
+        return os;
+
+    if (equalizer->getUpdatePeriod() <= 1 && equalizer->getUpdateRate() <= 0.f)
+    {
         os << "monitor_equalizer {}" << std::endl;
+        return os;
+    }
+
+    os << lunchbox::disableFlush << "monitor_equalizer" << std::endl
+       << '{' << std::endl;
+    if (equalizer->getUpdatePeriod() > 1)
+        os << "    period " << equalizer->getUpdatePeriod() << std::endl;
+    if (equalizer->getUpdateRate() > 0.f)
+        os << "    framerate " << equalizer->getUpdateRate() << std::endl;
+    os << '}' << std::endl << lunchbox::enableFlush;
     return os;
 }
 }
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2009-2016, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2009-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
  * the terms of the GNU Lesser General Public License version 2.1 as published
@@ -29,7 +29,13 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const MonitorEqualizer*);
 
-/** Destination-driven scaling.*/
+/**
+ * Destination-driven scaling.
+ *
+ * The monitored outputs are refreshed every frame by default. A period or a
+ * frame rate limits the refresh, the monitor reuses the last images in between
+ * without any readback or transfer from the source channels.
+ */
 class MonitorEqualizer : public Equalizer
 {
 public:
@@ -44,6 +50,15 @@ public:
     void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
 
     uint32_t getType() const final { return fabric::MONITOR_EQUALIZER; }
+    /** Refresh the monitored outputs every nth frame. */
+    void setUpdatePeriod(const uint32_t period) { _period = period; }
+    /** @return the refresh period in frames. */
+    uint32_t getUpdatePeriod() const { return _period; }
+    /** Refresh the monitored outputs at most with the given rate in Hz. */
+    void setUpdateRate(const float rate) { _rate = rate; }
+    /** @return the maximum refresh rate, 0 if unlimited. */
+    float getUpdateRate() const { return _rate; }
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override {}
     void notifyChildRemove(Compound*, Compound*) override {}
@@ -55,8 +70,16 @@ private:
         output frame zoom value */
     void _updateZoomAndOffset();
 
+    /** @return true if the monitored outputs are refreshed this frame. */
+    bool _needsRefresh(uint32_t frameNumber);
+
     Viewports _viewports;
     Frames _outputFrames;
+
+    uint32_t _period;
+    float _rate;
+    uint32_t _lastFrame; //!< last refreshed frame
+    int64_t _lastTime;   //!< time of the last refresh
 };
 }
 }
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2011-2015, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2011-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *               2011, Carsten Rohn <carsten.rohn@rtt.ag>
  *               2011, Daniel Nachbaur <danielnachbaur@gmail.com>
  *
@@ -19,19 +19,30 @@
 
 #include "tileEqualizer.h"
 
+#include "../channel.h"
 #include "../compound.h"
 #include "../compoundVisitor.h"
 #include "../config.h"
+#include "../log.h"
 #include "../server.h"
 #include "../tileQueue.h"
 #include "../view.h"
 
+#include <eq/fabric/statistic.h>
+
+#include <cmath>
+#include <limits>
+
 namespace eq
 {
 namespace server
 {
 namespace
 {
+static const int32_t MINSIZE = 16;  // pixels
+static const int32_t ALIGNMENT = 8; // pixels
+static const float MAXSTEP = 2.f;   // maximum tile edge change per frame
+
 TileQueue* _findQueue(const std::string& name, const TileQueues& queues)
 {
     for (TileQueuesCIter i = queues.begin(); i != queues.end(); ++i)
@@ -45,16 +56,19 @@ TileQueue* _findQueue(const std::string& name, const TileQueues& queues)
 class InputQueueCreator : public CompoundVisitor
 {
 public:
-    InputQueueCreator(const eq::fabric::Vector2i& size, const std::string& name)
+    InputQueueCreator(const eq::fabric::Vector2i& size, const std::string& name,
+                      Compounds& leaves)
         : CompoundVisitor()
         , _tileSize(size)
         , _name(name)
+        , _leaves(leaves)
     {
     }
 
     /** Visit a leaf compound. */
     virtual VisitorResult visitLeaf(Compound* compound)
     {
+        _leaves.push_back(compound);
         if (_findQueue(_name, compound->getInputTileQueues()))
             return TRAVERSE_CONTINUE;
 
@@ -76,6 +90,7 @@ public:
 private:
     const eq::fabric::Vector2i& _tileSize;
     const std::string& _name;
+    Compounds& _leaves;
 };
 
 class InputQueueDestroyer : public CompoundVisitor
@@ -106,22 +121,39 @@ public:
 private:
     const std::string& _name;
 };
+
+int32_t _alignTileSize(const float size)
+{
+    const int32_t aligned = int32_t(size / ALIGNMENT + .5f) * ALIGNMENT;
+    return LB_MAX(aligned, MINSIZE);
+}
 }
 
 TileEqualizer::TileEqualizer()
     : Equalizer()
     , _created(false)
+    , _autoSize(false)
     , _name("TileEqualizer")
 {
 }
 
 TileEqualizer::TileEqualizer(const TileEqualizer& from)
     : Equalizer(from)
+    , ChannelListener(from)
     , _created(from._created)
+    , _autoSize(from._autoSize)
     , _name(from._name)
+    , _size(from._size)
+    , _requested(from._requested)
 {
 }
 
+TileEqualizer::~TileEqualizer()
+{
+    for (Compound* leaf : _leaves)
+        leaf->getChannel()->removeListener(this);
+}
+
 std::string TileEqualizer::_getQueueName() const
 {
     std::ostringstream name;
@@ -145,8 +177,20 @@ void TileEqualizer::_createQueues(Compound* compound)
         compound->addOutputTileQueue(output);
     }
 
-    InputQueueCreator creator(getTileSize(), name);
+    InputQueueCreator creator(getTileSize(), name, _leaves);
     compound->accept(creator);
+
+    // Subscribe to the tile load of the source channels
+    for (CompoundsCIter i = _leaves.begin(); i != _leaves.end(); ++i)
+    {
+        Channel* channel = (*i)->getChannel();
+        LBASSERT(channel);
+        bool subscribed = false;
+        for (CompoundsCIter j = _leaves.begin(); j != i && !subscribed; ++j)
+            subscribed = (*j)->getChannel() == channel;
+        if (!subscribed)
+            channel->addListener(this);
+    }
 }
 
 void TileEqualizer::_destroyQueues(Compound* compound)
@@ -165,16 +209,160 @@ void TileEqualizer::_destroyQueues(Compound* compound)
     InputQueueDestroyer destroyer(name);
     compound->accept(destroyer);
     _created = false;
+
+    for (Compound* leaf : _leaves)
+        leaf->getChannel()->removeListener(this);
+    _leaves.clear();
+    _history.clear();
 }
 
 void TileEqualizer::notifyUpdatePre(Compound* compound,
-                                    const uint32_t /*frame*/)
+                                    const uint32_t frameNumber)
 {
     if (isActive() && !_created)
         _createQueues(compound);
 
     if (!isActive() && _created)
         _destroyQueues(compound);
+
+    if (_created && _autoSize)
+        _updateTileSize(compound, frameNumber);
+}
+
+void TileEqualizer::_updateTileSize(Compound* compound,
+                                    const uint32_t frameNumber)
+{
+    TileQueue* queue =
+        _findQueue(_getQueueName(), compound->getOutputTileQueues());
+    if (!queue)
+        return;
+
+    // A new configured tile size, e.g., from the application, restarts tuning
+    if (getTileSize() != _requested || _size == Vector2i())
+    {
+        _requested = getTileSize();
+        _size = _requested;
+        _history.clear();
+    }
+
+    const PixelViewport& pvp = compound->getInheritPixelViewport();
+    if (!pvp.hasArea() || _size.x() <= 0 || _size.y() <= 0)
+        return;
+
+    _size.x() = LB_MIN(_size.x(), _alignTileSize(float(pvp.w)));
+    _size.y() = LB_MIN(_size.y(), _alignTileSize(float(pvp.h)));
+    queue->setTileSize(_size);
+
+    uint32_t eyes = 0;
+    for (fabric::Eye eye = fabric::EYE_CYCLOP; eye < fabric::EYES_ALL;
+         eye = fabric::Eye(eye << 1))
+    {
+        if ((compound->getInheritEyes() & eye) && compound->isInheritActive(eye))
+            ++eyes;
+    }
+
+    size_t nLeaves = 0;
+    for (const Compound* leaf : _leaves)
+        if (leaf->isActive())
+            ++nLeaves;
+
+    const uint32_t tiles = ((pvp.w + _size.x() - 1) / _size.x()) *
+                           ((pvp.h + _size.y() - 1) / _size.y()) * eyes;
+    const Load load = {frameNumber,
+                       tiles,
+                       _size,
+                       nLeaves,
+                       0,
+                       0,
+                       0,
+                       std::numeric_limits<int64_t>::max(),
+                       0};
+    _history.push_back(load);
+
+    // drop frames which will not receive all load data
+    while (_history.size() > compound->getConfig()->getLatency() + 2)
+        _history.pop_front();
+}
+
+void TileEqualizer::notifyLoadData(Channel* channel, const uint32_t frameNumber,
+                                   const Statistics& statistics,
+                                   const Viewport& /*region*/)
+{
+    for (std::deque<Load>::iterator i = _history.begin(); i != _history.end();
+         ++i)
+    {
+        Load& load = *i;
+        if (load.frame != frameNumber)
+            continue;
+
+        for (const Compound* leaf : _leaves)
+        {
+            if (leaf->getChannel() != channel)
+                continue;
+
+            // one tile loop per eye, the last one finishes the source
+            const uint32_t taskID = leaf->getTaskID();
+            int64_t endTime = 0;
+            for (const Statistic& stat : statistics)
+            {
+                if (stat.task != taskID ||
+                    stat.type != Statistic::CHANNEL_FRAME_TILES)
+                {
+                    continue;
+                }
+
+                load.time += stat.endTime - stat.startTime;
+                load.overhead += stat.idleTime;
+                endTime = LB_MAX(endTime, stat.endTime);
+            }
+
+            if (endTime == 0)
+                continue;
+            ++load.nReports;
+            load.firstEnd = LB_MIN(load.firstEnd, endTime);
+            load.lastEnd = LB_MAX(load.lastEnd, endTime);
+        }
+
+        if (load.nReports < load.nExpected)
+            return;
+
+        if (!isFrozen() && load.time > 0)
+            _adapt(load);
+        _history.erase(_history.begin(), i + 1);
+        return;
+    }
+}
+
+void TileEqualizer::_adapt(const Load& load)
+{
+    // The frame time of n tiles on p channels is modelled as
+    //   (work + n * overhead) / p + imbalance,
+    // with the imbalance at the end of the frame proportional to the tile work
+    // (work / n). Its minimum is at n' = sqrt(n * p * imbalance / overhead).
+    // Times have a resolution of one millisecond, clamp them to half of it.
+    const float nTiles = float(LB_MAX(load.tiles, 1u));
+    const float nChannels = float(LB_MAX(load.nReports, size_t(1)));
+    const float overhead = LB_MAX(float(load.overhead), .5f) / nTiles;
+    const float imbalance = LB_MAX(float(load.lastEnd - load.firstEnd), .5f);
+    const float optimum = std::sqrt(nTiles * nChannels * imbalance / overhead);
+
+    // Tile edge scale to reach the optimal number of tiles
+    float scale = std::sqrt(nTiles / LB_MAX(optimum, 1.f));
+    scale = LB_MIN(LB_MAX(scale, 1.f / MAXSTEP), MAXSTEP);
+
+    const float damping = 1.f - getDamping();
+    const Vector2i oldSize = _size;
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const float target = float(load.tileSize[i]) * scale;
+        const float size = float(_size[i]);
+        _size[i] = _alignTileSize(size * std::pow(target / size, damping));
+    }
+
+    if (_size != oldSize)
+        LBLOG(LOG_LB2) << "Tile size " << _size << " for " << optimum
+                       << " tiles, overhead " << overhead << "ms, imbalance "
+                       << imbalance << "ms" << std::endl;
 }
 
 std::ostream& operator<<(std::ostream& os, const TileEqualizer* lb)
@@ -184,9 +372,10 @@ std::ostream& operator<<(std::ostream& os, const TileEqualizer* lb)
         os << lunchbox::disableFlush << "tile_equalizer" << std::endl
            << "{" << std::endl
            << "    name \"" << lb->getName() << "\"" << std::endl
-           << "    size " << lb->getTileSize() << std::endl
-           << "}" << std::endl
-           << lunchbox::enableFlush;
+           << "    size " << lb->getTileSize() << std::endl;
+        if (lb->isAutoTileSize())
+            os << "    size AUTO" << std::endl;
+        os << "}" << std::endl << lunchbox::enableFlush;
     }
     return os;
 }
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2011, Carsten Rohn <carsten.rohn@rtt.ag>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -19,7 +19,10 @@
 #ifndef EQS_TILEEQUALIZER_H
 #define EQS_TILEEQUALIZER_H
 
-#include "equalizer.h"
+#include "../channelListener.h" // base class
+#include "equalizer.h"          // base class
+
+#include <deque>
 
 namespace eq
 {
@@ -27,29 +30,66 @@ namespace server
 {
 std::ostream& operator<<(std::ostream& os, const TileEqualizer*);
 
-class TileEqualizer : public Equalizer
+/**
+ * Distributes the destination area in tiles using a pull-based tile queue.
+ *
+ * With an automatic tile size, the tile size is tuned each frame from the
+ * per-tile overhead and the load imbalance reported by the source channels.
+ */
+class TileEqualizer : public Equalizer, protected ChannelListener
 {
 public:
     EQSERVER_API TileEqualizer();
     TileEqualizer(const TileEqualizer& from);
-    ~TileEqualizer() {}
+    virtual ~TileEqualizer();
     /** @sa CompoundListener::notifyUpdatePre */
     void notifyUpdatePre(Compound* compound, const uint32_t frameNumber) final;
 
+    /** @sa ChannelListener::notifyLoadData */
+    void notifyLoadData(Channel* channel, uint32_t frameNumber,
+                        const Statistics& statistics,
+                        const Viewport& region) final;
+
     void toStream(std::ostream& os) const final { os << this; }
     void setName(const std::string& name) { _name = name; }
     const std::string& getName() const { return _name; }
+    /** Tune the tile size automatically, starting from the set tile size. */
+    void setAutoTileSize(const bool enable) { _autoSize = enable; }
+    /** @return true if the tile size is tuned automatically. */
+    bool isAutoTileSize() const { return _autoSize; }
     uint32_t getType() const final { return fabric::TILE_EQUALIZER; }
 protected:
     void notifyChildAdded(Compound*, Compound*) override {}
     void notifyChildRemove(Compound*, Compound*) override {}
 private:
+    /** The tile loop load of one frame, summed over all source channels. */
+    struct Load
+    {
+        uint32_t frame;
+        uint32_t tiles;    //!< number of generated tiles
+        Vector2i tileSize; //!< tile size used for the frame
+        size_t nExpected;  //!< number of active source compounds
+        size_t nReports;   //!< number of source compounds reported
+        int64_t time;      //!< wall time of all tile loops
+        int64_t overhead;  //!< per-tile overhead of all tile loops
+        int64_t firstEnd;  //!< earliest end of a source
+        int64_t lastEnd;   //!< latest end of a source
+    };
+
     std::string _getQueueName() const;
     void _destroyQueues(Compound* compound);
     void _createQueues(Compound* compound);
+    void _updateTileSize(Compound* compound, uint32_t frameNumber);
+    void _adapt(const Load& load);
 
     bool _created;
+    bool _autoSize;
     std::string _name;
+
+    Compounds _leaves;         //!< source compounds reporting load data
+    Vector2i _size;            //!< current automatic tile size
+    Vector2i _requested;       //!< configured size the tuning started from
+    std::deque<Load> _history; //!< frames waiting for load data
 };
 
 } // server
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2008-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2008-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2010, Cedric Stalder <cedric.stalder@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -19,6 +19,7 @@
 #include "treeEqualizer.h"
 
 #include "../compound.h"
+#include "../config.h"
 #include "../log.h"
 
 #include <eq/fabric/statistic.h>
@@ -76,6 +77,7 @@ void TreeEqualizer::notifyUpdatePre(Compound* compound,
             return;
         default:
             _tree = _buildTree(children);
+            _restoreState();
         }
     }
 
@@ -136,6 +138,67 @@ void TreeEqualizer::_clearTree(Node* node)
     }
 }
 
+void TreeEqualizer::storeState(EqualizerState& state) const
+{
+    if (!_tree)
+        return;
+
+    EqualizerState::Values values;
+    _storeState(_tree, values);
+    state.set(getStateKey(), values);
+}
+
+void TreeEqualizer::_storeState(const Node* node,
+                                EqualizerState::Values& values)
+{
+    values.push_back(node->split);
+    values.push_back(float(node->time));
+    if (node->compound)
+        return;
+
+    _storeState(node->left, values);
+    _storeState(node->right, values);
+}
+
+void TreeEqualizer::_restoreState()
+{
+    const EqualizerState::Values* values =
+        getConfig()->getEqualizerState().get(getStateKey());
+    if (!values)
+        return;
+
+    const size_t nNodes = getCompound()->getChildren().size() * 2 - 1;
+    if (values->size() != nNodes * 2)
+        return;
+
+    for (size_t i = 0; i < values->size(); i += 2)
+    {
+        const float split = (*values)[i];
+        const float time = (*values)[i + 1];
+        if (split < 0.f || split > 1.f || time < 1.f)
+        {
+            LBWARN << "Ignoring invalid stored split " << split << " time "
+                   << time << std::endl;
+            return;
+        }
+    }
+
+    const float* value = values->data();
+    _restoreState(_tree, value);
+    LBLOG(LOG_LB1) << "Restored LB tree: " << _tree;
+}
+
+void TreeEqualizer::_restoreState(Node* node, const float*& value)
+{
+    node->split = *value++;
+    node->time = int64_t(*value++);
+    if (node->compound)
+        return;
+
+    _restoreState(node->left, value);
+    _restoreState(node->right, value);
+}
+
 void TreeEqualizer::notifyLoadData(Channel* channel, const uint32_t /*frame*/,
                                    const Statistics& statistics,
                                    const Viewport& /*region*/)
@@ -21,6 +21,7 @@
 
 #include "../channelListener.h" // base class
 #include "equalizer.h"          // base class
+#include "equalizerState.h"     // nested type
 
 #include <eq/fabric/range.h>    // member
 #include <eq/fabric/viewport.h> // member
@@ -51,6 +52,9 @@ public:
                         const Viewport& region) final;
 
     uint32_t getType() const final { return fabric::TREE_EQUALIZER; }
+    /** Store the split and time of all tree nodes. */
+    void storeState(EqualizerState& state) const final;
+
 protected:
     void notifyChildAdded(Compound*, Compound*) override { LBASSERT(!_tree); }
     void notifyChildRemove(Compound*, Compound*) override { LBASSERT(!_tree); }
@@ -102,6 +106,11 @@ private:
     /** Clear the tree, does not delete the nodes. */
     void _clearTree(Node* node);
 
+    /** Start from the stored splits instead of the uniform split. */
+    void _restoreState();
+    static void _storeState(const Node* node, EqualizerState::Values& values);
+    static void _restoreState(Node* node, const float*& value);
+
     void _notifyLoadData(Node* node, Channel* channel,
                          const Statistics& statistics);
 
@@ -25,6 +25,8 @@
 #include <co/dataIStream.h>
 #include <co/dataOStream.h>
 
+#include <algorithm>
+
 namespace eq
 {
 namespace server
@@ -35,6 +37,8 @@ Frame::Frame()
     , _type(TYPE_MEMORY)
     , _native()
     , _masterFrameData(0)
+    , _retained(false)
+    , _holdData(false)
 {
     setNativeZoom(Zoom(0.f, 0.f)); // set invalid zoom to detect 'set' state
     for (unsigned i = 0; i < NUM_EYES; ++i)
@@ -49,6 +53,8 @@ Frame::Frame(const Frame& from)
     , _type(from._type)
     , _native(from._native)
     , _masterFrameData(0)
+    , _retained(false)
+    , _holdData(false)
 {
     for (unsigned i = 0; i < NUM_EYES; ++i)
         _frameData[i] = 0;
@@ -76,6 +82,7 @@ void Frame::flush()
 
 void Frame::unsetData()
 {
+    _retained = false;
     for (unsigned i = 0; i < NUM_EYES; ++i)
     {
         _frameData[i] = 0;
@@ -112,6 +119,7 @@ uint128_t Frame::commit(const uint32_t incarnation)
 void Frame::cycleData(const uint32_t frameNumber, const Compound* compound)
 {
     _masterFrameData = 0;
+    _retained = false;
     for (unsigned i = 0; i < NUM_EYES; ++i)
     {
         _inputFrames[i].clear();
@@ -150,6 +158,74 @@ void Frame::cycleData(const uint32_t frameNumber, const Compound* compound)
     }
 }
 
+bool Frame::retainData(const uint32_t frameNumber)
+{
+    if (!_masterFrameData)
+        return false;
+
+    for (unsigned i = 0; i < NUM_EYES; ++i)
+    {
+        _inputFrames[i].clear();
+        _retainedInputNodes[i].swap(_getInputNodes(i));
+        _getInputNodes(i).clear();
+        _getInputNetNodes(i).clear();
+
+        // keep the data from being recycled while it is in use
+        if (_frameData[i])
+            _frameData[i]->setFrameNumber(frameNumber);
+    }
+    _retained = true;
+    return true;
+}
+
+bool Frame::hasRetainedInputs() const
+{
+    for (unsigned i = 0; i < NUM_EYES; ++i)
+    {
+        const std::vector<uint128_t>& retained = _retainedInputNodes[i];
+        for (const uint128_t& node : getInputNodes(Eye(1 << i)))
+            if (std::find(retained.begin(), retained.end(), node) ==
+                retained.end())
+            {
+                return false;
+            }
+    }
+    return true;
+}
+
+void Frame::cycleRetainedData(const uint32_t frameNumber,
+                              const Compound* compound)
+{
+    LBASSERT(_retained);
+    FrameData* retained[NUM_EYES];
+    Frames inputFrames[NUM_EYES];
+    std::vector<uint128_t> inputNodes[NUM_EYES];
+    co::NodeIDs inputNetNodes[NUM_EYES];
+    for (unsigned i = 0; i < NUM_EYES; ++i)
+    {
+        retained[i] = _frameData[i];
+        inputFrames[i].swap(_inputFrames[i]);
+        inputNodes[i].swap(_getInputNodes(i));
+        inputNetNodes[i].swap(_getInputNetNodes(i));
+    }
+
+    cycleData(frameNumber, compound);
+    for (unsigned i = 0; i < NUM_EYES; ++i)
+    {
+        if (!_frameData[i])
+            continue;
+
+        if (retained[i])
+            _frameData[i]->fabric::FrameData::operator=(*retained[i]);
+        _inputFrames[i].swap(inputFrames[i]);
+        _getInputNodes(i).swap(inputNodes[i]);
+        _getInputNetNodes(i).swap(inputNetNodes[i]);
+        for (Frame* frame : _inputFrames[i])
+            frame->_frameData[i] = _frameData[i];
+    }
+    commitData();
+}
+
 void Frame::addInputFrame(Frame* frame, const Compound* compound)
 {
     for (unsigned i = 0; i < NUM_EYES; ++i)
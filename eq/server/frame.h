@@ -52,6 +52,10 @@ public:
     }
     Node* getNode() const { return _compound ? _compound->getNode() : 0; }
     FrameData* getMasterData() const { return _masterFrameData; }
+    FrameData* getData(const Eye eye) const
+    {
+        return _frameData[lunchbox::getIndexOfLastBit(eye)];
+    }
     bool hasData(const Eye eye) const
     {
         return (_frameData[lunchbox::getIndexOfLastBit(eye)] != 0);
@@ -104,6 +108,44 @@ public:
      */
     void cycleData(const uint32_t frameNumber, const Compound* compound);
 
+    /**
+     * Keep the current FrameData without a new version.
+     *
+     * Used for output frames of cached source contributions. The receivers
+     * reuse the images of the retained version. Also clears the list of input
+     * frames.
+     *
+     * @param frameNumber the current frame number.
+     * @return false if the frame has no data to retain.
+     */
+    bool retainData(const uint32_t frameNumber);
+
+    /** @return true if the current FrameData is retained. */
+    bool isRetained() const { return _retained; }
+    /**
+     * Keep the current FrameData of this output frame in the next updates.
+     *
+     * Used by equalizers refreshing secondary outputs at a lower rate. Held
+     * frames are not read back, compressed or transmitted.
+     */
+    void setHoldData(const bool hold) { _holdData = hold; }
+    /** @return true if the current FrameData is kept in the next update. */
+    bool getHoldData() const { return _holdData; }
+    /**
+     * @return true if all current input nodes have received the retained
+     *         FrameData.
+     */
+    bool hasRetainedInputs() const;
+
+    /**
+     * Cycle a retained FrameData after the input frames have been set.
+     *
+     * Used if the retained data can't be used, allocates new frame data with
+     * the retained parameters and keeps the current input frames.
+     */
+    void cycleRetainedData(const uint32_t frameNumber,
+                           const Compound* compound);
+
     /**
      * Add an input frame to this (output) frame
      *
@@ -168,6 +210,11 @@ private:
 
     /** Vector of current input frames. */
     Frames _inputFrames[fabric::NUM_EYES];
+
+    /** Input nodes which received the retained frame data. */
+    std::vector<uint128_t> _retainedInputNodes[fabric::NUM_EYES];
+    bool _retained;
+    bool _holdData;
 };
 
 EQSERVER_API std::ostream& operator<<(std::ostream&, const Frame&);
@@ -75,6 +75,7 @@ void Global::_setupDefaults()
 
     _nodeIAttributes[Node::IATTR_LAUNCH_TIMEOUT] = 60000; // ms
     _nodeIAttributes[Node::IATTR_HINT_AFFINITY] = fabric::AUTO;
+    _nodeIAttributes[Node::IATTR_HINT_SHARED_MEMORY] = fabric::AUTO;
     _nodeSAttributes[Node::SATTR_LAUNCH_COMMAND] =
         "ssh -n %h %c --eq-logfile %q%d/%h.%n.log%q";
 #ifdef WIN32
@@ -104,6 +105,7 @@ void Global::_setupDefaults()
     _windowIAttributes[WindowSettings::IATTR_HINT_DRAWABLE] = fabric::WINDOW;
     _windowIAttributes[WindowSettings::IATTR_HINT_SCREENSAVER] = fabric::AUTO;
     _windowIAttributes[WindowSettings::IATTR_HINT_GRAB_POINTER] = fabric::ON;
+    _windowIAttributes[WindowSettings::IATTR_HINT_FRAME_PACING] = fabric::OFF;
     _windowIAttributes[WindowSettings::IATTR_PLANES_COLOR] = fabric::AUTO;
     _windowIAttributes[WindowSettings::IATTR_PLANES_DEPTH] = fabric::AUTO;
     _windowIAttributes[WindowSettings::IATTR_PLANES_STENCIL] = fabric::AUTO;
@@ -124,6 +126,8 @@ void Global::_setupDefaults()
     _channelIAttributes[Channel::IATTR_HINT_STATISTICS] = fabric::NICEST;
 #endif
     _channelIAttributes[Channel::IATTR_HINT_SENDTOKEN] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_RESULT_CACHE] = fabric::OFF;
+    _channelIAttributes[Channel::IATTR_HINT_REPROJECTION] = fabric::OFF;
 
     // compound
     for (uint32_t i = 0; i < Compound::IATTR_ALL; ++i)
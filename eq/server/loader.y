@@ -24,6 +24,7 @@
 #include "channel.h"
 #include "compound.h"
 #include "equalizers/dfrEqualizer.h"
+#include "equalizers/dplexEqualizer.h"
 #include "equalizers/framerateEqualizer.h"
 #include "equalizers/loadEqualizer.h"
 #include "equalizers/treeEqualizer.h"
@@ -74,6 +75,7 @@
         static eq::server::LoadEqualizer* loadEqualizer = 0;
         static eq::server::TreeEqualizer* treeEqualizer = 0;
         static eq::server::TileEqualizer* tileEqualizer = 0;
+        static eq::server::MonitorEqualizer* monitorEqualizer = 0;
         static eq::server::SwapBarrierPtr swapBarrier;
         static eq::server::Frame*       frame = 0;
         static eq::server::TileQueue*   tileQueue = 0;
@@ -102,6 +104,8 @@
 %token EQTOKEN_GLOBAL
 %token EQTOKEN_CHANNEL_IATTR_HINT_STATISTICS
 %token EQTOKEN_CHANNEL_IATTR_HINT_SENDTOKEN
+%token EQTOKEN_CHANNEL_IATTR_HINT_RESULT_CACHE
+%token EQTOKEN_CHANNEL_IATTR_HINT_REPROJECTION
 %token EQTOKEN_CHANNEL_SATTR_DUMP_IMAGE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_MODE
 %token EQTOKEN_COMPOUND_IATTR_STEREO_ANAGLYPH_LEFT_MASK
@@ -119,6 +123,7 @@
 %token EQTOKEN_NODE_IATTR_THREAD_MODEL
 %token EQTOKEN_NODE_IATTR_HINT_AFFINITY
 %token EQTOKEN_NODE_IATTR_HINT_STATISTICS
+%token EQTOKEN_NODE_IATTR_HINT_SHARED_MEMORY
 %token EQTOKEN_NODE_IATTR_LAUNCH_TIMEOUT
 %token EQTOKEN_PIPE_IATTR_HINT_THREAD
 %token EQTOKEN_PIPE_IATTR_HINT_AFFINITY
@@ -135,6 +140,7 @@
 %token EQTOKEN_WINDOW_IATTR_HINT_STATISTICS
 %token EQTOKEN_WINDOW_IATTR_HINT_SCREENSAVER
 %token EQTOKEN_WINDOW_IATTR_HINT_GRAB_POINTER
+%token EQTOKEN_WINDOW_IATTR_HINT_FRAME_PACING
 %token EQTOKEN_WINDOW_IATTR_HINT_HEIGHT
 %token EQTOKEN_WINDOW_IATTR_HINT_WIDTH
 %token EQTOKEN_WINDOW_IATTR_PLANES_ACCUM
@@ -160,12 +166,16 @@
 %token EQTOKEN_HINT_DECORATION
 %token EQTOKEN_HINT_STATISTICS
 %token EQTOKEN_HINT_SENDTOKEN
+%token EQTOKEN_HINT_RESULT_CACHE
+%token EQTOKEN_HINT_REPROJECTION
 %token EQTOKEN_HINT_SWAPSYNC
 %token EQTOKEN_HINT_DRAWABLE
 %token EQTOKEN_HINT_THREAD
 %token EQTOKEN_HINT_AFFINITY
 %token EQTOKEN_HINT_SCREENSAVER
+%token EQTOKEN_HINT_SHARED_MEMORY
 %token EQTOKEN_HINT_GRAB_POINTER
+%token EQTOKEN_HINT_FRAME_PACING
 %token EQTOKEN_PLANES_COLOR
 %token EQTOKEN_PLANES_ALPHA
 %token EQTOKEN_PLANES_DEPTH
@@ -195,6 +205,7 @@
 %token EQTOKEN_SEGMENT
 %token EQTOKEN_COMPOUND
 %token EQTOKEN_DFREQUALIZER
+%token EQTOKEN_DPLEXEQUALIZER
 %token EQTOKEN_FRAMERATEEQUALIZER
 %token EQTOKEN_LOADEQUALIZER
 %token EQTOKEN_TREEEQUALIZER
@@ -400,6 +411,11 @@ global:
          eq::server::Global::instance()->setNodeIAttribute(
              eq::server::Node::IATTR_LAUNCH_TIMEOUT, $2 );
      }
+     | EQTOKEN_NODE_IATTR_HINT_SHARED_MEMORY IATTR
+     {
+         eq::server::Global::instance()->setNodeIAttribute(
+             eq::server::Node::IATTR_HINT_SHARED_MEMORY, $2 );
+     }
      | EQTOKEN_NODE_IATTR_HINT_STATISTICS IATTR
      {
          LBWARN << "Ignoring deprecated attribute Node::IATTR_HINT_STATISTICS"
@@ -475,6 +491,11 @@ global:
          eq::server::Global::instance()->setWindowIAttribute(
              eq::server::WindowSettings::IATTR_HINT_GRAB_POINTER, $2 );
      }
+     | EQTOKEN_WINDOW_IATTR_HINT_FRAME_PACING IATTR
+     {
+         eq::server::Global::instance()->setWindowIAttribute(
+             eq::server::WindowSettings::IATTR_HINT_FRAME_PACING, $2 );
+     }
      | EQTOKEN_WINDOW_IATTR_HINT_HEIGHT IATTR
      {
          eq::server::Global::instance()->setWindowIAttribute(
@@ -530,6 +551,16 @@ global:
          eq::server::Global::instance()->setChannelIAttribute(
              eq::server::Channel::IATTR_HINT_SENDTOKEN, $2 );
      }
+     | EQTOKEN_CHANNEL_IATTR_HINT_RESULT_CACHE IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_RESULT_CACHE, $2 );
+     }
+     | EQTOKEN_CHANNEL_IATTR_HINT_REPROJECTION IATTR
+     {
+         eq::server::Global::instance()->setChannelIAttribute(
+             eq::server::Channel::IATTR_HINT_REPROJECTION, $2 );
+     }
      | EQTOKEN_COMPOUND_IATTR_STEREO_MODE IATTR
      {
          eq::server::Global::instance()->setCompoundIAttribute(
@@ -667,6 +698,9 @@ nodeAttribute:
         }
     | EQTOKEN_HINT_AFFINITY IATTR
         { node->setIAttribute( eq::server::Node::IATTR_HINT_AFFINITY, $2 ); }
+    | EQTOKEN_HINT_SHARED_MEMORY IATTR
+        { node->setIAttribute( eq::server::Node::IATTR_HINT_SHARED_MEMORY,
+                               $2 ); }
 
 
 pipe: EQTOKEN_PIPE '{'
@@ -741,6 +775,8 @@ windowAttribute:
         { window->setIAttribute( eq::server::WindowSettings::IATTR_HINT_SCREENSAVER, $2 ); }
     | EQTOKEN_HINT_GRAB_POINTER IATTR
         { window->setIAttribute( eq::server::WindowSettings::IATTR_HINT_GRAB_POINTER, $2 ); }
+    | EQTOKEN_HINT_FRAME_PACING IATTR
+        { window->setIAttribute( eq::server::WindowSettings::IATTR_HINT_FRAME_PACING, $2 ); }
     | EQTOKEN_PLANES_COLOR IATTR
         { window->setIAttribute( eq::server::WindowSettings::IATTR_PLANES_COLOR, $2 ); }
     | EQTOKEN_PLANES_ALPHA IATTR
@@ -784,6 +820,12 @@ channelAttribute:
     | EQTOKEN_HINT_SENDTOKEN IATTR
         { channel->setIAttribute( eq::server::Channel::IATTR_HINT_SENDTOKEN,
                                   $2 ); }
+    | EQTOKEN_HINT_RESULT_CACHE IATTR
+        { channel->setIAttribute( eq::server::Channel::IATTR_HINT_RESULT_CACHE,
+                                  $2 ); }
+    | EQTOKEN_HINT_REPROJECTION IATTR
+        { channel->setIAttribute( eq::server::Channel::IATTR_HINT_REPROJECTION,
+                                  $2 ); }
     | EQTOKEN_DUMP_IMAGE STRING
         { channel->setSAttribute( eq::server::Channel::SATTR_DUMP_IMAGE,
                                   $2 ); }
@@ -1153,8 +1195,8 @@ projectionField:
     | EQTOKEN_HPR  '[' FLOAT FLOAT FLOAT ']'
         { projection.hpr = eq::fabric::Vector3f( $3, $4, $5 ); }
 
-equalizer: dfrEqualizer | framerateEqualizer | loadEqualizer | treeEqualizer |
-           monitorEqualizer | viewEqualizer | tileEqualizer
+equalizer: dfrEqualizer | dplexEqualizer | framerateEqualizer | loadEqualizer |
+           treeEqualizer | monitorEqualizer | viewEqualizer | tileEqualizer
 
 dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
     { dfrEqualizer = new eq::server::DFREqualizer; }
@@ -1163,6 +1205,10 @@ dfrEqualizer: EQTOKEN_DFREQUALIZER '{'
         eqCompound->addEqualizer( dfrEqualizer );
         dfrEqualizer = 0;
     }
+dplexEqualizer: EQTOKEN_DPLEXEQUALIZER '{' '}'
+    {
+        eqCompound->addEqualizer( new eq::server::DPlexEqualizer );
+    }
 framerateEqualizer: EQTOKEN_FRAMERATEEQUALIZER '{' '}'
     {
         eqCompound->addEqualizer( new eq::server::FramerateEqualizer );
@@ -1181,9 +1227,12 @@ treeEqualizer: EQTOKEN_TREEEQUALIZER '{'
         eqCompound->addEqualizer( treeEqualizer );
         treeEqualizer = 0;
     }
-monitorEqualizer: EQTOKEN_MONITOREQUALIZER '{' '}'
+monitorEqualizer: EQTOKEN_MONITOREQUALIZER '{'
+    { monitorEqualizer = new eq::server::MonitorEqualizer; }
+    monitorEqualizerFields '}'
     {
-        eqCompound->addEqualizer( new eq::server::MonitorEqualizer );
+        eqCompound->addEqualizer( monitorEqualizer );
+        monitorEqualizer = 0;
     }
 viewEqualizer: EQTOKEN_VIEWEQUALIZER '{' '}'
     {
@@ -1238,11 +1287,17 @@ treeEqualizerMode:
     | EQTOKEN_HORIZONTAL { $$ = eq::server::TreeEqualizer::MODE_HORIZONTAL; }
     | EQTOKEN_VERTICAL   { $$ = eq::server::TreeEqualizer::MODE_VERTICAL; }
 
+monitorEqualizerFields: /* null */ | monitorEqualizerFields monitorEqualizerField
+monitorEqualizerField:
+    EQTOKEN_PERIOD UNSIGNED     { monitorEqualizer->setUpdatePeriod( $2 ); }
+    | EQTOKEN_FRAMERATE FLOAT   { monitorEqualizer->setUpdateRate( $2 ); }
+
 tileEqualizerFields: /* null */ | tileEqualizerFields tileEqualizerField
 tileEqualizerField:
     EQTOKEN_NAME STRING                   { tileEqualizer->setName( $2 ); }
     | EQTOKEN_SIZE '[' UNSIGNED UNSIGNED ']'
                    { tileEqualizer->setTileSize( eq::fabric::Vector2i( $3, $4 )); }
+    | EQTOKEN_SIZE EQTOKEN_AUTO { tileEqualizer->setAutoTileSize( true ); }
 
 swapBarrier:
     EQTOKEN_SWAPBARRIER '{' { swapBarrier = new eq::server::SwapBarrier; }
@@ -25,12 +25,15 @@
 #include "log.h"
 #include "nodeFactory.h"
 #include "pipe.h"
+#include "residentPool.h"
 #include "server.h"
 #include "window.h"
 
 #include <eq/fabric/commands.h>
 #include <eq/fabric/elementVisitor.h>
 #include <eq/fabric/event.h>
+#include <eq/fabric/eventType.h>
+#include <eq/fabric/statistic.h>
 #include <eq/fabric/paths.h>
 
 #include <co/barrier.h>
@@ -39,11 +42,18 @@
 
 #include <lunchbox/clock.h>
 #include <lunchbox/os.h>
+#include <lunchbox/scopedMutex.h>
 #include <lunchbox/sleep.h>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <cstdio>
+
+#ifdef _MSC_VER
+#define snprintf _snprintf
+#endif
+
 namespace eq
 {
 namespace server
@@ -86,6 +96,10 @@ Node::Node(Config* parent)
     , _state(STATE_STOPPED)
     , _bufferedTasks(new co::BufferConnection)
     , _lastDrawPipe(0)
+    , _launchTime(0.f)
+    , _initTime(0.f)
+    , _resident(false)
+    , _launched(false)
 {
     const Global* global = Global::instance();
     for (int i = 0; i < Node::SATTR_LAST; ++i)
@@ -257,9 +271,27 @@ static co::NodePtr _createNetNode(Node* node)
     netNode->setHostname(node->getHost());
     return netNode;
 }
+
+/** @return the host of the node, or an empty string for the server host. */
+std::string _getHost(const Node* node)
+{
+    const std::string& host = node->getHost();
+    if (host == "localhost" || host == "127.0.0.1")
+        return std::string();
+    return host;
+}
 }
 
-bool Node::connect()
+bool Node::hasLocalPeer() const
+{
+    const std::string host = _getHost(this);
+    for (const Node* node : getConfig()->getNodes())
+        if (node != this && node->isActive() && _getHost(node) == host)
+            return true;
+    return false;
+}
+
+bool Node::connect(ResidentPool& residents)
 {
     LBASSERT(isActive());
 
@@ -276,13 +308,40 @@ bool Node::connect()
     LBASSERT(localNode);
 
     _node = _createNetNode(this);
-
+    _startupClock.reset();
+    _launchTime = 0.f;
+    _initTime = 0.f;
+    _launched = true;
+
+    // A resident render client daemon (eq::Client --eq-daemon) listens on the
+    // node's connections or is announced in the pool and is reused, otherwise
+    // launch a new process.
     LBLOG(LOG_INIT) << "Connecting node" << std::endl;
-    if (localNode->connect(_node) ||
-        localNode->launch(_node, _createLaunchCommand()))
+    _resident = localNode->connect(_node);
+    if (!_resident)
     {
+        const co::ConnectionDescriptions& descriptions =
+            residents.take(_host);
+        if (!descriptions.empty())
+        {
+            co::NodePtr node = new NetNode(*this);
+            for (co::ConnectionDescriptionPtr desc : descriptions)
+                node->addConnectionDescription(desc);
+            node->setHostname(_host);
+            _resident = localNode->connect(node);
+            if (_resident)
+                _node = node;
+        }
+    }
+    if (_resident)
+    {
+        _launchTime = _startupClock.getTimef();
+        LBINFO << "Reusing resident render client on " << _host << ", "
+               << _launchTime << " ms" << std::endl;
         return true;
     }
+    if (localNode->launch(_node, _createLaunchCommand()))
+        return true;
 
     LBWARN << "Connection to " << _node->getNodeID() << " failed" << std::endl;
     sendError(fabric::ERROR_NODE_LAUNCH) << _host;
@@ -309,7 +368,12 @@ bool Node::syncLaunch(const lunchbox::Clock& clock)
                                   std::max(int64_t(0),
                                            timeOut - clock.getTime64()));
     if (_node)
+    {
+        _launchTime = _startupClock.getTimef();
+        LBINFO << "Launched render client on " << _host << ", " << _launchTime
+               << " ms" << std::endl;
         return true;
+    }
 
     sendError(fabric::ERROR_NODE_CONNECT) << _host;
     _state = STATE_FAILED;
@@ -390,15 +454,18 @@ void Node::configInit(const uint128_t& initID, const uint32_t frameNumber)
     _state = STATE_INITIALIZING;
 
     const Config* config = getConfig();
-    _flushedFrame = config->getFinishedFrame();
-    _finishedFrame = config->getFinishedFrame();
+    // Nodes started during an incremental update have no earlier frames
+    _flushedFrame = config->getCurrentFrame();
+    _finishedFrame = config->getCurrentFrame();
     _frameIDs.clear();
+    _startupClock.reset();
 
     LBLOG(LOG_INIT) << "Create node" << std::endl;
     getConfig()->send(_node, fabric::CMD_CONFIG_CREATE_NODE) << getID();
 
     LBLOG(LOG_INIT) << "Init node" << std::endl;
-    send(fabric::CMD_NODE_CONFIG_INIT) << initID << frameNumber;
+    send(fabric::CMD_NODE_CONFIG_INIT) << initID << frameNumber
+                                       << hasLocalPeer();
 }
 
 bool Node::syncConfigInit()
@@ -407,9 +474,14 @@ bool Node::syncConfigInit()
              _state == STATE_INIT_FAILED);
 
     _state.waitNE(STATE_INITIALIZING);
+    _initTime = _startupClock.getTimef();
 
     if (_state == STATE_INIT_SUCCESS)
     {
+        LBINFO << "Initialized node on " << _host << ", " << _initTime << " ms"
+               << (_resident ? " (resident)" : "") << std::endl;
+        _sendStartupStatistics();
+        lunchbox::ScopedWrite mutex(getConfig()->getNodeStateLock());
         _state = STATE_RUNNING;
         return true;
     }
@@ -419,6 +491,46 @@ bool Node::syncConfigInit()
     return false;
 }
 
+void Node::_sendStartupStatistics()
+{
+    if (isApplicationNode())
+        return;
+
+    Config* config = getConfig();
+    const int64_t now = config->getServer()->getTime();
+    const int64_t initTime = int64_t(_initTime + .5f);
+
+    Statistic stat;
+    stat.serial = getSerial();
+    stat.originator = getID();
+    stat.frameNumber = config->getCurrentFrame();
+    stat.task = 0;
+    stat.ratio = 1.f;
+    const std::string& name = getName();
+    if (name.empty())
+        snprintf(stat.resourceName, 32, "Node %s", _host.c_str());
+    else
+        snprintf(stat.resourceName, 32, "%s", name.c_str());
+    stat.resourceName[31] = 0;
+
+    co::NodePtr appNode = config->findApplicationNetNode();
+    if (_launched)
+    {
+        // launch and init are not contiguous, only their durations matter
+        stat.type = _resident ? Statistic::NODE_CONNECT : Statistic::NODE_LAUNCH;
+        stat.startTime = now - initTime - int64_t(_launchTime + .5f);
+        stat.endTime = now - initTime;
+        config->send(appNode, fabric::CMD_CONFIG_EVENT) << EVENT_STATISTIC
+                                                        << stat;
+        _launched = false;
+    }
+
+    stat.type = Statistic::NODE_INIT;
+    stat.startTime = now - initTime;
+    stat.endTime = now;
+    config->send(appNode, fabric::CMD_CONFIG_EVENT) << EVENT_STATISTIC << stat;
+}
+
 //---------------------------------------------------------------------------
 // exit
 //---------------------------------------------------------------------------
@@ -428,7 +540,10 @@ void Node::configExit()
         return;
 
     LBASSERT(_state == STATE_RUNNING || _state == STATE_INIT_FAILED);
-    _state = STATE_EXITING;
+    {
+        lunchbox::ScopedWrite mutex(getConfig()->getNodeStateLock());
+        _state = STATE_EXITING;
+    }
 
     LBLOG(LOG_INIT) << "Exit node" << std::endl;
     send(fabric::CMD_NODE_CONFIG_EXIT);
@@ -757,7 +872,9 @@ void Node::output(std::ostream& os) const
                          ? "thread_model         "
                          : i == Node::IATTR_HINT_AFFINITY
                                ? "hint_affinity        "
-                               : "ERROR")
+                               : i == Node::IATTR_HINT_SHARED_MEMORY
+                                     ? "hint_shared_memory   "
+                                     : "ERROR")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
 
@@ -31,6 +31,8 @@
 #include <co/connectionDescription.h>
 #include <co/node.h>
 
+#include <lunchbox/clock.h>
+
 #include <vector>
 
 namespace eq
@@ -55,6 +57,10 @@ public:
     void setNode(co::NodePtr node) { _node = node; }
     void setHost(const std::string& host) { _host = host; }
     const std::string& getHost() const { return _host; }
+
+    /** @return true if another active node of the config shares the host. */
+    bool hasLocalPeer() const;
+
     Channel* getChannel(const ChannelPath& path);
 
     /** @return the state of this node. */
@@ -86,15 +92,25 @@ public:
     void setLastDrawPipe(const Pipe* pipe) { _lastDrawPipe = pipe; }
     const Pipe* getLastDrawPipe() const { return _lastDrawPipe; }
     /** @return the number of the last finished frame. @internal */
-    uint32_t getFinishedFrame() const { return _finishedFrame; }
+    uint32_t getFinishedFrame() const { return _finishedFrame.get(); }
+    /** Wait until the given frame has been finished by this node. */
+    void waitFrameFinished(const uint32_t frame) const
+    {
+        _finishedFrame.waitGE(frame);
+    }
     //@}
 
     /**
      * @name Operations
      */
     //@{
-    /** Connect the render slave node process. */
-    bool connect();
+    /**
+     * Connect the render slave node process.
+     *
+     * Connects to a resident render client listening on the node's
+     * connections or announced in the given pool, or launches a new process.
+     */
+    bool connect(ResidentPool& residents);
 
     /** Launch the render slave node process. */
     bool launch();
@@ -108,6 +124,9 @@ public:
     /** Sync initialization of this entity. */
     bool syncConfigInit();
 
+    /** @return true if the last connect reused a resident render client. */
+    bool isResident() const { return _resident; }
+
     /** Start exiting this entity. */
     void configExit();
 
@@ -255,7 +274,7 @@ private:
     FrameIDHash _frameIDs;
 
     /** The number of the last finished frame. */
-    uint32_t _finishedFrame;
+    lunchbox::Monitor<uint32_t> _finishedFrame;
 
     /** The number of the last flushed frame (frame finish command sent). */
     uint32_t _flushedFrame;
@@ -272,6 +291,13 @@ private:
     /** The last draw pipe for this entity */
     const Pipe* _lastDrawPipe;
 
+    /** Measures the launch and init phases of the render client. */
+    lunchbox::Clock _startupClock;
+    float _launchTime;
+    float _initTime;
+    bool _resident; //!< connected to a pre-started render client daemon
+    bool _launched; //!< connected or launched during the current init
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -292,6 +318,9 @@ private:
     /** flush cached barriers. */
     void _flushBarriers();
 
+    /** Send the launch and init times to the application node. */
+    void _sendStartupStatistics();
+
     /** Send the frame finish command for the given frame number. */
     void _sendFrameFinish(const uint32_t frameNumber);
 
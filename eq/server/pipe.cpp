@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2010, Cedric Stalder <cedric.stalder@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -45,6 +45,9 @@ Pipe::Pipe(Node* parent)
     , _state(STATE_STOPPED)
     , _lastDrawWindow(0)
 {
+    _criticalPath[0] = 0;
+    _criticalPath[1] = 0;
+
     const Global* global = Global::instance();
     for (unsigned i = 0; i < IATTR_LAST; ++i)
     {
@@ -252,11 +255,13 @@ void Pipe::update(const uint128_t& frameID, const uint32_t frameNumber)
     send(fabric::CMD_PIPE_FRAME_START_CLOCK);
 
     send(fabric::CMD_PIPE_FRAME_START) << getVersion() << frameID
-                                       << frameNumber;
+                                       << frameNumber << _criticalPath[0]
+                                       << _criticalPath[1];
     LBLOG(LOG_TASKS) << "TASK pipe start frame " << frameNumber << " id "
                      << frameID << std::endl;
 
-    const Windows& windows = getWindows();
+    const Windows windows = _schedule.empty() ? getWindows() : _schedule;
+    _schedule.clear();
     for (Windows::const_iterator i = windows.begin(); i != windows.end(); ++i)
         (*i)->updateDraw(frameID, frameNumber);
 
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2015, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -83,6 +83,17 @@ public:
     /** The last drawing compound for this entity. @internal */
     void setLastDrawWindow(const Window* window) { _lastDrawWindow = window; }
     const Window* getLastDrawWindow() const { return _lastDrawWindow; }
+    /** The window task order for the next update. @internal */
+    void setSchedule(const Windows& windows) { _schedule = windows; }
+    /**
+     * The number of channel tasks until the last readback needed by another
+     * pipe, in traversal and in scheduled order. @internal
+     */
+    void setCriticalPath(const uint32_t before, const uint32_t after)
+    {
+        _criticalPath[0] = before;
+        _criticalPath[1] = after;
+    }
     //@}
 
     /**
@@ -133,6 +144,12 @@ private:
     /** The last draw window for this entity. */
     const Window* _lastDrawWindow;
 
+    /** The window task order for the next update. */
+    Windows _schedule;
+
+    /** The critical path length in traversal and scheduled order. */
+    uint32_t _criticalPath[2];
+
     struct Private;
     Private* _private; // placeholder for binary-compatible changes
 
@@ -0,0 +1,167 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "residentPool.h"
+
+#include <co/localNode.h>
+#include <lunchbox/log.h>
+#include <servus/servus.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+const std::string SERVICE = "_eq-resident._tcp";
+const std::string KEY_CLIENT = "eq_client";
+const std::string KEY_HOST = "eq_host";
+const std::string KEY_CONNECTIONS = "eq_connections";
+const unsigned BROWSE_TIME = 250; // ms
+
+std::string _getLocalHost()
+{
+    char name[256] = {0};
+    if (gethostname(name, sizeof(name) - 1) != 0)
+        return std::string();
+    return name;
+}
+
+/** @return the host name without domain, the local host for an empty host. */
+std::string _getShortHost(const std::string& host)
+{
+    if (host.empty() || host == "localhost" || host == "127.0.0.1")
+        return _getShortHost(_getLocalHost());
+    return host.substr(0, host.find('.'));
+}
+}
+
+ResidentPool::ResidentPool(const std::string& renderClient)
+    : _renderClient(renderClient)
+    , _browsed(false)
+{
+}
+
+ResidentPool::~ResidentPool()
+{
+}
+
+bool ResidentPool::announce(const co::LocalNode& node)
+{
+    if (_announcement)
+        return true;
+
+    if (!servus::Servus::isAvailable())
+    {
+        LBINFO << "No zeroconf, resident render client is only found through "
+               << "the node connections of the configuration" << std::endl;
+        return false;
+    }
+
+    const std::string host = _getLocalHost();
+    co::ConnectionDescriptions descriptions;
+    uint16_t port = 0;
+    for (co::ConnectionDescriptionPtr desc : node.getConnectionDescriptions())
+    {
+        co::ConnectionDescriptionPtr copy = new co::ConnectionDescription(*desc);
+        if (copy->getHostname().empty()) // listening on all interfaces
+            copy->setHostname(host);
+        if (port == 0)
+            port = copy->port;
+        descriptions.push_back(copy);
+    }
+    if (descriptions.empty())
+        return false;
+
+    _announcement.reset(new servus::Servus(SERVICE));
+    _announcement->set(KEY_CLIENT, _renderClient);
+    _announcement->set(KEY_HOST, host);
+    _announcement->set(KEY_CONNECTIONS, co::serialize(descriptions));
+
+    const servus::Servus::Result result = _announcement->announce(
+        port, _renderClient + " on " + host + ":" + std::to_string(port));
+    if (!result)
+    {
+        LBWARN << "Can't announce resident render client: "
+               << result.getString() << std::endl;
+        _announcement.reset();
+        return false;
+    }
+    return true;
+}
+
+void ResidentPool::withdraw()
+{
+    if (_announcement)
+        _announcement->withdraw();
+    _announcement.reset();
+}
+
+co::ConnectionDescriptions ResidentPool::take(const std::string& host)
+{
+    if (!_browsed)
+        _browse();
+
+    const std::string shortHost = _getShortHost(host);
+    for (auto i = _entries.begin(); i != _entries.end(); ++i)
+    {
+        if (_getShortHost(i->host) != shortHost)
+            continue;
+
+        const co::ConnectionDescriptions descriptions = i->descriptions;
+        _entries.erase(i);
+        return descriptions;
+    }
+    return co::ConnectionDescriptions();
+}
+
+void ResidentPool::_browse()
+{
+    _browsed = true;
+    if (_renderClient.empty() || !servus::Servus::isAvailable())
+        return;
+
+    servus::Servus service(SERVICE);
+    const servus::Strings& instances =
+        service.discover(servus::Servus::IF_ALL, BROWSE_TIME);
+    for (const std::string& instance : instances)
+    {
+        if (service.get(instance, KEY_CLIENT) != _renderClient)
+            continue;
+
+        Entry entry;
+        entry.host = service.get(instance, KEY_HOST);
+        std::string data = service.get(instance, KEY_CONNECTIONS);
+        if (!co::deserialize(data, entry.descriptions) ||
+            entry.descriptions.empty())
+        {
+            LBWARN << "Ignoring resident render client " << instance
+                   << " with invalid connections" << std::endl;
+            continue;
+        }
+        _entries.push_back(entry);
+    }
+    LBINFO << "Found " << _entries.size() << " idle resident " << _renderClient
+           << " render clients" << std::endl;
+}
+}
+}
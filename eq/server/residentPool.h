@@ -0,0 +1,91 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_RESIDENTPOOL_H
+#define EQSERVER_RESIDENTPOOL_H
+
+#include "types.h"
+#include <eq/server/api.h>
+
+#include <co/connectionDescription.h> // member
+
+#include <memory>
+
+namespace servus
+{
+class Servus;
+}
+
+namespace eq
+{
+namespace server
+{
+/**
+ * The idle resident render clients (eq::Client --eq-daemon) on the network.
+ *
+ * A resident render client announces its listening connections on zeroconf
+ * while no configuration uses it. During Config::init, the server browses the
+ * announcements for the configuration's render client once and connects to a
+ * resident client on a node's host before launching a new process. Without
+ * zeroconf, resident clients are only found through the node connections of
+ * the configuration.
+ */
+class ResidentPool
+{
+public:
+    /** Create a pool for the given render client executable. */
+    EQSERVER_API explicit ResidentPool(const std::string& renderClient);
+    EQSERVER_API ~ResidentPool();
+
+    /**
+     * Announce the local node as an idle resident render client.
+     *
+     * Announcing an announced node has no effect.
+     *
+     * @return true if the node is announced.
+     */
+    EQSERVER_API bool announce(const co::LocalNode& node);
+
+    /** Withdraw the announcement while a configuration uses the client. */
+    EQSERVER_API void withdraw();
+
+    /**
+     * Take an announced resident render client on the given host.
+     *
+     * Browses the announcements on first use. Each client is returned once.
+     *
+     * @return the connection descriptions of the client, or an empty vector.
+     */
+    co::ConnectionDescriptions take(const std::string& host);
+
+private:
+    struct Entry
+    {
+        std::string host;
+        co::ConnectionDescriptions descriptions;
+    };
+
+    const std::string _renderClient;
+    std::unique_ptr<servus::Servus> _announcement;
+    std::vector<Entry> _entries;
+    bool _browsed;
+
+    void _browse();
+};
+}
+}
+
+#endif // EQSERVER_RESIDENTPOOL_H
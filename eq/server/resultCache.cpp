@@ -0,0 +1,145 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "resultCache.h"
+
+#include "channel.h"
+#include "compound.h"
+#include "frame.h"
+
+namespace eq
+{
+namespace server
+{
+namespace
+{
+bool _isEligible(const Compound* compound)
+{
+    const Channel* channel = compound->getChannel();
+    if (!channel ||
+        channel->getIAttribute(Channel::IATTR_HINT_RESULT_CACHE) != fabric::ON)
+    {
+        return false;
+    }
+
+    // Only pure source contributions: the framebuffer of the destination
+    // channel is displayed, and assembled or tiled input changes independently
+    if (compound->getInheritChannel() == channel || !compound->isLeaf() ||
+        compound->hasTiles() || !compound->getInputFrames().empty() ||
+        !compound->testInheritTask(fabric::TASK_DRAW) ||
+        !compound->testInheritTask(fabric::TASK_READBACK))
+    {
+        return false;
+    }
+
+    for (const Frame* frame : compound->getOutputFrames())
+        if (!frame->getMasterData())
+            return false;
+    return true;
+}
+
+bool _equals(const RenderContext& a, const RenderContext& b)
+{
+    return a.frustum == b.frustum && a.ortho == b.ortho &&
+           a.headTransform == b.headTransform &&
+           a.orthoTransform == b.orthoTransform && a.pvp == b.pvp &&
+           a.pixel == b.pixel && a.overdraw == b.overdraw && a.vp == b.vp &&
+           a.offset == b.offset && a.range == b.range &&
+           a.subPixel == b.subPixel && a.zoom == b.zoom &&
+           a.period == b.period && a.phase == b.phase && a.eye == b.eye &&
+           a.taskID == b.taskID;
+}
+}
+
+ResultCache::ResultCache()
+    : _hits(0)
+    , _lookups(0)
+    , _frameNumber(0)
+    , _frameHits(0)
+    , _frameLookups(0)
+{
+}
+
+bool ResultCache::lookup(const Compound* compound, const uint128_t& frameID,
+                         const uint32_t frameNumber)
+{
+    if (frameNumber != _frameNumber)
+    {
+        _frameNumber = frameNumber;
+        _frameHits = 0;
+        _frameLookups = 0;
+    }
+
+    if (!_isEligible(compound))
+    {
+        _entries.erase(compound);
+        return false;
+    }
+
+    const Channel* destChannel = compound->getInheritChannel();
+    Entry& entry = _entries[compound];
+    bool cached = entry.frameNumber > 0 &&
+                  entry.frameNumber + 1 == frameNumber &&
+                  entry.frameID == frameID &&
+                  entry.view == destChannel->getViewVersion();
+
+    for (unsigned i = 0; i < fabric::NUM_EYES; ++i)
+    {
+        const Eye eye = Eye(1 << i);
+        RenderContext context;
+        if (compound->isInheritActive(eye))
+            context = compound->setupRenderContext(eye);
+
+        cached = cached && _equals(entry.contexts[i], context);
+        entry.contexts[i] = context;
+    }
+
+    entry.frameNumber = frameNumber;
+    entry.frameID = frameID;
+    entry.view = destChannel->getViewVersion();
+    entry.cached = cached;
+
+    ++_lookups;
+    ++_frameLookups;
+    if (cached)
+    {
+        ++_hits;
+        ++_frameHits;
+    }
+    return cached;
+}
+
+bool ResultCache::isCached(const Compound* compound,
+                           const uint32_t frameNumber) const
+{
+    const auto i = _entries.find(compound);
+    return i != _entries.end() && i->second.cached &&
+           i->second.frameNumber == frameNumber;
+}
+
+void ResultCache::invalidate(const Compound* compound)
+{
+    const auto i = _entries.find(compound);
+    if (i == _entries.end() || !i->second.cached)
+        return;
+
+    i->second.cached = false;
+    --_hits;
+    if (i->second.frameNumber == _frameNumber)
+        --_frameHits;
+}
+}
+}
@@ -0,0 +1,103 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 2.1 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef EQSERVER_RESULTCACHE_H
+#define EQSERVER_RESULTCACHE_H
+
+#include "types.h"
+
+#include <eq/fabric/eye.h>           // member
+#include <eq/fabric/renderContext.h> // member
+
+#include <unordered_map>
+
+namespace eq
+{
+namespace server
+{
+/**
+ * Detects source contributions of a channel which are unchanged since the last
+ * frame, enabled by the channel's IATTR_HINT_RESULT_CACHE.
+ *
+ * A contribution is cached if its render context, the application frame
+ * identifier and the destination view version are identical to the previous
+ * frame. Cached contributions are not rendered, read back or transmitted, their
+ * output frames retain the frame data of the last frame.
+ */
+class ResultCache
+{
+public:
+    ResultCache();
+
+    /**
+     * Look up the contribution of the given compound for the current frame.
+     *
+     * @return true if the output of the last frame can be reused.
+     */
+    bool lookup(const Compound* compound, const uint128_t& frameID,
+                uint32_t frameNumber);
+
+    /** @return true if the compound is cached in the given frame. */
+    bool isCached(const Compound* compound, uint32_t frameNumber) const;
+
+    /** Force a new rendering of the compound in the current frame. */
+    void invalidate(const Compound* compound);
+
+    /** Remove all entries. */
+    void clear() { _entries.clear(); }
+    /** @return the number of cached contributions. */
+    uint64_t getHits() const { return _hits; }
+    /** @return the number of eligible contributions. */
+    uint64_t getLookups() const { return _lookups; }
+    /** @return the number of cached contributions in the given frame. */
+    uint32_t getHits(const uint32_t frameNumber) const
+    {
+        return frameNumber == _frameNumber ? _frameHits : 0;
+    }
+
+    /** @return the number of eligible contributions in the given frame. */
+    uint32_t getLookups(const uint32_t frameNumber) const
+    {
+        return frameNumber == _frameNumber ? _frameLookups : 0;
+    }
+
+private:
+    struct Entry
+    {
+        Entry()
+            : frameNumber(0)
+            , cached(false)
+        {
+        }
+
+        uint32_t frameNumber;
+        bool cached;
+        uint128_t frameID;
+        co::ObjectVersion view;
+        RenderContext contexts[fabric::NUM_EYES];
+    };
+
+    std::unordered_map<const Compound*, Entry> _entries;
+    uint64_t _hits;
+    uint64_t _lookups;
+    uint32_t _frameNumber;
+    uint32_t _frameHits;
+    uint32_t _frameLookups;
+};
+}
+}
+
+#endif // EQSERVER_RESULTCACHE_H
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2007-2015, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2007-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Daniel Nachbaur <danielnachbaur@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -38,7 +38,9 @@ class CompoundVisitor;
 class Config;
 class ConfigVisitor;
 class DFREqualizer;
+class DPlexEqualizer;
 class Equalizer;
+class EqualizerState;
 class Frame;
 class FrameData;
 class FramerateEqualizer;
@@ -49,6 +51,7 @@ class Node;
 class NodeFactory;
 class Observer;
 class Pipe;
+class ResidentPool;
 class Segment;
 class Server;
 class TileEqualizer;
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2015, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *                          Daniel Nachbaur <danielnachbaur@gmail.com>
  *
@@ -376,7 +376,8 @@ void Window::updateDraw(const uint128_t& frameID, const uint32_t frameNumber)
     LBLOG(LOG_TASKS) << "TASK window start frame " << frameNumber << " id "
                      << frameID << std::endl;
 
-    const Channels& channels = getChannels();
+    const Channels channels = _schedule.empty() ? getChannels() : _schedule;
+    _schedule.clear();
     _swap = false;
 
     for (ChannelsCIter i = channels.begin(); i != channels.end(); ++i)
@@ -591,6 +592,9 @@ void Window::output(std::ostream& os) const
                                                                                                                          : i == WindowSettings::
                                                                                                                                        IATTR_PLANES_SAMPLES
                                                                                                                                ? "planes_samples     "
+                                                                                                                               : i == WindowSettings::
+                                                                                                                                             IATTR_HINT_FRAME_PACING
+                                                                                                                                     ? "hint_frame_pacing  "
                                                                                                                                : "ERROR")
            << static_cast<fabric::IAttribute>(value) << std::endl;
     }
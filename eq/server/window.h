@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2005-2015, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2005-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *
  * This library is free software; you can redistribute it and/or modify it under
@@ -117,6 +117,8 @@ public:
         _lastDrawChannel = channel;
     }
     const Channel* getLastDrawChannel() const { return _lastDrawChannel; }
+    /** The channel task order for the next update. @internal */
+    void setSchedule(const Channels& channels) { _schedule = channels; }
     /** The maximum frame rate for this window. @internal */
     void setMaxFPS(const float fps) { _maxFPS = fps; }
     float getMaxFPS() const { return _maxFPS; }
@@ -191,6 +193,9 @@ private:
     /** The last draw channel for this entity */
     const Channel* _lastDrawChannel;
 
+    /** The channel task order for the next update */
+    Channels _schedule;
+
     /** The flag if the window has to execute a finish */
     bool _swapFinish;
 
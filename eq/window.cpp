@@ -50,6 +50,8 @@
 #include <co/objectICommand.h>
 #include <lunchbox/sleep.h>
 
+#include <cmath>
+
 namespace eq
 {
 typedef fabric::Window<Pipe, Window, Channel, WindowSettings> Super;
@@ -74,6 +76,13 @@ Window::Window(Pipe* parent)
     , _lastTime(0.0f)
     , _avgFPS(0.0f)
     , _lastSwapTime(0)
+    , _swapTime(0)
+    , _minFrameTime(0.f)
+    , _drawTime(0.f)
+    , _drawTimeDeviation(0.f)
+    , _predictedDrawTime(0.f)
+    , _drawStartTime(0)
+    , _drawTimeRatio(0.f)
 {
     const Windows& windows = parent->getWindows();
     if (windows.empty())
@@ -999,9 +1008,12 @@ bool Window::_cmdThrottleFramerate(co::ICommand& cmd)
     LBLOG(LOG_TASKS) << "TASK throttle framerate " << getName() << " "
                      << command << std::endl;
 
-    // throttle to given framerate
-    const int64_t elapsed = getConfig()->getTime() - _lastSwapTime;
     const float minFrameTime = command.read<float>();
+    _minFrameTime = minFrameTime;
+    _updateFramePacing();
+
+    // throttle to given framerate, a paced frame should not need to wait
+    const int64_t elapsed = getConfig()->getTime() - _lastSwapTime;
     const float timeLeft = minFrameTime - static_cast<float>(elapsed);
 
     if (timeLeft >= 1.f)
@@ -1014,6 +1026,65 @@ bool Window::_cmdThrottleFramerate(co::ICommand& cmd)
     return true;
 }
 
+bool Window::_isFramePaced() const
+{
+    return getIAttribute(WindowSettings::IATTR_HINT_FRAME_PACING) == ON &&
+           _minFrameTime > 0.f;
+}
+
+bool Window::_getFramePacingDelay(const int64_t time, float& delay) const
+{
+    if (!_isFramePaced() || _swapTime == 0 || _drawTime <= 0.f)
+        return false;
+
+    // Predict the draw and assembly time with a safety margin and start
+    // drawing so that the frame completes right before the swap deadline
+    const float predictedDrawTime = _drawTime + 2.f * _drawTimeDeviation;
+    delay = float(_swapTime - time) + _minFrameTime - predictedDrawTime;
+    return true;
+}
+
+void Window::_paceFrame(const float delay)
+{
+    WindowStatistics stat(Statistic::WINDOW_FRAME_PACING, this);
+    stat.statistic.ratio = _drawTimeRatio;
+    if (delay >= 1.f)
+        lunchbox::sleep(static_cast<uint32_t>(delay));
+}
+
+void Window::_startFramePacing(const int64_t time)
+{
+    if (!_isFramePaced())
+    {
+        _drawStartTime = 0;
+        return;
+    }
+    _predictedDrawTime = _drawTime + 2.f * _drawTimeDeviation;
+    _drawStartTime = time;
+}
+
+void Window::_updateFramePacing()
+{
+    if (_drawStartTime == 0)
+        return;
+
+    const int64_t now = getConfig()->getTime();
+    const float drawTime = float(now - _drawStartTime);
+    if (_predictedDrawTime > 0.f)
+        _drawTimeRatio = drawTime / _predictedDrawTime;
+
+    if (_drawTime == 0.f) // first sample
+    {
+        _drawTime = drawTime;
+        return;
+    }
+
+    // exponential moving average of the draw time and its deviation
+    const float error = drawTime - _drawTime;
+    _drawTime += .25f * error;
+    _drawTimeDeviation += .25f * (std::abs(error) - _drawTimeDeviation);
+}
+
 bool Window::_cmdBarrier(co::ICommand& cmd)
 {
     co::ObjectICommand command(cmd);
@@ -1057,6 +1128,14 @@ bool Window::_cmdSwap(co::ICommand& cmd)
         WindowStatistics stat(Statistic::WINDOW_SWAP, this);
         makeCurrent();
         swapBuffers();
+
+        if (_isFramePaced())
+        {
+            // the deadline of the next frame is the completed swap, not the
+            // swap request: wait for the buffer swap (and vsync) to happen
+            finish();
+            _swapTime = getConfig()->getTime();
+        }
     }
     return true;
 }
@@ -469,6 +469,23 @@ private:
     /** The time of the last swap command. */
     int64_t _lastSwapTime;
 
+    /** Frame pacing: the time the last swap completed, the next deadline. */
+    int64_t _swapTime;
+
+    /** Frame pacing: the minimum frame time of the last throttle command. */
+    float _minFrameTime;
+
+    /** Frame pacing: averaged time from draw start to swap and its error. */
+    float _drawTime;
+    float _drawTimeDeviation;
+
+    /** Frame pacing: predicted draw time and draw start of current frame. */
+    float _predictedDrawTime;
+    int64_t _drawStartTime;
+
+    /** Frame pacing: actual vs. predicted draw time of the last frame. */
+    float _drawTimeRatio;
+
     /** List of channels that have grabbed the mouse. */
     Channels _grabbedChannels;
 
@@ -493,6 +510,26 @@ private:
     /** Enter the given barrier. */
     void _enterBarrier(co::ObjectVersion barrier);
 
+    /** @return true if the window paces its frames. */
+    bool _isFramePaced() const;
+
+    /**
+     * Compute the draw start delay to finish the frame just before the swap.
+     *
+     * Called by the pipe, which waits for the smallest delay of its windows.
+     * @return false if the window has no prediction for the delay.
+     */
+    bool _getFramePacingDelay(int64_t time, float& delay) const;
+
+    /** Wait for the given draw start delay of this window. */
+    void _paceFrame(float delay);
+
+    /** Start measuring the draw time of the frame at the given time. */
+    void _startFramePacing(int64_t time);
+
+    /** Update the frame pacing prediction with the finished frame. */
+    void _updateFramePacing();
+
     /* The command functions. */
     bool _cmdCreateChannel(co::ICommand& command);
     bool _cmdDestroyChannel(co::ICommand& command);
@@ -64,6 +64,14 @@ bool Config::init()
         return false;
     }
 
+    if (isBenchmarking())
+    {
+        // the camera path drives the observers, stop the idle spin
+        _spinX = 0;
+        _spinY = 0;
+        _frameData.rotateModel(getBenchmarkModelMatrix());
+    }
+
     const eq::Canvases& canvases = getCanvases();
     if (canvases.empty())
         _currentCanvas = 0;
@@ -124,6 +124,12 @@ void FrameData::setTranslation(const eq::Vector3f& translation)
     setDirty(DIRTY_CAMERA);
 }
 
+void FrameData::rotateModel(const eq::Matrix4f& rotation)
+{
+    _rotation = rotation * _rotation;
+    setDirty(DIRTY_CAMERA);
+}
+
 void FrameData::setRotation(const eq::Vector3f& rotation)
 {
     _rotation = eq::Matrix4f();
@@ -59,6 +59,7 @@ public:
 
     void setTranslation(const eq::Vector3f& translation);
     void setRotation(const eq::Vector3f& rotation);
+    void rotateModel(const eq::Matrix4f& rotation);
 
     bool showHelp() const { return _help; }
     bool useOrtho() const { return _ortho; }
@@ -33,6 +33,7 @@
 
 #include "config.h"
 #include "initData.h"
+#include "node.h"
 #include "pipe.h"
 #include "vertexBufferState.h"
 #include "view.h"
@@ -121,14 +122,7 @@ void Channel::frameDraw(const eq::uint128_t& frameID)
     if (_isDone())
         return;
 
-    Window* window = static_cast<Window*>(getWindow());
-    VertexBufferState& state = window->getState();
-    const Model* oldModel = _model;
     const Model* model = _getModel();
-
-    if (oldModel != model)
-        state.setFrustumCulling(false); // create all display lists/VBOs
-
     if (model)
         _updateNearFar(model->getBoundingBox());
 
@@ -175,7 +169,6 @@ void Channel::frameDraw(const eq::uint128_t& frameID)
         glEnd();
     }
 
-    state.setFrustumCulling(true);
     Accum& accum = _accum[lunchbox::getIndexOfLastBit(getEye())];
     accum.stepsDone = LB_MAX(accum.stepsDone, getSubPixel().size * getPeriod());
     accum.transfer = true;
@@ -602,20 +595,53 @@ void Channel::_drawModel(const Model* scene)
     const eq::Matrix4f model = rotation * position * modelRotation;
 
     state.setProjectionModelViewMatrix(projection * view * model);
-    state.setRange(triply::Range(&getRange().start));
+
+    // cull once against both eyes of a stereo view, the first channel of this
+    // node drawing this part of the frame culls for all others
+    std::vector<eq::Matrix4f> views(1, projection * view * model);
+    VisibleSetKey key = {scene,
+                         getCurrentFrame(),
+                         getContext().view.identifier,
+                         getViewport(),
+                         getPixel(),
+                         getRange(),
+                         uint32_t(getEye())};
+    eq::Matrix4f otherEye;
+    if (_computeOtherEye(otherEye))
+    {
+        views.push_back(otherEye * model);
+        if (getEye() == eq::EYE_RIGHT)
+            std::swap(views[0], views[1]);
+        key.eyes = eq::EYE_LEFT | eq::EYE_RIGHT;
+    }
+
+    Node* node = static_cast<Node*>(getNode());
+    const VisibleSetPtr visible = node->getVisibleSet(key);
+    {
+        lunchbox::ScopedWrite mutex(visible->lock);
+        if (!visible->set.isValid())
+        {
+            state.setRange(_mapRange(scene, key, views));
+            scene->cull(state, views, visible->set);
+        }
+    }
 
     const eq::Pipe* pipe = getPipe();
     const GLuint program = state.getProgram(pipe);
     if (program != VertexBufferState::INVALID)
         glUseProgram(program);
 
-    scene->cullDraw(state);
+    const bool rightOfTwo = views.size() > 1 && getEye() == eq::EYE_RIGHT;
+    scene->drawVisible(state, visible->set, rightOfTwo ? 1 : 0);
+
+    // leaves over the upload budget are drawn as boxes, redraw to fetch them
+    if (state.getPendingUploads() > 0)
+        getConfig()->sendEvent(UPLOADS_PENDING);
 
     state.setChannel(0);
     if (program != VertexBufferState::INVALID)
         glUseProgram(0);
 
-    const InitData& initData = static_cast<Config*>(getConfig())->getInitData();
     if (initData.useROI())
         // declare empty region in case nothing is in frustum
         declareRegion(eq::PixelViewport());
@@ -627,6 +653,93 @@ void Channel::_drawModel(const Model* scene)
 #endif
 }
 
+triply::Range Channel::_mapRange(const Model* scene, const VisibleSetKey& key,
+                                 const std::vector<eq::Matrix4f>& views)
+{
+    const triply::Range range(&key.range.start);
+    const InitData& initData = static_cast<Config*>(getConfig())->getInitData();
+    if (!initData.useCostRanges() || key.range == eq::Range::ALL)
+        return range;
+
+    // DB ranges are in estimated cost for this view, not in triangles. The
+    // costs of the whole model are estimated once per frame and view area.
+    VisibleSetKey all = key;
+    all.range = eq::Range::ALL;
+    Node* node = static_cast<Node*>(getNode());
+    const VisibleSetPtr costs = node->getVisibleSet(all);
+
+    lunchbox::ScopedWrite mutex(costs->lock);
+    if (!costs->costs.isValid())
+    {
+        Window* window = static_cast<Window*>(getWindow());
+        scene->computeCosts(window->getState(), views, costs->costs);
+    }
+    return scene->mapCostRange(costs->costs, range);
+}
+
+bool Channel::_computeOtherEye(eq::Matrix4f& projectionView) const
+{
+    const eq::RenderContext& context = getContext();
+    const eq::View* view = getView();
+    const eq::Observer* observer = view ? view->getObserver() : 0;
+    if (!observer || useOrtho() ||
+        (context.eye != eq::EYE_LEFT && context.eye != eq::EYE_RIGHT))
+    {
+        return false;
+    }
+
+    // The eyes are in world space for fixed walls and in head space for
+    // head-mounted walls, see eq::server::Compound::_getEyePosition
+    const eq::Eye other =
+        context.eye == eq::EYE_LEFT ? eq::EYE_RIGHT : eq::EYE_LEFT;
+    const eq::Vector3f& eye = observer->getEyePosition(context.eye);
+    const eq::Vector3f& otherEye = observer->getEyePosition(other);
+    const eq::Matrix4f& head = observer->getHeadMatrix();
+    eq::Matrix4f transform = context.headTransform;
+    eq::Vector3f motion;
+    if (context.headMounted)
+    {
+        transform = transform * head; // the wall transform
+        motion = (otherEye - eye) * view->getModelUnit();
+    }
+    else
+        motion = (head * otherEye - head * eye) * view->getModelUnit();
+
+    // rotate into wall space and recompute the off-axis frustum of the
+    // shifted eye, see eq::detail::Reprojector::setup
+    eq::Vector3f delta;
+    for (size_t i = 0; i < 3; ++i)
+        delta[i] = transform.array[i] * motion[0] +
+                   transform.array[i + 4] * motion[1] +
+                   transform.array[i + 8] * motion[2];
+
+    const eq::Frustumf& frustum = context.frustum;
+    const eq::Vector3f& eyeWall = context.eyeWall;
+    const eq::Vector3f otherWall = eyeWall + delta;
+    if (eyeWall.z() <= 0.f || otherWall.z() <= 0.f)
+        return false;
+
+    const float toWall = eyeWall.z() / frustum.nearPlane();
+    const float toNear = frustum.nearPlane() / otherWall.z();
+    eq::Frustumf otherFrustum = frustum;
+    otherFrustum.left() =
+        (frustum.left() * toWall + eyeWall.x() - otherWall.x()) * toNear;
+    otherFrustum.right() =
+        (frustum.right() * toWall + eyeWall.x() - otherWall.x()) * toNear;
+    otherFrustum.bottom() =
+        (frustum.bottom() * toWall + eyeWall.y() - otherWall.y()) * toNear;
+    otherFrustum.top() =
+        (frustum.top() * toWall + eyeWall.y() - otherWall.y()) * toNear;
+
+    eq::Matrix4f headTransform = context.headTransform;
+    headTransform.array[12] -= delta.x();
+    headTransform.array[13] -= delta.y();
+    headTransform.array[14] -= delta.z();
+
+    projectionView = otherFrustum.computePerspectiveMatrix() * headTransform;
+    return true;
+}
+
 void Channel::_drawOverlay()
 {
     // Draw the overlay logo
@@ -71,6 +71,14 @@ protected:
 
 private:
     void _drawModel(const Model* model);
+
+    /*  Map the range of the key to the range of the model to draw.  */
+    triply::Range _mapRange(const Model* scene, const VisibleSetKey& key,
+                            const std::vector<eq::Matrix4f>& views);
+
+    /*  Compute the projection * view matrix of the other eye of a stereo
+        pass from the context of the current eye.  */
+    bool _computeOtherEye(eq::Matrix4f& projectionView) const;
     void _drawOverlay();
     void _drawHelp();
     void _updateNearFar(const triply::BoundingBox& box);
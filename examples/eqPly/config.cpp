@@ -36,6 +36,9 @@
 #include <admin/addWindow.h>
 #include <admin/removeWindow.h>
 
+#include <algorithm>
+#include <thread>
+
 using eq::KeyModifier;
 
 namespace eqPly
@@ -50,18 +53,41 @@ Config::Config(eq::ServerPtr parent)
     , _redraw(true)
     , _useIdleAA(true)
     , _numFramesAA(0)
+    , _nextModelFile(0)
+    , _pendingModels(0)
 {
 }
 
 Config::~Config()
 {
-    for (ModelsCIter i = _models.begin(); i != _models.end(); ++i)
-        delete *i;
-    _models.clear();
+    _nextModelFile = _modelFiles.size(); // cancel pending model loads
+    for (auto& loader : _modelLoaders)
+        loader.wait();
+
+    for (Model* model : _loadedModels)
+        delete model;
+    _loadedModels.clear();
+
+    // resident render clients hand the mapped models to the next config run
+    const bool keep = getClient()->isResident();
+    for (size_t i = 0; keep && i < _modelDist.size(); ++i)
+        _keptModels[_modelDist[i]->getID()] = _models[i];
 
     for (ModelDistsCIter i = _modelDist.begin(); i != _modelDist.end(); ++i)
         delete *i;
     _modelDist.clear();
+
+    if (keep)
+        static_cast<EqPly*>(getClient().get())->keepModels(_keptModels);
+    else
+    {
+        for (ModelsCIter i = _models.begin(); i != _models.end(); ++i)
+            delete *i;
+        for (const auto& kept : _keptModels)
+            delete kept.second;
+    }
+    _models.clear();
+    _keptModels.clear();
 }
 
 bool Config::init()
@@ -92,6 +118,8 @@ bool Config::init()
 
     if (_initData.centerCamera())
         _frameData.setCameraPosition(eq::Vector3f::zero());
+    if (isBenchmarking())
+        _frameData.setModelRotation(getBenchmarkModelMatrix());
 
     const eq::Canvases& canvases = getCanvases();
     if (canvases.empty())
@@ -132,7 +160,7 @@ static bool _isPlyfile(const std::string& filename)
 
 void Config::_loadModels()
 {
-    if (!_models.empty()) // only load on the first config run
+    if (!_modelLoaders.empty()) // only load on the first config run
         return;
 
     eq::Strings filenames = _initData.getFilenames();
@@ -142,22 +170,7 @@ void Config::_loadModels()
         filenames.pop_back();
 
         if (_isPlyfile(filename))
-        {
-            Model* model = new Model;
-
-            if (_initData.useInvertedFaces())
-                model->useInvertedFaces();
-            if (!_initData.rescaleModels())
-                model->disableRescaling();
-
-            if (!model->readFromFile(filename.c_str()))
-            {
-                LBWARN << "Can't load model: " << filename << std::endl;
-                delete model;
-            }
-            else
-                _models.push_back(model);
-        }
+            _modelFiles.push_back(filename);
         else
         {
             const std::string basename = lunchbox::getFilename(filename);
@@ -172,10 +185,75 @@ void Config::_loadModels()
                 filenames.push_back(filename + '/' + *i);
         }
     }
+
+    if (_modelFiles.empty())
+        return;
+
+    // Load models concurrently, and start rendering as soon as the first one
+    // is ready. The others are registered in handleEvent(MODELS_LOADED).
+    _pendingModels = _modelFiles.size();
+    const size_t nThreads =
+        std::min(_modelFiles.size(),
+                 size_t(std::max(std::thread::hardware_concurrency(), 1u)));
+    for (size_t i = 0; i < nThreads; ++i)
+        _modelLoaders.push_back(std::async(std::launch::async,
+                                           [this] { _loadModelFiles(); }));
+
+    std::unique_lock<std::mutex> lock(_loadLock);
+    _modelLoaded.wait(lock, [this] {
+        return !_loadedModels.empty() || _pendingModels == 0;
+    });
+}
+
+void Config::_loadModelFiles()
+{
+    for (size_t i = _nextModelFile++; i < _modelFiles.size();
+         i = _nextModelFile++)
+    {
+        const std::string& filename = _modelFiles[i];
+        Model* model = new Model;
+
+        if (_initData.useInvertedFaces())
+            model->useInvertedFaces();
+        if (!_initData.rescaleModels())
+            model->disableRescaling();
+
+        if (!model->readFromFile(filename.c_str()))
+        {
+            LBWARN << "Can't load model: " << filename << std::endl;
+            delete model;
+            model = 0;
+        }
+
+        std::unique_lock<std::mutex> lock(_loadLock);
+        if (model)
+            _loadedModels.push_back(model);
+        if (_pendingModels > 0)
+            --_pendingModels;
+        lock.unlock();
+        _modelLoaded.notify_all();
+
+        if (model && isRunning())
+            sendEvent(MODELS_LOADED);
+    }
+}
+
+Models Config::_takeLoadedModels()
+{
+    std::lock_guard<std::mutex> lock(_loadLock);
+    Models models;
+    models.swap(_loadedModels);
+    return models;
 }
 
 void Config::_registerModels()
 {
+    const Models loaded = _takeLoadedModels();
+    {
+        lunchbox::ScopedWrite _mutex(_modelLock);
+        _models.insert(_models.end(), loaded.begin(), loaded.end());
+    }
+
     for (Model* model : _models)
     {
         ModelDist* modelDist = new ModelDist(*model, getClient());
@@ -190,6 +268,38 @@ void Config::_registerModels()
     }
 }
 
+void Config::_registerLoadedModels()
+{
+    const Models loaded = _takeLoadedModels();
+    if (loaded.empty() || !isRunning())
+    {
+        // keep them for the next config run
+        std::lock_guard<std::mutex> lock(_loadLock);
+        _loadedModels.insert(_loadedModels.end(), loaded.begin(),
+                             loaded.end());
+        return;
+    }
+
+    ModelDists loadedDists;
+    for (Model* model : loaded)
+    {
+        // render threads of the application node look up models concurrently
+        ModelDist* modelDist = new ModelDist(*model, getClient());
+        loadedDists.push_back(modelDist);
+        lunchbox::ScopedWrite _mutex(_modelLock);
+        _models.push_back(model);
+        _modelDist.push_back(modelDist);
+    }
+
+    // only views without a model get the new ones, keep the user's selection
+    ModelAssigner assigner(loadedDists, true);
+    accept(assigner);
+    if (_frameData.getModelID() == 0)
+        _frameData.setModelID(loadedDists.front()->getID());
+
+    _setMessage("Loaded " + lunchbox::getFilename(loaded.back()->getName()));
+}
+
 void Config::_deregisterData()
 {
     for (auto modelDist : _modelDist)
@@ -226,6 +336,21 @@ const Model* Config::getModel(const eq::uint128_t& modelID)
             return _models[i];
     }
 
+    const auto kept = _keptModels.find(modelID);
+    if (kept != _keptModels.end())
+        return kept->second;
+
+    if (getClient()->isResident())
+    {
+        EqPly* client = static_cast<EqPly*>(getClient().get());
+        Model* model = client->takeModel(modelID);
+        if (model)
+        {
+            _keptModels[modelID] = model;
+            return model;
+        }
+    }
+
     _models.push_back(new Model);
     _modelDist.push_back(new ModelDist(*_models.back(), getApplicationNode(),
                                        getClient(), modelID));
@@ -259,7 +384,7 @@ void Config::_updateData()
         _frameData.setRotation(curStep.rotation);
         _frameData.setCameraPosition(curStep.position);
     }
-    else if (_initData.useCameraAnimation())
+    else if (_initData.useCameraAnimation() && !isBenchmarking())
     {
         if (_frameData.usePilotMode())
             _frameData.spinCamera(-0.001f * _spinX, -0.001f * _spinY);
@@ -744,6 +869,15 @@ bool Config::handleEvent(eq::EventICommand command)
             _numFramesAA = 0;
         return _numFramesAA > 0;
 
+    case UPLOADS_PENDING:
+        _redraw = true;
+        return true;
+
+    case MODELS_LOADED:
+        _registerLoadedModels();
+        _redraw = true;
+        return true;
+
     default:
         break;
     }
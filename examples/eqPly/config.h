@@ -39,6 +39,10 @@
 #include <eq/admin/base.h>
 #include <eq/eq.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
+
 namespace eqPly
 {
 /**
@@ -102,8 +106,18 @@ private:
 
     Models _models;
     ModelDists _modelDist;
+    ModelMap _keptModels; //!< resident clients: reused from a previous run
     std::mutex _modelLock;
 
+    /** Background model loading, see _loadModels() */
+    eq::Strings _modelFiles;
+    std::atomic<size_t> _nextModelFile;
+    std::vector<std::future<void>> _modelLoaders;
+    Models _loadedModels; //!< loaded, but not yet registered
+    size_t _pendingModels;
+    std::mutex _loadLock;
+    std::condition_variable _modelLoaded;
+
     CameraAnimation _animation;
 
     uint64_t _messageTime;
@@ -116,7 +130,10 @@ private:
     eq::admin::ServerPtr _admin;
 
     void _loadModels();
+    void _loadModelFiles();
+    Models _takeLoadedModels();
     void _registerModels();
+    void _registerLoadedModels();
     void _loadPath();
     void _deregisterData();
 
@@ -89,6 +89,32 @@ EqPly::EqPly(const LocalInitData& initData)
 {
 }
 
+EqPly::~EqPly()
+{
+    for (const auto& kept : _keptModels)
+        delete kept.second;
+}
+
+Model* EqPly::takeModel(const eq::uint128_t& id)
+{
+    lunchbox::ScopedWrite mutex(_keptLock);
+    const auto i = _keptModels.find(id);
+    if (i == _keptModels.end())
+        return nullptr;
+
+    Model* model = i->second;
+    _keptModels.erase(i);
+    return model;
+}
+
+void EqPly::keepModels(const ModelMap& models)
+{
+    lunchbox::ScopedWrite mutex(_keptLock);
+    for (const auto& kept : _keptModels) // not used by the last run
+        delete kept.second;
+    _keptModels = models;
+}
+
 int EqPly::run()
 {
     // 1. connect to server
@@ -35,6 +35,8 @@
 #include <triply/vertexBufferDist.h>
 #include <triply/vertexBufferRoot.h>
 
+#include <mutex>
+
 #ifndef M_PI_2
 #define M_PI_2 1.57079632679489661923
 #endif
@@ -54,13 +56,22 @@ public:
     /** @return a string containing an online help description. */
     static const std::string& getHelp();
 
+    /** @return a model kept from a previous config run, or nullptr. */
+    Model* takeModel(const eq::uint128_t& id);
+
+    /** Keep models for the next config run, releasing all older ones. */
+    void keepModels(const ModelMap& models);
+
 protected:
     /** @sa eq::Client::clientLoop. */
     virtual void clientLoop();
 
 private:
-    virtual ~EqPly() {}
+    virtual ~EqPly();
     const LocalInitData& _initData;
+
+    ModelMap _keptModels; //!< resident clients: models of the last run
+    std::mutex _keptLock;
 };
 }
 #endif // EQ_PLY_H
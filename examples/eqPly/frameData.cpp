@@ -227,6 +227,12 @@ void FrameData::setModelRotation(const eq::Vector3f& rotation)
     setDirty(DIRTY_CAMERA);
 }
 
+void FrameData::setModelRotation(const eq::Matrix4f& rotation)
+{
+    _modelRotation = rotation;
+    setDirty(DIRTY_CAMERA);
+}
+
 void FrameData::reset()
 {
     if (_position == eq::Vector3f(0.f, 0.f, -2.f) &&
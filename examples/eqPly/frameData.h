@@ -86,6 +86,7 @@ public:
     void setCameraPosition(const eq::Vector3f& position);
     void setRotation(const eq::Vector3f& rotation);
     void setModelRotation(const eq::Vector3f& rotation);
+    void setModelRotation(const eq::Matrix4f& rotation);
     void spinCamera(const float x, const float y);
     void spinModel(const float x, const float y, const float z);
     void moveCamera(const float x, const float y, const float z);
@@ -1,6 +1,6 @@
 
 /*
- * Copyright (c) 2006-2015, Stefan Eilemann <eile@equalizergraphics.com>
+ * Copyright (c) 2006-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                          Cedric Stalder <cedric.stalder@gmail.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -57,6 +57,7 @@ InitData::InitData()
     , _invFaces(false)
     , _logo(true)
     , _roi(true)
+    , _costRanges(false)
 {
 }
 
@@ -68,13 +69,13 @@ InitData::~InitData()
 void InitData::getInstanceData(co::DataOStream& os)
 {
     os << _frameDataID << _windowSystem << _renderMode << _useGLSL << _invFaces
-       << _logo << _roi;
+       << _logo << _roi << _costRanges;
 }
 
 void InitData::applyInstanceData(co::DataIStream& is)
 {
     is >> _frameDataID >> _windowSystem >> _renderMode >> _useGLSL >>
-        _invFaces >> _logo >> _roi;
+        _invFaces >> _logo >> _roi >> _costRanges;
     LBASSERT(_frameDataID != 0);
 }
 }
@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2006-2013, Stefan Eilemann <eile@equalizergraphics.com>
+/* Copyright (c) 2006-2017, Stefan Eilemann <eile@equalizergraphics.com>
  *                    2010, Cedric Stalder <cedric.stalder@gmail.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -48,6 +48,7 @@ public:
     bool useInvertedFaces() const { return _invFaces; }
     bool showLogo() const { return _logo; }
     bool useROI() const { return _roi; }
+    bool useCostRanges() const { return _costRanges; }
 protected:
     virtual void getInstanceData(co::DataOStream& os);
     virtual void applyInstanceData(co::DataIStream& is);
@@ -64,6 +65,7 @@ protected:
     void enableInvertedFaces() { _invFaces = true; }
     void disableLogo() { _logo = false; }
     void disableROI() { _roi = false; }
+    void enableCostRanges() { _costRanges = true; }
 private:
     eq::uint128_t _frameDataID;
     std::string _windowSystem;
@@ -72,6 +74,7 @@ private:
     bool _invFaces;
     bool _logo;
     bool _roi;
+    bool _costRanges;
 };
 }
 
@@ -78,6 +78,8 @@ LocalInitData& LocalInitData::operator=(const LocalInitData& from)
         disableLogo();
     if (!from.useROI())
         disableROI();
+    if (from.useCostRanges())
+        enableCostRanges();
 
     return *this;
 }
@@ -108,6 +110,7 @@ void LocalInitData::parseArguments(const int argc, char** argv)
     bool userDefinedInvertFaces(false);
     bool userDefinedDisableLogo(false);
     bool userDefinedDisableROI(false);
+    bool userDefinedCostRanges(false);
     bool userDefinedUseImmersiveMode(false);
 
     const std::string& desc = EqPly::getHelp();
@@ -144,6 +147,9 @@ void LocalInitData::parseArguments(const int argc, char** argv)
         "disableROI,d",
         po::bool_switch(&userDefinedDisableROI)->default_value(false),
         "Disable region of interest (ROI)")(
+        "costRanges",
+        po::bool_switch(&userDefinedCostRanges)->default_value(false),
+        "Split sort-last ranges by visible cost, not by triangle count")(
         "immersive",
         po::bool_switch(&userDefinedUseImmersiveMode)->default_value(false),
         "Immersive mode (equivalent to -o -z -s -p)")(
@@ -234,5 +240,8 @@ void LocalInitData::parseArguments(const int argc, char** argv)
 
     if (userDefinedDisableROI)
         disableROI();
+
+    if (userDefinedCostRanges)
+        enableCostRanges();
 }
 }
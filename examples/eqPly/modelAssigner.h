@@ -37,16 +37,25 @@ namespace eqPly
 class ModelAssigner : public eq::ConfigVisitor
 {
 public:
-    ModelAssigner(const ModelDists& models)
+    /**
+     * @param models the models to assign round-robin.
+     * @param keepAssigned leave views which already have a model unchanged.
+     */
+    ModelAssigner(const ModelDists& models, const bool keepAssigned = false)
         : _models(models)
         , _current(models.begin())
+        , _keepAssigned(keepAssigned)
     {
     }
 
     virtual eq::VisitorResult visit(eq::View* view)
     {
+        View* plyView = static_cast<View*>(view);
+        if (_keepAssigned && plyView->getModelID() != 0)
+            return eq::TRAVERSE_CONTINUE;
+
         const ModelDist* model = *_current;
-        static_cast<View*>(view)->setModelID(model->getID());
+        plyView->setModelID(model->getID());
 
         ++_current;
         if (_current == _models.end())
@@ -58,6 +67,7 @@ public:
 private:
     const ModelDists& _models;
     ModelDists::const_iterator _current;
+    const bool _keepAssigned;
 };
 }
 #endif // EQ_PLY_MODELASSIGNER_H
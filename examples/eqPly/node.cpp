@@ -50,4 +50,21 @@ bool Node::configInit(const eq::uint128_t& initID)
     }
     return true;
 }
+
+VisibleSetPtr Node::getVisibleSet(const VisibleSetKey& key)
+{
+    lunchbox::ScopedWrite mutex(_visibleLock);
+    for (auto i = _visibleSets.begin(); i != _visibleSets.end();)
+    {
+        if ((*i)->key == key)
+            return *i;
+        if ((*i)->key.frame < key.frame)
+            i = _visibleSets.erase(i);
+        else
+            ++i;
+    }
+
+    _visibleSets.push_back(std::make_shared<VisibleSet>(key));
+    return _visibleSets.back();
+}
 }
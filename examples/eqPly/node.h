@@ -34,8 +34,47 @@
 
 #include <eq/eq.h>
 
+#include <memory>
+#include <mutex>
+
 namespace eqPly
 {
+/*  The part of a frame drawn by a channel, see Node::getVisibleSet().  */
+struct VisibleSetKey
+{
+    const Model* model;
+    uint32_t frame;
+    eq::uint128_t view;
+    eq::Viewport vp;
+    eq::Pixel pixel;
+    eq::Range range;
+    uint32_t eyes; //!< the eyes culled together
+
+    bool operator==(const VisibleSetKey& rhs) const
+    {
+        return model == rhs.model && frame == rhs.frame && view == rhs.view &&
+               vp == rhs.vp && pixel == rhs.pixel && range == rhs.range &&
+               eyes == rhs.eyes;
+    }
+};
+
+/*  The part of a frame culled once for all channels of a node drawing it,
+    e.g., both eyes of a stereo view rendered on different pipes.  */
+struct VisibleSet
+{
+    explicit VisibleSet(const VisibleSetKey& key_)
+        : key(key_)
+    {
+    }
+
+    const VisibleSetKey key;
+    std::mutex lock; //!< held while culling
+    triply::VisibleSet set;
+    triply::CostMap costs; //!< of the full range, see InitData::useCostRanges
+
+};
+typedef std::shared_ptr<VisibleSet> VisibleSetPtr;
+
 /**
  * Representation of a node in the cluster
  *
@@ -50,11 +89,18 @@ public:
     {
     }
 
+    /*  Get the set matching the key, created empty for a new key. Sets of
+        older frames are dropped when a newer frame is requested, the channels
+        drawing them hold on to them.  */
+    VisibleSetPtr getVisibleSet(const VisibleSetKey& key);
+
 protected:
     virtual ~Node() {}
     virtual bool configInit(const eq::uint128_t& initID);
 
 private:
+    std::vector<VisibleSetPtr> _visibleSets;
+    std::mutex _visibleLock;
 };
 }
 
@@ -34,6 +34,8 @@
 #include <triply/vertexBufferDist.h>
 #include <triply/vertexBufferRoot.h>
 
+#include <map>
+
 #ifndef M_PI_2
 #define M_PI_2 1.57079632679489661923
 #endif
@@ -43,12 +45,14 @@ namespace eqPly
 class FrameData;
 class LocalInitData;
 class View;
+struct VisibleSetKey;
 
 typedef triply::VertexBufferRoot Model;
 typedef triply::VertexBufferDist ModelDist;
 
 typedef std::vector<Model*> Models;
 typedef std::vector<ModelDist*> ModelDists;
+typedef std::map<eq::uint128_t, Model*> ModelMap;
 
 typedef Models::const_iterator ModelsCIter;
 typedef ModelDists::const_iterator ModelDistsCIter;
@@ -69,7 +73,9 @@ enum LogTopics
 
 enum EventType
 {
-    IDLE_AA_LEFT = eq::EVENT_USER
+    IDLE_AA_LEFT = eq::EVENT_USER,
+    UPLOADS_PENDING, //!< model data not yet on the GPU, redraw
+    MODELS_LOADED    //!< background model loading finished a model
 };
 }
 
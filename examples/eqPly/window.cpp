@@ -42,6 +42,12 @@
 
 namespace eqPly
 {
+namespace
+{
+// Time per draw pass to create display lists or VBOs of newly visible leaves
+const float UPLOAD_BUDGET = 10.f; // ms
+}
+
 bool Window::configInitSystemWindow(const eq::uint128_t& initID)
 {
 #ifndef Darwin
@@ -82,6 +88,7 @@ bool Window::configInitGL(const eq::uint128_t& initID)
 
     LBASSERT(!_state);
     _state = new VertexBufferState(getObjectManager());
+    _state->setUploadBudget(UPLOAD_BUDGET);
 
     const Config* config = static_cast<const Config*>(getConfig());
     const InitData& initData = config->getInitData();
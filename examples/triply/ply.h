@@ -49,6 +49,8 @@ extern "C" {
 #define PLY_OKAY 0   /* ply routine worked okay */
 #define PLY_ERROR -1 /* error in ply routine */
 
+#define PLY_LINE_LENGTH 4096 /* maximum length of a header or ascii line */
+
 /* scalar data types supported by PLY format */
 
 #define PLY_START_TYPE 0
@@ -123,18 +125,20 @@ typedef struct PlyOtherElems
 } PlyOtherElems;
 
 typedef struct PlyFile
-{                               /* description of PLY file */
-    FILE *fp;                   /* file pointer */
-    int file_type;              /* ascii or binary */
-    float version;              /* version number of file */
-    int nelems;                 /* number of elements of object */
-    PlyElement **elems;         /* list of elements */
-    int num_comments;           /* number of comments */
-    char **comments;            /* list of comments */
-    int num_obj_info;           /* number of items of object information */
-    char **obj_info;            /* list of object info items */
-    PlyElement *which_elem;     /* which element we're currently writing */
-    PlyOtherElems *other_elems; /* "other" elements from a PLY file */
+{                                    /* description of PLY file */
+    FILE *fp;                        /* file pointer */
+    int file_type;                   /* ascii or binary */
+    float version;                   /* version number of file */
+    int nelems;                      /* number of elements of object */
+    PlyElement **elems;              /* list of elements */
+    int num_comments;                /* number of comments */
+    char **comments;                 /* list of comments */
+    int num_obj_info;                /* number of items of object information */
+    char **obj_info;                 /* list of object info items */
+    PlyElement *which_elem;          /* which element we're currently writing */
+    PlyOtherElems *other_elems;      /* "other" elements from a PLY file */
+    char line[PLY_LINE_LENGTH];      /* words of the last line read */
+    char line_copy[PLY_LINE_LENGTH]; /* the last line read */
 } PlyFile;
 
 /* memory allocation */
@@ -134,7 +134,7 @@ PlyProperty *find_property(PlyElement *, const char *, int *);
 void write_scalar_type(FILE *, int);
 
 /* read a line from a file and break it up into separate words */
-char **get_words(FILE *, int *, char **);
+char **get_words(PlyFile *, int *, char **);
 
 /* write an item to a file */
 void write_binary_item(PlyFile *, int, unsigned int, double, int);
@@ -986,7 +986,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
 
     /* read and parse the file's header */
 
-    words = get_words(plyfile->fp, &nwords, &orig_line);
+    words = get_words(plyfile, &nwords, &orig_line);
     if (!words || !equal_strings(words[0], "ply"))
     {
         free(plyfile);
@@ -1035,7 +1035,7 @@ PlyFile *ply_read(FILE *fp, int *nelems, char ***elem_names)
         /* free up words space */
         free(words);
 
-        words = get_words(plyfile->fp, &nwords, &orig_line);
+        words = get_words(plyfile, &nwords, &orig_line);
     }
 
     /* create tags for each property of each element, to be used */
@@ -1794,7 +1794,7 @@ void ascii_get_element(PlyFile *plyfile, char *elem_ptr)
 
     /* read in the element */
 
-    words = get_words(plyfile->fp, &nwords, &orig_line);
+    words = get_words(plyfile, &nwords, &orig_line);
     if (words == NULL)
     {
         fprintf(stderr, "ply_get_element: unexpected end of file\n");
@@ -2030,10 +2030,12 @@ void write_scalar_type(FILE *fp, int code)
 Get a text line from a file and break it up into words.
 
 IMPORTANT: The calling routine call "free" on the returned pointer once
-finished with it.
+finished with it. The words and the line are stored in the line buffers of
+plyfile and are valid until the next call, which makes concurrent reads of
+different files safe.
 
 Entry:
-  fp - file to read from
+  plyfile - file to read from
 
 Exit:
   nwords    - number of words returned
@@ -2041,11 +2043,10 @@ Exit:
   returns a list of words from the line, or NULL if end-of-file
 ******************************************************************************/
 
-char **get_words(FILE *fp, int *nwords, char **orig_line)
+char **get_words(PlyFile *plyfile, int *nwords, char **orig_line)
 {
-#define BIG_STRING 4096
-    static char str[BIG_STRING];
-    static char str_copy[BIG_STRING];
+    char *str = plyfile->line;
+    char *str_copy = plyfile->line_copy;
     char **words;
     int max_words = 10;
     int num_words = 0;
@@ -2053,7 +2054,7 @@ char **get_words(FILE *fp, int *nwords, char **orig_line)
     char *result;
 
     /* read in a line */
-    result = fgets(str, BIG_STRING, fp);
+    result = fgets(str, PLY_LINE_LENGTH, plyfile->fp);
     if (result == NULL)
     {
         *nwords = 0;
@@ -2067,8 +2068,8 @@ char **get_words(FILE *fp, int *nwords, char **orig_line)
     /* (this guarentees that there will be a space before the */
     /*  null character at the end of the string) */
 
-    str[BIG_STRING - 2] = ' ';
-    str[BIG_STRING - 1] = '\0';
+    str[PLY_LINE_LENGTH - 2] = ' ';
+    str[PLY_LINE_LENGTH - 1] = '\0';
 
     for (ptr = str, ptr2 = str_copy; *ptr != '\0'; ptr++, ptr2++)
     {
@@ -134,6 +134,8 @@ const Index LEAF_SIZE(21845);
 
 // binary mesh file version, increment if changing the file format
 const unsigned short FILE_VERSION(0x011a);
+// binary mesh file version using the compressed geometry encoding
+const unsigned short FILE_VERSION_COMPRESSED(FILE_VERSION | 0x8000);
 
 // enumeration for the sort axis
 enum Axis
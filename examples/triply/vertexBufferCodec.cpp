@@ -0,0 +1,361 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "vertexBufferCodec.h"
+
+#include "vertexBufferData.h"
+#include "vertexBufferLeaf.h"
+#include "vertexBufferRoot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace triply
+{
+namespace
+{
+const float QUANTIZATION = 65535.f; // unsigned 16 bit positions
+const float SNORM = 32767.f;        // signed 16 bit octahedral normals
+
+template <class T>
+void _write(std::vector<uint8_t>& buffer, const T& value)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <class T>
+T _read(const uint8_t*& buffer)
+{
+    T value;
+    memcpy(&value, buffer, sizeof(T));
+    buffer += sizeof(T);
+    return value;
+}
+
+void _writeVarint(std::vector<uint8_t>& buffer, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(uint8_t(value));
+}
+
+bool _readVarint(const uint8_t*& buffer, const uint8_t* end, uint32_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; buffer < end && shift < 32; shift += 7)
+    {
+        const uint8_t byte = *buffer++;
+        value |= uint32_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+float _signNotZero(const float value)
+{
+    return value >= 0.f ? 1.f : -1.f;
+}
+
+/*  Fold the lower hemisphere of the octahedron over the upper one.  */
+void _wrapOctahedron(float& x, float& y)
+{
+    const float oldX = x;
+    x = (1.f - std::abs(y)) * _signNotZero(oldX);
+    y = (1.f - std::abs(oldX)) * _signNotZero(y);
+}
+
+void _encodeNormal(const Normal& normal, int16_t* out)
+{
+    const float sum =
+        std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+    float x = sum > 0.f ? normal[0] / sum : 0.f;
+    float y = sum > 0.f ? normal[1] / sum : 0.f;
+    if (normal[2] < 0.f)
+        _wrapOctahedron(x, y);
+
+    out[0] = int16_t(std::round(x * SNORM));
+    out[1] = int16_t(std::round(y * SNORM));
+}
+
+Normal _decodeNormal(const int16_t* in)
+{
+    float x = float(in[0]) / SNORM;
+    float y = float(in[1]) / SNORM;
+    const float z = 1.f - std::abs(x) - std::abs(y);
+    if (z < 0.f)
+        _wrapOctahedron(x, y);
+
+    Normal normal(x, y, z);
+    normal.normalize();
+    return normal;
+}
+
+void _collectLeaves(VertexBufferBase* node,
+                    std::vector<VertexBufferLeaf*>& leaves)
+{
+    if (!node)
+        return;
+
+    VertexBufferLeaf* leaf = dynamic_cast<VertexBufferLeaf*>(node);
+    if (leaf)
+    {
+        leaves.push_back(leaf);
+        return;
+    }
+    _collectLeaves(node->getLeft(), leaves);
+    _collectLeaves(node->getRight(), leaves);
+}
+}
+
+/*  Leaf chunk: position offset and scale, quantized positions, octahedral
+    normals, colors and zigzag-delta varint indices.  */
+void VertexBufferCodec::_encodeLeaf(const VertexBufferData& data,
+                                    const VertexBufferLeaf& leaf,
+                                    const bool colors,
+                                    std::vector<uint8_t>& buffer)
+{
+    const float maxFloat = std::numeric_limits<float>::max();
+    Vertex min(maxFloat, maxFloat, maxFloat);
+    Vertex max(-maxFloat, -maxFloat, -maxFloat);
+    for (Index i = 0; i < leaf._vertexLength; ++i)
+    {
+        const Vertex& vertex = data.vertices[leaf._vertexStart + i];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            min[j] = std::min(min[j], vertex[j]);
+            max[j] = std::max(max[j], vertex[j]);
+        }
+    }
+
+    Vertex scale;
+    for (size_t j = 0; j < 3; ++j)
+    {
+        if (leaf._vertexLength == 0)
+            min[j] = 0.f;
+        scale[j] = max[j] > min[j] ? (max[j] - min[j]) / QUANTIZATION : 0.f;
+        _write(buffer, min[j]);
+    }
+    for (size_t j = 0; j < 3; ++j)
+        _write(buffer, scale[j]);
+
+    for (Index i = 0; i < leaf._vertexLength; ++i)
+    {
+        const Vertex& vertex = data.vertices[leaf._vertexStart + i];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            const float value =
+                scale[j] > 0.f ? (vertex[j] - min[j]) / scale[j] : 0.f;
+            _write(buffer,
+                   uint16_t(std::min(std::max(std::round(value), 0.f),
+                                     QUANTIZATION)));
+        }
+    }
+
+    for (Index i = 0; i < leaf._vertexLength; ++i)
+    {
+        int16_t normal[2];
+        _encodeNormal(data.normals[leaf._vertexStart + i], normal);
+        _write(buffer, normal[0]);
+        _write(buffer, normal[1]);
+    }
+
+    if (colors && leaf._vertexLength > 0)
+    {
+        const uint8_t* begin = &data.colors[leaf._vertexStart][0];
+        buffer.insert(buffer.end(), begin, begin + leaf._vertexLength * 3);
+    }
+
+    int32_t previous = 0;
+    for (Index i = 0; i < leaf._indexLength; ++i)
+    {
+        const int32_t index = data.indices[leaf._indexStart + i];
+        const int32_t delta = index - previous;
+        _writeVarint(buffer, (uint32_t(delta) << 1) ^ uint32_t(delta >> 31));
+        previous = index;
+    }
+}
+
+/*  @return false if the chunk is corrupt.  */
+bool VertexBufferCodec::_decodeLeaf(VertexBufferData& data,
+                                    const VertexBufferLeaf& leaf,
+                                    const bool colors, const uint8_t* buffer,
+                                    const uint8_t* end)
+{
+    const size_t vertexSize = 3 * sizeof(uint16_t) + 2 * sizeof(int16_t) +
+                              (colors ? 3 * sizeof(uint8_t) : 0);
+    if (size_t(end - buffer) <
+        6 * sizeof(float) + leaf._vertexLength * vertexSize)
+    {
+        return false;
+    }
+
+    Vertex min, scale;
+    for (size_t j = 0; j < 3; ++j)
+        min[j] = _read<float>(buffer);
+    for (size_t j = 0; j < 3; ++j)
+        scale[j] = _read<float>(buffer);
+
+    for (Index i = 0; i < leaf._vertexLength; ++i)
+    {
+        Vertex& vertex = data.vertices[leaf._vertexStart + i];
+        for (size_t j = 0; j < 3; ++j)
+            vertex[j] = min[j] + float(_read<uint16_t>(buffer)) * scale[j];
+    }
+
+    for (Index i = 0; i < leaf._vertexLength; ++i)
+    {
+        int16_t normal[2];
+        normal[0] = _read<int16_t>(buffer);
+        normal[1] = _read<int16_t>(buffer);
+        data.normals[leaf._vertexStart + i] = _decodeNormal(normal);
+    }
+
+    if (colors && leaf._vertexLength > 0)
+    {
+        memcpy(&data.colors[leaf._vertexStart][0], buffer,
+               leaf._vertexLength * 3);
+        buffer += leaf._vertexLength * 3;
+    }
+
+    int32_t previous = 0;
+    for (Index i = 0; i < leaf._indexLength; ++i)
+    {
+        uint32_t value;
+        if (!_readVarint(buffer, end, value))
+            return false;
+        previous += int32_t(value >> 1) ^ -int32_t(value & 1);
+        if (previous < 0 || Index(previous) >= leaf._vertexLength)
+            return false;
+        data.indices[leaf._indexStart + i] = ShortIndex(previous);
+    }
+    return true;
+}
+
+VertexBufferCodec::VertexBufferCodec(VertexBufferRoot& root)
+    : _data(root._data)
+{
+    _collectLeaves(&root, _leaves);
+}
+
+/*  Layout: vertex, index and leaf count, color flag, leaf chunk offsets
+    including the end of the last chunk, leaf chunks.  */
+void VertexBufferCodec::encode(std::vector<uint8_t>& buffer) const
+{
+    const bool colors = !_data.colors.empty();
+    std::vector<std::vector<uint8_t>> chunks(_leaves.size());
+
+#pragma omp parallel for
+    for (ssize_t i = 0; i < ssize_t(_leaves.size()); ++i)
+        _encodeLeaf(_data, *_leaves[i], colors, chunks[i]);
+
+    buffer.clear();
+    _write(buffer, uint64_t(_data.vertices.size()));
+    _write(buffer, uint64_t(_data.indices.size()));
+    _write(buffer, uint64_t(_leaves.size()));
+    _write(buffer, uint64_t(colors));
+
+    uint64_t offset = 0;
+    for (const std::vector<uint8_t>& chunk : chunks)
+    {
+        _write(buffer, offset);
+        offset += chunk.size();
+    }
+    _write(buffer, offset);
+
+    buffer.reserve(buffer.size() + offset);
+    for (const std::vector<uint8_t>& chunk : chunks)
+        buffer.insert(buffer.end(), chunk.begin(), chunk.end());
+}
+
+void VertexBufferCodec::decode(const uint8_t* buffer, const size_t size)
+{
+    const uint8_t* const end = buffer + size;
+    if (size < 4 * sizeof(uint64_t))
+        throw MeshException("Compressed geometry data is truncated");
+
+    const size_t nVertices = size_t(_read<uint64_t>(buffer));
+    const size_t nIndices = size_t(_read<uint64_t>(buffer));
+    const size_t nLeaves = size_t(_read<uint64_t>(buffer));
+    const bool colors = _read<uint64_t>(buffer) != 0;
+    if (nLeaves != _leaves.size())
+        throw MeshException("Compressed geometry does not match kd-tree");
+    if (size_t(end - buffer) < (nLeaves + 1) * sizeof(uint64_t))
+        throw MeshException("Compressed geometry data is truncated");
+
+    std::vector<uint64_t> offsets(nLeaves + 1);
+    for (uint64_t& offset : offsets)
+        offset = _read<uint64_t>(buffer);
+    if (offsets.back() > uint64_t(end - buffer))
+        throw MeshException("Compressed geometry data is truncated");
+
+    for (size_t i = 0; i < nLeaves; ++i)
+    {
+        const VertexBufferLeaf& leaf = *_leaves[i];
+        if (offsets[i] > offsets[i + 1] ||
+            leaf._vertexStart + leaf._vertexLength > nVertices ||
+            leaf._indexStart + leaf._indexLength > nIndices)
+        {
+            throw MeshException("Compressed geometry does not match kd-tree");
+        }
+    }
+
+    _data.vertices.resize(nVertices);
+    _data.normals.resize(nVertices);
+    _data.colors.resize(colors ? nVertices : 0);
+    _data.indices.resize(nIndices);
+
+    size_t failed = 0;
+#pragma omp parallel for reduction(+ : failed)
+    for (ssize_t i = 0; i < ssize_t(nLeaves); ++i)
+    {
+        if (!_decodeLeaf(_data, *_leaves[i], colors, buffer + offsets[i],
+                         buffer + offsets[i + 1]))
+        {
+            ++failed;
+        }
+    }
+
+    if (failed > 0)
+        throw MeshException("Compressed geometry data is corrupt");
+}
+
+size_t VertexBufferCodec::getRawSize() const
+{
+    return _data.vertices.size() * sizeof(Vertex) +
+           _data.colors.size() * sizeof(Color) +
+           _data.normals.size() * sizeof(Normal) +
+           _data.indices.size() * sizeof(ShortIndex);
+}
+}
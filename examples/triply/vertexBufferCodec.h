@@ -0,0 +1,78 @@
+/* Copyright (c) 2017, Stefan Eilemann <eile@equalizergraphics.com>
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of Eyescale Software GmbH nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PLYLIB_VERTEXBUFFERCODEC_H
+#define PLYLIB_VERTEXBUFFERCODEC_H
+
+#include "typedefs.h"
+#include <triply/api.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace triply
+{
+class VertexBufferLeaf;
+
+/*  Compressed encoding of the kd-tree geometry.
+
+    Each leaf is encoded independently, which allows decoding all leaves in
+    parallel: positions are quantized to 16 bit relative to the leaf bounds,
+    normals are stored as 2x16 bit octahedral vectors, colors are unchanged
+    and indices are delta coded as zigzag variable-length integers. Positions
+    and normals are lossy. The encoding is used by the binary cache files and
+    by VertexBufferDist if the model is compressed.  */
+class VertexBufferCodec
+{
+public:
+    /*  Prepare the coding of the data of the given kd-tree.  */
+    TRIPLY_API explicit VertexBufferCodec(VertexBufferRoot& root);
+
+    /*  Encode the geometry of all leaves into the given buffer.  */
+    TRIPLY_API void encode(std::vector<uint8_t>& buffer) const;
+
+    /*  Replace the geometry with the given encoded data.  */
+    TRIPLY_API void decode(const uint8_t* buffer, size_t size);
+
+    /*  @return the size of the uncompressed geometry in bytes.  */
+    TRIPLY_API size_t getRawSize() const;
+
+private:
+    static void _encodeLeaf(const VertexBufferData& data,
+                            const VertexBufferLeaf& leaf, bool colors,
+                            std::vector<uint8_t>& buffer);
+    static bool _decodeLeaf(VertexBufferData& data,
+                            const VertexBufferLeaf& leaf, bool colors,
+                            const uint8_t* buffer, const uint8_t* end);
+
+    VertexBufferData& _data;
+    std::vector<VertexBufferLeaf*> _leaves;
+};
+}
+
+#endif // PLYLIB_VERTEXBUFFERCODEC_H
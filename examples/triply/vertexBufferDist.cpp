@@ -29,9 +29,12 @@
 
 #include "vertexBufferDist.h"
 
+#include "vertexBufferCodec.h"
 #include "vertexBufferLeaf.h"
 #include "vertexBufferRoot.h"
 
+#include <sstream>
+
 namespace triply
 {
 VertexBufferDist::VertexBufferDist(VertexBufferRoot& root, co::NodePtr master,
@@ -78,6 +81,15 @@ VertexBufferDist::VertexBufferDist(VertexBufferRoot& root,
     , _compressor(compressor == COMPRESSOR_AUTO ? co::Object::chooseCompressor()
                                                 : compressor)
 {
+    // same model, same identifier: lets resident render clients reuse it
+    if (_isRoot())
+    {
+        const VertexBufferData& data = root._data;
+        std::ostringstream name;
+        name << root.getName() << ':' << data.vertices.size() << ':'
+             << data.indices.size();
+        setID(servus::make_uint128(name.str()));
+    }
     if (!localNode->registerObject(this))
         throw std::runtime_error("Register of ply node failed");
 }
@@ -106,9 +118,20 @@ void VertexBufferDist::getInstanceData(co::DataOStream& os)
 
     if (_isRoot())
     {
-        const VertexBufferData& data = _root._data;
-        os << data.vertices << data.colors << data.normals << data.indices
-           << _root._name;
+        os << _root._compressed;
+        if (_root._compressed)
+        {
+            std::vector<uint8_t> buffer;
+            VertexBufferCodec(_root).encode(buffer);
+            os << buffer;
+        }
+        else
+        {
+            const VertexBufferData& data = _root._data;
+            os << data.vertices << data.colors << data.normals
+               << data.indices;
+        }
+        os << _root._name;
     }
     if (_node.getType() == Type::leaf)
     {
@@ -129,11 +152,18 @@ void VertexBufferDist::applyInstanceData(co::DataIStream& is)
 
     is >> _node._boundingBox >> _node._range;
 
+    std::vector<uint8_t> buffer;
     if (_isRoot())
     {
-        VertexBufferData& data = _root._data;
-        is >> data.vertices >> data.colors >> data.normals >> data.indices >>
-            _root._name;
+        is >> _root._compressed;
+        if (_root._compressed)
+            is >> buffer;
+        else
+        {
+            VertexBufferData& data = _root._data;
+            is >> data.vertices >> data.colors >> data.normals >> data.indices;
+        }
+        is >> _root._name;
     }
     switch (_node.getType())
     {
@@ -166,6 +196,10 @@ void VertexBufferDist::applyInstanceData(co::DataIStream& is)
     if (node._right)
         _right.reset(new VertexBufferDist(_root, *node._right, getMasterNode(),
                                           getLocalNode(), rightID));
+
+    // all leaves are mapped now, decode their data in parallel
+    if (_isRoot() && _root._compressed)
+        VertexBufferCodec(_root).decode(buffer.data(), buffer.size());
 }
 
 std::unique_ptr<VertexBufferBase> VertexBufferDist::_createNode(
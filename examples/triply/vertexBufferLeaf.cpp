@@ -31,6 +31,7 @@
 #include "vertexBufferData.h"
 #include "vertexBufferState.h"
 #include "vertexData.h"
+#include <chrono>
 #include <map>
 
 namespace triply
@@ -100,6 +101,24 @@ void VertexBufferLeaf::updateRange()
 
 #define glewGetContext state.glewGetContext
 
+/*  Set up rendering of the leaf within the upload budget of the state.  */
+bool VertexBufferLeaf::upload(VertexBufferState& state, GLuint* data) const
+{
+    if (!state.canUpload())
+    {
+        state.deferUpload();
+        return false;
+    }
+
+    typedef std::chrono::high_resolution_clock Clock;
+    const Clock::time_point start = Clock::now();
+    setupRendering(state, data);
+
+    const std::chrono::duration<float, std::milli> time = Clock::now() - start;
+    state.addUploadTime(time.count());
+    return true;
+}
+
 /*  Set up rendering of the leaf nodes.  */
 void VertexBufferLeaf::setupRendering(VertexBufferState& state,
                                       GLuint* data) const
@@ -189,12 +208,15 @@ void VertexBufferLeaf::renderBufferObject(VertexBufferState& state) const
     for (int i = 0; i < 4; ++i)
         buffers[i] =
             state.getBufferObject(reinterpret_cast<const char*>(this) + i);
-    if (buffers[VERTEX_OBJECT] == state.INVALID ||
-        buffers[NORMAL_OBJECT] == state.INVALID ||
-        buffers[COLOR_OBJECT] == state.INVALID ||
-        buffers[INDEX_OBJECT] == state.INVALID)
-
-        setupRendering(state, buffers);
+    if ((buffers[VERTEX_OBJECT] == state.INVALID ||
+         buffers[NORMAL_OBJECT] == state.INVALID ||
+         buffers[COLOR_OBJECT] == state.INVALID ||
+         buffers[INDEX_OBJECT] == state.INVALID) &&
+        !upload(state, buffers))
+    {
+        renderProxy(state);
+        return;
+    }
 
     if (state.useColors())
     {
@@ -218,12 +240,37 @@ inline void VertexBufferLeaf::renderDisplayList(VertexBufferState& state) const
 
     GLuint displayList = state.getDisplayList(key);
 
-    if (displayList == state.INVALID)
-        setupRendering(state, &displayList);
+    if (displayList == state.INVALID && !upload(state, &displayList))
+    {
+        renderProxy(state);
+        return;
+    }
 
     glCallList(displayList);
 }
 
+/*  Render the bounding box of the leaf while its data is not uploaded.  */
+void VertexBufferLeaf::renderProxy(VertexBufferState& state) const
+{
+    if (!state.useDrawProxies())
+        return;
+
+    const auto& min = _boundingBox.getMin();
+    const auto& max = _boundingBox.getMax();
+    const Vertex corners[8] = {
+        Vertex(min[0], min[1], min[2]), Vertex(max[0], min[1], min[2]),
+        Vertex(min[0], max[1], min[2]), Vertex(max[0], max[1], min[2]),
+        Vertex(min[0], min[1], max[2]), Vertex(max[0], min[1], max[2]),
+        Vertex(min[0], max[1], max[2]), Vertex(max[0], max[1], max[2])};
+    static const size_t edges[24] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 2, 1, 3,
+                                     4, 6, 5, 7, 0, 4, 1, 5, 2, 6, 3, 7};
+
+    glBegin(GL_LINES);
+    for (size_t i = 0; i < 24; ++i)
+        glVertex3fv(&corners[edges[i]][0]);
+    glEnd();
+}
+
 /*  Render the leaf with immediate mode primitives or vertex arrays.  */
 inline void VertexBufferLeaf::renderImmediate(VertexBufferState& state) const
 {
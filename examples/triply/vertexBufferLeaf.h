@@ -60,11 +60,14 @@ protected:
     void updateRange() final;
     Type getType() const final { return Type::leaf; }
 private:
+    bool upload(VertexBufferState& state, GLuint* data) const;
     void setupRendering(VertexBufferState& state, GLuint* data) const;
     void renderImmediate(VertexBufferState& state) const;
     void renderDisplayList(VertexBufferState& state) const;
     void renderBufferObject(VertexBufferState& state) const;
+    void renderProxy(VertexBufferState& state) const;
 
+    friend class VertexBufferCodec;
     friend class VertexBufferDist;
     VertexBufferData& _globalData;
     Index _vertexStart;
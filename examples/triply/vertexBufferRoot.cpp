@@ -28,8 +28,10 @@
  */
 
 #include "vertexBufferRoot.h"
+#include "vertexBufferCodec.h"
 #include "vertexBufferState.h"
 #include "vertexData.h"
+#include <algorithm>
 #include <fcntl.h>
 #include <sstream>
 #include <string>
@@ -44,6 +46,109 @@ namespace triply
 {
 using vmml::FrustumCullerf;
 
+namespace
+{
+// Estimated cost of covering the whole screen, in triangles
+const float FILL_COST = 100000.f;
+
+/*  Return the fraction of the screen covered by the projected box.  */
+float getScreenArea(const Matrix4f& pmv, const BoundingBox& box)
+{
+    const vmml::Vector3f& min = box.getMin();
+    const vmml::Vector3f& max = box.getMax();
+    float low[2] = {1.f, 1.f};
+    float high[2] = {-1.f, -1.f};
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const Vector4f corner((i & 1) ? max.x() : min.x(),
+                              (i & 2) ? max.y() : min.y(),
+                              (i & 4) ? max.z() : min.z(), 1.f);
+        const Vector4f projected = pmv * corner;
+        if (projected.w() <= 0.f) // behind the eye, assume it covers all
+            return 1.f;
+
+        for (size_t j = 0; j < 2; ++j)
+        {
+            const float pos = projected[j] / projected.w();
+            low[j] = std::min(low[j], pos);
+            high[j] = std::max(high[j], pos);
+        }
+    }
+
+    float area = 1.f;
+    for (size_t j = 0; j < 2; ++j)
+        area *= std::max(std::min(high[j], 1.f) - std::max(low[j], -1.f), 0.f);
+    return area * .25f;
+}
+
+/*  The visibility of a subtree in one view of the cost traversal.  */
+struct ViewCost
+{
+    vmml::Visibility visibility;
+    float fillPerRange; //!< screen fill cost of a fully visible subtree
+};
+typedef std::vector<ViewCost> ViewCosts;
+
+/*  Collect the start and estimated cost of all leaves below the given node.
+    The cost of a visible leaf is its triangle count plus its projected area
+    in FILL_COST triangles per screen, summed over all views. Subtrees
+    invisible in all views are free. Costs are rounded to whole triangles, so
+    that the mapping is computed in integers.  */
+void collectCosts(const std::vector<FrustumCullerf>& cullers,
+                  const std::vector<Matrix4f>& views,
+                  const VertexBufferBase* node, ViewCosts viewCosts,
+                  const float triangles, std::vector<float>& starts,
+                  std::vector<uint64_t>& costs)
+{
+    const float* range = node->getRange();
+    const float size = range[1] - range[0];
+    bool visible = false;
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        ViewCost& view = viewCosts[i];
+        if (view.visibility == vmml::VISIBILITY_PARTIAL)
+        {
+            view.visibility = cullers[i].test(node->getBoundingBox());
+            if (view.visibility == vmml::VISIBILITY_FULL && size > 0.f)
+                // distribute the area of the subtree by triangle count
+                view.fillPerRange = FILL_COST *
+                                    getScreenArea(views[i],
+                                                  node->getBoundingBox()) /
+                                    size;
+        }
+        visible = visible || view.visibility != vmml::VISIBILITY_NONE;
+    }
+
+    const VertexBufferBase* left = node->getLeft();
+    const VertexBufferBase* right = node->getRight();
+    if (!visible || (!left && !right))
+    {
+        float cost = 0.f;
+        for (size_t i = 0; i < views.size(); ++i)
+        {
+            const ViewCost& view = viewCosts[i];
+            if (view.visibility == vmml::VISIBILITY_FULL)
+                cost += size * (triangles + view.fillPerRange);
+            else if (view.visibility == vmml::VISIBILITY_PARTIAL)
+                cost += size * triangles +
+                        FILL_COST *
+                            getScreenArea(views[i], node->getBoundingBox());
+        }
+        starts.push_back(range[0]);
+        costs.push_back(uint64_t(cost + .5f));
+        return;
+    }
+
+    if (left)
+        collectCosts(cullers, views, left, viewCosts, triangles, starts,
+                     costs);
+    if (right)
+        collectCosts(cullers, views, right, viewCosts, triangles, starts,
+                     costs);
+}
+}
+
 /*  Determine number of bits used by the current architecture.  */
 size_t getArchitectureBits();
 /*  Determine whether the current architecture is little endian or not.  */
@@ -73,6 +178,71 @@ void VertexBufferRoot::setupTree(VertexData& data,
     VertexBufferNode::updateRange();
 }
 
+void VertexBufferRoot::computeCosts(const VertexBufferState& state,
+                                    const std::vector<Matrix4f>& views,
+                                    CostMap& costs) const
+{
+    costs._starts.clear();
+    costs._costs.clear();
+
+    std::vector<FrustumCullerf> cullers;
+    ViewCosts viewCosts;
+    for (const Matrix4f& pmv : views)
+    {
+        cullers.push_back(FrustumCullerf(pmv));
+        if (state.useFrustumCulling())
+            viewCosts.push_back(ViewCost{vmml::VISIBILITY_PARTIAL, 0.f});
+        else
+            viewCosts.push_back(
+                ViewCost{vmml::VISIBILITY_FULL,
+                         FILL_COST * getScreenArea(pmv, getBoundingBox())});
+    }
+
+    // leaves are visited in range order, left before right
+    const float triangles = float(_data.indices.size() / 3);
+    collectCosts(cullers, views, this, viewCosts, triangles, costs._starts,
+                 costs._costs);
+
+    costs._total = 0;
+    for (const uint64_t cost : costs._costs)
+        costs._total += cost;
+    costs._valid = true;
+}
+
+Range VertexBufferRoot::mapCostRange(const CostMap& costs,
+                                     const Range& range) const
+{
+    PLYLIBASSERT(costs.isValid());
+    if ((range[0] <= 0.f && range[1] >= 1.f) || costs._total == 0)
+        return range; // all or nothing visible
+
+    // Snap each boundary to the leaf closest to its share of the total cost.
+    // The leaf starts are model data and the search is in integers, so that
+    // adjacent channels on all nodes agree on their common boundary.
+    float mapped[2];
+    for (size_t i = 0; i < 2; ++i)
+    {
+        if (range[i] <= 0.f || range[i] >= 1.f)
+        {
+            mapped[i] = range[i] <= 0.f ? 0.f : 1.f;
+            continue;
+        }
+
+        const uint64_t target =
+            uint64_t(double(range[i]) * double(costs._total) * 2.0);
+        uint64_t sum = 0;
+        size_t leaf = 0;
+        for (; leaf < costs._costs.size(); ++leaf)
+        {
+            if (sum * 2 + costs._costs[leaf] >= target)
+                break;
+            sum += costs._costs[leaf];
+        }
+        mapped[i] = leaf < costs._starts.size() ? costs._starts[leaf] : 1.f;
+    }
+    return Range(mapped);
+}
+
 // #define LOGCULL
 void VertexBufferRoot::cullDraw(VertexBufferState& state) const
 {
@@ -170,10 +340,114 @@ void VertexBufferRoot::cullDraw(VertexBufferState& state) const
 #endif
 }
 
+void VertexBufferRoot::cull(const VertexBufferState& state,
+                            const std::vector<Matrix4f>& views,
+                            VisibleSet& set) const
+{
+    PLYLIBASSERT(views.size() <= 8);
+    set._nodes.clear();
+
+    std::vector<FrustumCullerf> cullers;
+    for (const Matrix4f& pmv : views)
+        cullers.push_back(FrustumCullerf(pmv));
+
+    const uint8_t all = uint8_t((1u << views.size()) - 1);
+    const Range& range = state.getRange();
+
+    // nodes with the views in which their parent is fully visible
+    std::vector<std::pair<const VertexBufferBase*, uint8_t>> candidates;
+    candidates.push_back(
+        std::make_pair(this, state.useFrustumCulling() ? uint8_t(0) : all));
+
+    while (!candidates.empty())
+    {
+        const VertexBufferBase* treeNode = candidates.back().first;
+        uint8_t full = candidates.back().second;
+        candidates.pop_back();
+
+        // completely out of range check
+        if (treeNode->getRange()[0] >= range[1] ||
+            treeNode->getRange()[1] < range[0])
+        {
+            continue;
+        }
+
+        // test against the frustums not yet known to contain the node
+        uint8_t visible = full;
+        for (size_t i = 0; i < cullers.size(); ++i)
+        {
+            const uint8_t bit = uint8_t(1u << i);
+            if (full & bit)
+                continue;
+
+            switch (cullers[i].test(treeNode->getBoundingBox()))
+            {
+            case vmml::VISIBILITY_FULL:
+                full |= bit;
+            // fall through
+            case vmml::VISIBILITY_PARTIAL:
+                visible |= bit;
+                break;
+            case vmml::VISIBILITY_NONE:
+                break;
+            }
+        }
+        if (!visible)
+            continue;
+
+        const VertexBufferBase* left = treeNode->getLeft();
+        const VertexBufferBase* right = treeNode->getRight();
+        if (!left && !right)
+        {
+            // else drop, to be drawn by 'previous' channel
+            if (treeNode->getRange()[0] >= range[0])
+                set._nodes.push_back(VisibleSet::Node{treeNode, visible});
+            continue;
+        }
+
+        // record whole if fully visible in all views seeing it
+        if (full == visible && treeNode->getRange()[0] >= range[0] &&
+            treeNode->getRange()[1] < range[1])
+        {
+            set._nodes.push_back(VisibleSet::Node{treeNode, visible});
+            continue;
+        }
+
+        if (left)
+            candidates.push_back(std::make_pair(left, full));
+        if (right)
+            candidates.push_back(std::make_pair(right, full));
+    }
+    set._valid = true;
+}
+
+void VertexBufferRoot::drawVisible(VertexBufferState& state,
+                                   const VisibleSet& set,
+                                   const size_t view) const
+{
+    PLYLIBASSERT(set.isValid());
+    _beginRendering(state);
+
+    const uint8_t bit = uint8_t(1u << view);
+    for (const VisibleSet::Node& node : set._nodes)
+    {
+        if (state.stopRendering())
+            break;
+        if (!(node.views & bit))
+            continue;
+
+        node.node->draw(state);
+        state.notifyVisible(node.node->getBoundingBox());
+    }
+
+    _endRendering(state);
+}
+
 /*  Set up the common OpenGL state for rendering of all nodes.  */
 void VertexBufferRoot::_beginRendering(VertexBufferState& state) const
 {
     state.resetRegion();
+    state.resetUploads();
     switch (state.getRenderMode())
     {
 #ifdef GL_ARB_vertex_buffer_object
@@ -418,7 +692,7 @@ void VertexBufferRoot::fromMemory(char* start)
     char** addr = &start;
     size_t version;
     memRead(reinterpret_cast<char*>(&version), addr, sizeof(size_t));
-    if (version != FILE_VERSION)
+    if (version != FILE_VERSION && version != FILE_VERSION_COMPRESSED)
         throw MeshException(
             "Error reading binary file. Version in file "
             "does not match the expected version.");
@@ -429,18 +703,42 @@ void VertexBufferRoot::fromMemory(char* start)
             "Error reading binary file. Expected root node, "
             "got " +
             std::to_string(unsigned(nodeType)));
-    _data.fromMemory(addr);
+
+    _compressed = version == FILE_VERSION_COMPRESSED;
+    if (!_compressed)
+    {
+        _data.fromMemory(addr);
+        VertexBufferNode::fromMemory(addr, _data);
+        return;
+    }
+
+    // the leaves locate their compressed data, read the tree first
     VertexBufferNode::fromMemory(addr, _data);
+    uint64_t size;
+    memRead(reinterpret_cast<char*>(&size), addr, sizeof(size));
+    VertexBufferCodec(*this).decode(reinterpret_cast<const uint8_t*>(*addr),
+                                    size_t(size));
 }
 
 /*  Write root node to output stream and continue with other nodes.  */
 void VertexBufferRoot::toStream(std::ostream& os)
 {
-    size_t version = FILE_VERSION;
+    size_t version = _compressed ? FILE_VERSION_COMPRESSED : FILE_VERSION;
     os.write(reinterpret_cast<char*>(&version), sizeof(size_t));
     const Type nodeType = Type::root;
     os.write(reinterpret_cast<const char*>(&nodeType), sizeof(nodeType));
-    _data.toStream(os);
+    if (!_compressed)
+    {
+        _data.toStream(os);
+        VertexBufferNode::toStream(os);
+        return;
+    }
+
     VertexBufferNode::toStream(os);
+    std::vector<uint8_t> buffer;
+    VertexBufferCodec(*this).encode(buffer);
+    uint64_t size = buffer.size();
+    os.write(reinterpret_cast<char*>(&size), sizeof(size));
+    os.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
 }
 }
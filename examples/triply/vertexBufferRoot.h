@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2007-2016, Tobias Wolf <twolf@access.unizh.ch>
+/* Copyright (c) 2007-2017, Tobias Wolf <twolf@access.unizh.ch>
  *                          Stefan Eilemann <eile@equalizergraphics.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -36,6 +36,50 @@
 
 namespace triply
 {
+/*  The nodes of a model to draw for up to eight views, e.g., both eyes of a
+    stereo frame, collected by a single culling pass against all frustums.
+    Each node has a bit for each view it is visible in.  */
+class VisibleSet
+{
+public:
+    void clear()
+    {
+        _nodes.clear();
+        _valid = false;
+    }
+    bool isValid() const { return _valid; }
+private:
+    struct Node
+    {
+        const VertexBufferBase* node;
+        uint8_t views;
+    };
+    std::vector<Node> _nodes;
+    bool _valid = false;
+    friend class VertexBufferRoot;
+};
+
+/*  The estimated rendering cost of a model for up to eight views, e.g., both
+    eyes of a stereo frame, in leaf order. Invisible subtrees are a single
+    entry of no cost.  */
+class CostMap
+{
+public:
+    void clear()
+    {
+        _starts.clear();
+        _costs.clear();
+        _valid = false;
+    }
+    bool isValid() const { return _valid; }
+private:
+    std::vector<float> _starts;   // range start of each entry, ascending
+    std::vector<uint64_t> _costs; // cost of each entry in triangles
+    uint64_t _total = 0;
+    bool _valid = false;
+    friend class VertexBufferRoot;
+};
+
 /*  The class for kd-tree root nodes.  */
 class VertexBufferRoot : public VertexBufferNode
 {
@@ -45,6 +89,32 @@ public:
     TRIPLY_API VertexBufferRoot(const std::string& filename);
 
     TRIPLY_API virtual void cullDraw(VertexBufferState& state) const;
+
+    /*  Cull the range of the state against the union of the given
+        projection * modelview matrices and record the result in the set.  */
+    TRIPLY_API void cull(const VertexBufferState& state,
+                         const std::vector<Matrix4f>& views,
+                         VisibleSet& set) const;
+
+    /*  Draw the nodes of the set visible in the given view, without culling.
+     */
+    TRIPLY_API void drawVisible(VertexBufferState& state, const VisibleSet& set,
+                                size_t view) const;
+
+    /*  Estimate the rendering cost of the model for the union of the given
+        projection * modelview matrices. Visible triangles and their
+        projected area determine the cost.  */
+    TRIPLY_API void computeCosts(const VertexBufferState& state,
+                                 const std::vector<Matrix4f>& views,
+                                 CostMap& costs) const;
+
+    /*  Map a range of the estimated rendering cost to the range of the model
+        to draw, so that sort-last ranges have a similar load for the current
+        view. The output boundaries are leaf starts, equal input boundaries
+        produce equal output boundaries for equal costs.  */
+    TRIPLY_API Range mapCostRange(const CostMap& costs,
+                                  const Range& range) const;
+
     TRIPLY_API virtual void draw(VertexBufferState& state) const;
 
     TRIPLY_API void setupTree(VertexData& data, boost::progress_display&);
@@ -53,6 +123,10 @@ public:
     bool hasColors() const { return !_data.colors.empty(); }
     void useInvertedFaces() { _invertFaces = true; }
     void disableRescaling() { _rescale = false; }
+    /*  Use the compressed geometry encoding for files and distribution, set
+        when reading a compressed file.  */
+    void setCompressed(const bool compressed) { _compressed = compressed; }
+    bool isCompressed() const { return _compressed; }
     const std::string& getName() const { return _name; }
 protected:
     TRIPLY_API void toStream(std::ostream& os) final;
@@ -65,10 +139,12 @@ private:
     void _beginRendering(VertexBufferState& state) const;
     void _endRendering(VertexBufferState& state) const;
 
+    friend class VertexBufferCodec;
     friend class VertexBufferDist;
     VertexBufferData _data;
     bool _invertFaces = false;
     bool _rescale = true;
+    bool _compressed = false;
     std::string _name;
 };
 }
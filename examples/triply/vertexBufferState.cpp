@@ -1,5 +1,5 @@
 
-/* Copyright (c) 2011-2016, Stefan Eilemann <eile@eyescale.ch>
+/* Copyright (c) 2011-2017, Stefan Eilemann <eile@eyescale.ch>
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are met:
@@ -35,6 +35,10 @@ VertexBufferState::VertexBufferState(const GLEWContext* glewContext)
     , _renderMode(RENDER_MODE_DISPLAY_LIST)
     , _useColors(false)
     , _useFrustumCulling(true)
+    , _drawProxies(true)
+    , _uploadBudget(0.f)
+    , _uploadTime(0.f)
+    , _pendingUploads(0)
 {
     _range[0] = 0.f;
     _range[1] = 1.f;
@@ -109,6 +113,12 @@ Vector4f VertexBufferState::getRegion() const
     return _region;
 }
 
+void VertexBufferState::resetUploads()
+{
+    _uploadTime = 0.f;
+    _pendingUploads = 0;
+}
+
 GLuint VertexBufferStateSimple::getDisplayList(const void* key)
 {
     if (_displayLists.find(key) == _displayLists.end())
@@ -79,6 +79,32 @@ public:
     virtual void notifyVisible(const BoundingBox&) {}
     TRIPLY_API Vector4f getRegion() const;
 
+    /** Limit the time in ms spent per pass creating leaf data, 0: no limit */
+    TRIPLY_API void setUploadBudget(const float budget)
+    {
+        _uploadBudget = budget;
+    }
+    TRIPLY_API float getUploadBudget() const { return _uploadBudget; }
+    /** Draw the bounding box of leaves waiting for their data upload. */
+    TRIPLY_API void setDrawProxies(const bool proxies)
+    {
+        _drawProxies = proxies;
+    }
+    TRIPLY_API bool useDrawProxies() const { return _drawProxies; }
+    /** Start a new pass with the full upload budget. */
+    TRIPLY_API void resetUploads();
+    /** @return true if a leaf may create its data in this pass. */
+    TRIPLY_API bool canUpload() const
+    {
+        return _uploadBudget <= 0.f || _uploadTime < _uploadBudget;
+    }
+    /** Account the time in ms used for creating the data of a leaf. */
+    TRIPLY_API void addUploadTime(const float time) { _uploadTime += time; }
+    /** Record a leaf postponed to a later pass due to the upload budget. */
+    TRIPLY_API void deferUpload() { ++_pendingUploads; }
+    /** @return the number of leaves postponed in the last pass. */
+    TRIPLY_API size_t getPendingUploads() const { return _pendingUploads; }
+
     TRIPLY_API virtual GLuint getDisplayList(const void* key) = 0;
     TRIPLY_API virtual GLuint newDisplayList(const void* key) = 0;
     TRIPLY_API virtual GLuint getBufferObject(const void* key) = 0;
@@ -100,6 +126,10 @@ protected:
     Vector4f _region; //!< normalized x1 y1 x2 y2 region from cullDraw
     bool _useColors;
     bool _useFrustumCulling;
+    bool _drawProxies;
+    float _uploadBudget;    //!< ms per pass for creating leaf data
+    float _uploadTime;      //!< ms used for creating leaf data in this pass
+    size_t _pendingUploads; //!< leaves postponed in this pass
 
 private:
 };
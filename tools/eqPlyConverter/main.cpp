@@ -27,6 +27,7 @@
  */
 
 #include <eq/eq.h>
+#include <triply/vertexBufferCodec.h>
 #include <triply/vertexBufferRoot.h>
 
 namespace
@@ -44,23 +45,60 @@ static bool _isPlyfile(const std::string& filename)
     }
     return true;
 }
+
+/* Report the encoded size and the decoding throughput of the given model. */
+void _benchmark(triply::VertexBufferRoot& model)
+{
+    const size_t nLoops = 10;
+    triply::VertexBufferCodec codec(model);
+    const size_t rawSize = codec.getRawSize();
+
+    lunchbox::Clock clock;
+    std::vector<uint8_t> buffer;
+    codec.encode(buffer);
+    const float encodeTime = clock.getTimef();
+
+    clock.reset();
+    for (size_t i = 0; i < nLoops; ++i)
+        codec.decode(buffer.data(), buffer.size());
+    const float decodeTime = clock.getTimef() / float(nLoops);
+
+    const float mb = 1024.f * 1024.f;
+    std::cout << model.getName() << ": " << rawSize << " raw bytes, "
+              << buffer.size() << " compressed bytes ("
+              << 100.f * float(buffer.size()) / float(rawSize) << "%), encode "
+              << encodeTime << " ms, decode " << decodeTime << " ms ("
+              << float(rawSize) / mb / decodeTime * 1000.f << " MB/s)"
+              << std::endl;
+}
 }
 
 int main(const int argc, char** argv)
 {
     eq::Strings filenames;
+    bool compress = false;
+    bool benchmark = false;
     for (int i = 1; i < argc; ++i)
     {
-        if (std::string(argv[i]) == "--help")
+        const std::string arg = argv[i];
+        if (arg == "--help")
         {
-            std::cout << lunchbox::getFilename(argv[0]) << " .ply files"
-                      << std::endl
+            std::cout << lunchbox::getFilename(argv[0])
+                      << " [--compress] [--benchmark] .ply files" << std::endl
                       << "  Convert polygonal meshes to eqPly binary kd-Tree"
-                      << std::endl;
+                      << std::endl
+                      << "  --compress: write the compressed geometry encoding"
+                      << std::endl
+                      << "  --benchmark: report compressed size and decoding "
+                      << "throughput" << std::endl;
             return EXIT_SUCCESS;
         }
-
-        filenames.push_back(argv[i]);
+        if (arg == "--compress")
+            compress = true;
+        else if (arg == "--benchmark")
+            benchmark = true;
+        else
+            filenames.push_back(arg);
     }
 
     while (!filenames.empty())
@@ -71,8 +109,20 @@ int main(const int argc, char** argv)
         if (_isPlyfile(filename))
         {
             triply::VertexBufferRoot* model = new triply::VertexBufferRoot;
+            model->setCompressed(compress);
             if (!model->readFromFile(filename.c_str()))
                 LBWARN << "Can't load model: " << filename << std::endl;
+            else
+            {
+                // rewrite existing binary files in the requested encoding
+                if (model->isCompressed() != compress)
+                {
+                    model->setCompressed(compress);
+                    model->writeToFile(filename);
+                }
+                if (benchmark)
+                    _benchmark(*model);
+            }
 
             delete model;
         }